@@ -0,0 +1,82 @@
+/******************************************************************************
+** atlasdialog.cpp
+**
+** Options for exporting a glyph atlas.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "atlasdialog.h"
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+AtlasDialog::AtlasDialog( QWidget *parent ): QDialog( parent )
+{
+    formatCombo = new QComboBox();
+    formatCombo->addItem( tr("1 bit per pixel"), GlyphAtlas::Mono );
+    formatCombo->addItem( tr("8 bits per pixel"), GlyphAtlas::Gray );
+
+    paddingSpin = new QSpinBox();
+    paddingSpin->setRange( 0, 8 );
+    paddingSpin->setValue( 1 );
+    paddingSpin->setSuffix( tr(" pixels") );
+
+    QLabel *formatLabel = new QLabel( tr("&Image format:") );
+    formatLabel->setBuddy( formatCombo );
+    QLabel *paddingLabel = new QLabel( tr("&Space between glyphs:") );
+    paddingLabel->setBuddy( paddingSpin );
+    QLabel *noteLabel = new QLabel( tr("The glyph metrics are written to an index file "
+                                       "with the same name as the image and the extension .idx.") );
+    noteLabel->setWordWrap( true );
+
+    QDialogButtonBox *buttons = new QDialogButtonBox( QDialogButtonBox::Ok | QDialogButtonBox::Cancel );
+    connect( buttons, SIGNAL( accepted() ), this, SLOT( accept() ));
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( reject() ));
+
+    QGridLayout *layout = new QGridLayout();
+    layout->addWidget( formatLabel, 0, 0 );
+    layout->addWidget( formatCombo, 0, 1 );
+    layout->addWidget( paddingLabel, 1, 0 );
+    layout->addWidget( paddingSpin, 1, 1 );
+    layout->addWidget( noteLabel, 2, 0, 1, 2 );
+    layout->addWidget( buttons, 3, 0, 1, 2 );
+    setLayout( layout );
+
+    setWindowTitle( tr("Export Glyph Atlas") );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+GlyphAtlas::Format AtlasDialog::format() const
+{
+    return (GlyphAtlas::Format) formatCombo->itemData( formatCombo->currentIndex() ).toInt();
+}
+
+
+int AtlasDialog::padding() const
+{
+    return paddingSpin->value();
+}
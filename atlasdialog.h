@@ -0,0 +1,50 @@
+/******************************************************************************
+** atlasdialog.h
+**
+** Options for exporting a glyph atlas.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef ATLASDIALOG_H
+#define ATLASDIALOG_H
+
+#include <QDialog>
+
+#include "glyphatlas.h"
+
+class QComboBox;
+class QSpinBox;
+
+
+class AtlasDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    AtlasDialog( QWidget *parent = 0 );
+
+    GlyphAtlas::Format format() const;
+    int                padding() const;
+
+private:
+    QComboBox *formatCombo;
+    QSpinBox  *paddingSpin;
+};
+
+#endif  // ATLASDIALOG_H
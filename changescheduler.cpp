@@ -0,0 +1,101 @@
+/******************************************************************************
+** changescheduler.cpp
+**
+** Once-per-frame delivery of editor change notifications.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#include <QTimer>
+
+#include "changescheduler.h"
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+ChangeScheduler::ChangeScheduler( QObject *parent ): QObject( parent )
+{
+    iPending = 0;
+
+    frameTimer = new QTimer( this );
+    frameTimer->setSingleShot( true );
+    frameTimer->setInterval( 16 );
+    connect( frameTimer, SIGNAL( timeout() ), this, SLOT( flush() ));
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* The frame starts with the first post after a dispatch, so a change that
+ * arrives while idle is shown within one frame, and a burst of them (a
+ * stroke, or glyphs arriving from the loader) still costs one update.
+ */
+void ChangeScheduler::post( int changes )
+{
+    if ( !changes )
+        return;
+    iPending |= changes;
+    if ( !frameTimer->isActive() )
+        frameTimer->start();
+}
+
+
+/* Drop changes that have been overtaken, e.g. a pending "modified" once the
+ * font has been saved.
+ */
+void ChangeScheduler::cancel( int changes )
+{
+    iPending &= ~changes;
+    if ( !iPending )
+        frameTimer->stop();
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void ChangeScheduler::postPosition( const QPoint &position )
+{
+    lastPosition = position;
+    post( PositionChange );
+}
+
+
+void ChangeScheduler::postMetrics()
+{
+    post( MetricsChange );
+}
+
+
+/* Deliver whatever is pending now.  The pending set is cleared first, so
+ * receivers may post again (to be delivered in the next frame).
+ */
+void ChangeScheduler::flush()
+{
+    frameTimer->stop();
+    int changes = iPending;
+    iPending = 0;
+    if ( changes )
+        emit dispatch( changes );
+}
@@ -0,0 +1,73 @@
+/******************************************************************************
+** changescheduler.h
+**
+** Once-per-frame delivery of editor change notifications.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#ifndef CHANGESCHEDULER_H
+#define CHANGESCHEDULER_H
+
+#include <QObject>
+#include <QPoint>
+
+class QTimer;
+
+
+/* Collects the notifications that follow an edit (the cursor position, the
+ * glyph's increment, the font metrics and the modified state) and delivers
+ * them together at most once per display frame.  Each kind of change is a
+ * bit, so any number of posts between frames produce a single dispatch();
+ * only the latest cursor position is kept.
+ */
+class ChangeScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Change {
+        PositionChange  = 0x1,
+        IncrementChange = 0x2,
+        MetricsChange   = 0x4,
+        ModifiedChange  = 0x8
+    };
+
+    ChangeScheduler( QObject *parent = 0 );
+
+    void    post( int changes );
+    void    cancel( int changes );
+    int     pending() const { return iPending; }
+    QPoint  position() const { return lastPosition; }
+
+public slots:
+    void postPosition( const QPoint &position );
+    void postMetrics();
+    void flush();
+
+signals:
+    void dispatch( int changes );
+
+private:
+    QTimer *frameTimer;
+    QPoint  lastPosition;
+    int     iPending;
+};
+
+#endif  // CHANGESCHEDULER_H
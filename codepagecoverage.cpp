@@ -0,0 +1,861 @@
+/******************************************************************************
+** codepagecoverage.cpp
+**
+** Which code pages a font fully covers, and which glyphs each one lacks.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QTextCodec>
+#include <QtAlgorithms>
+
+#include "codepagecoverage.h"
+#include "fontdocument.h"
+#include "glyphnames.h"
+#include "qbf_bits.h"
+
+
+// ---------------------------------------------------------------------------
+// CODE PAGE TABLES
+//
+// The single-byte code pages share ASCII for 0x20-0x7E, so only the upper
+// half of each is given here (0 where a byte has no character).  The PC
+// code pages also have the graphics characters of GlyphNames::codePoint()
+// at 0x01-0x1F and 0x7F.  Code page
+// 1004 is taken to be Latin-1 with the Windows punctuation in 0x80-0x9F.
+// The double-byte code pages are far too large to embed; their characters
+// are found by trying every byte pair with Qt's codec for them.  That takes
+// around 100,000 decodes, so it is only done once some coverage actually
+// asks for them (see CodePageCoverage::setDoubleByte()).
+//
+
+static const quint16 upper437[ 128 ] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+};
+
+static const quint16 upper850[ 128 ] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x00FF, 0x00D6, 0x00DC, 0x00F8, 0x00A3, 0x00D8, 0x00D7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x00AE, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x00C1, 0x00C2, 0x00C0,
+    0x00A9, 0x2563, 0x2551, 0x2557, 0x255D, 0x00A2, 0x00A5, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x00E3, 0x00C3,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x00A4,
+    0x00F0, 0x00D0, 0x00CA, 0x00CB, 0x00C8, 0x0131, 0x00CD, 0x00CE,
+    0x00CF, 0x2518, 0x250C, 0x2588, 0x2584, 0x00A6, 0x00CC, 0x2580,
+    0x00D3, 0x00DF, 0x00D4, 0x00D2, 0x00F5, 0x00D5, 0x00B5, 0x00FE,
+    0x00DE, 0x00DA, 0x00DB, 0x00D9, 0x00FD, 0x00DD, 0x00AF, 0x00B4,
+    0x00AD, 0x00B1, 0x2017, 0x00BE, 0x00B6, 0x00A7, 0x00F7, 0x00B8,
+    0x00B0, 0x00A8, 0x00B7, 0x00B9, 0x00B3, 0x00B2, 0x25A0, 0x00A0
+};
+
+static const quint16 upper852[ 128 ] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x016F, 0x0107, 0x00E7,
+    0x0142, 0x00EB, 0x0150, 0x0151, 0x00EE, 0x0179, 0x00C4, 0x0106,
+    0x00C9, 0x0139, 0x013A, 0x00F4, 0x00F6, 0x013D, 0x013E, 0x015A,
+    0x015B, 0x00D6, 0x00DC, 0x0164, 0x0165, 0x0141, 0x00D7, 0x010D,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x0104, 0x0105, 0x017D, 0x017E,
+    0x0118, 0x0119, 0x00AC, 0x017A, 0x010C, 0x015F, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x00C1, 0x00C2, 0x011A,
+    0x015E, 0x2563, 0x2551, 0x2557, 0x255D, 0x017B, 0x017C, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x0102, 0x0103,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x00A4,
+    0x0111, 0x0110, 0x010E, 0x00CB, 0x010F, 0x0147, 0x00CD, 0x00CE,
+    0x011B, 0x2518, 0x250C, 0x2588, 0x2584, 0x0162, 0x016E, 0x2580,
+    0x00D3, 0x00DF, 0x00D4, 0x0143, 0x0144, 0x0148, 0x0160, 0x0161,
+    0x0154, 0x00DA, 0x0155, 0x0170, 0x00FD, 0x00DD, 0x0163, 0x00B4,
+    0x00AD, 0x02DD, 0x02DB, 0x02C7, 0x02D8, 0x00A7, 0x00F7, 0x00B8,
+    0x00B0, 0x00A8, 0x02D9, 0x0171, 0x0158, 0x0159, 0x25A0, 0x00A0
+};
+
+static const quint16 upper855[ 128 ] = {
+    0x0452, 0x0402, 0x0453, 0x0403, 0x0451, 0x0401, 0x0454, 0x0404,
+    0x0455, 0x0405, 0x0456, 0x0406, 0x0457, 0x0407, 0x0458, 0x0408,
+    0x0459, 0x0409, 0x045A, 0x040A, 0x045B, 0x040B, 0x045C, 0x040C,
+    0x045E, 0x040E, 0x045F, 0x040F, 0x044E, 0x042E, 0x044A, 0x042A,
+    0x0430, 0x0410, 0x0431, 0x0411, 0x0446, 0x0426, 0x0434, 0x0414,
+    0x0435, 0x0415, 0x0444, 0x0424, 0x0433, 0x0413, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x0445, 0x0425, 0x0438,
+    0x0418, 0x2563, 0x2551, 0x2557, 0x255D, 0x0439, 0x0419, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x043A, 0x041A,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x00A4,
+    0x043B, 0x041B, 0x043C, 0x041C, 0x043D, 0x041D, 0x043E, 0x041E,
+    0x043F, 0x2518, 0x250C, 0x2588, 0x2584, 0x041F, 0x044F, 0x2580,
+    0x042F, 0x0440, 0x0420, 0x0441, 0x0421, 0x0442, 0x0422, 0x0443,
+    0x0423, 0x0436, 0x0416, 0x0432, 0x0412, 0x044C, 0x042C, 0x2116,
+    0x00AD, 0x044B, 0x042B, 0x0437, 0x0417, 0x0448, 0x0428, 0x044D,
+    0x042D, 0x0449, 0x0429, 0x0447, 0x0427, 0x00A7, 0x25A0, 0x00A0
+};
+
+static const quint16 upper857[ 128 ] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x0131, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x0130, 0x00D6, 0x00DC, 0x00F8, 0x00A3, 0x00D8, 0x015E, 0x015F,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x011E, 0x011F,
+    0x00BF, 0x00AE, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x00C1, 0x00C2, 0x00C0,
+    0x00A9, 0x2563, 0x2551, 0x2557, 0x255D, 0x00A2, 0x00A5, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x00E3, 0x00C3,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x00A4,
+    0x00BA, 0x00AA, 0x00CA, 0x00CB, 0x00C8, 0x0000, 0x00CD, 0x00CE,
+    0x00CF, 0x2518, 0x250C, 0x2588, 0x2584, 0x00A6, 0x00CC, 0x2580,
+    0x00D3, 0x00DF, 0x00D4, 0x00D2, 0x00F5, 0x00D5, 0x00B5, 0x0000,
+    0x00D7, 0x00DA, 0x00DB, 0x00D9, 0x00EC, 0x00FF, 0x00AF, 0x00B4,
+    0x00AD, 0x00B1, 0x0000, 0x00BE, 0x00B6, 0x00A7, 0x00F7, 0x00B8,
+    0x00B0, 0x00A8, 0x00B7, 0x00B9, 0x00B3, 0x00B2, 0x25A0, 0x00A0
+};
+
+static const quint16 upper860[ 128 ] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E3, 0x00E0, 0x00C1, 0x00E7,
+    0x00EA, 0x00CA, 0x00E8, 0x00CD, 0x00D4, 0x00EC, 0x00C3, 0x00C2,
+    0x00C9, 0x00C0, 0x00C8, 0x00F4, 0x00F5, 0x00F2, 0x00DA, 0x00F9,
+    0x00CC, 0x00D5, 0x00DC, 0x00A2, 0x00A3, 0x00D9, 0x20A7, 0x00D3,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x00D2, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+};
+
+static const quint16 upper861[ 128 ] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00D0, 0x00F0, 0x00DE, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00FE, 0x00FB, 0x00DD,
+    0x00FD, 0x00D6, 0x00DC, 0x00F8, 0x00A3, 0x00D8, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00C1, 0x00CD, 0x00D3, 0x00DA,
+    0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+};
+
+static const quint16 upper862[ 128 ] = {
+    0x05D0, 0x05D1, 0x05D2, 0x05D3, 0x05D4, 0x05D5, 0x05D6, 0x05D7,
+    0x05D8, 0x05D9, 0x05DA, 0x05DB, 0x05DC, 0x05DD, 0x05DE, 0x05DF,
+    0x05E0, 0x05E1, 0x05E2, 0x05E3, 0x05E4, 0x05E5, 0x05E6, 0x05E7,
+    0x05E8, 0x05E9, 0x05EA, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+};
+
+static const quint16 upper863[ 128 ] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00C2, 0x00E0, 0x00B6, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x2017, 0x00C0, 0x00A7,
+    0x00C9, 0x00C8, 0x00CA, 0x00F4, 0x00CB, 0x00CF, 0x00FB, 0x00F9,
+    0x00A4, 0x00D4, 0x00DC, 0x00A2, 0x00A3, 0x00D9, 0x00DB, 0x0192,
+    0x00A6, 0x00B4, 0x00F3, 0x00FA, 0x00A8, 0x00B8, 0x00B3, 0x00AF,
+    0x00CE, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00BE, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+};
+
+static const quint16 upper864[ 128 ] = {
+    0x00B0, 0x00B7, 0x2219, 0x221A, 0x2592, 0x2500, 0x2502, 0x253C,
+    0x2524, 0x252C, 0x251C, 0x2534, 0x2510, 0x250C, 0x2514, 0x2518,
+    0x03B2, 0x221E, 0x03C6, 0x00B1, 0x00BD, 0x00BC, 0x2248, 0x00AB,
+    0x00BB, 0xFEF7, 0xFEF8, 0x0000, 0x0000, 0xFEFB, 0xFEFC, 0x0000,
+    0x00A0, 0x00AD, 0xFE82, 0x00A3, 0x00A4, 0xFE84, 0x0000, 0x0000,
+    0xFE8E, 0xFE8F, 0xFE95, 0xFE99, 0x060C, 0xFE9D, 0xFEA1, 0xFEA5,
+    0x0660, 0x0661, 0x0662, 0x0663, 0x0664, 0x0665, 0x0666, 0x0667,
+    0x0668, 0x0669, 0xFED1, 0x061B, 0xFEB1, 0xFEB5, 0xFEB9, 0x061F,
+    0x00A2, 0xFE80, 0xFE81, 0xFE83, 0xFE85, 0xFECA, 0xFE8B, 0xFE8D,
+    0xFE91, 0xFE93, 0xFE97, 0xFE9B, 0xFE9F, 0xFEA3, 0xFEA7, 0xFEA9,
+    0xFEAB, 0xFEAD, 0xFEAF, 0xFEB3, 0xFEB7, 0xFEBB, 0xFEBF, 0xFEC1,
+    0xFEC5, 0xFECB, 0xFECF, 0x00A6, 0x00AC, 0x00F7, 0x00D7, 0xFEC9,
+    0x0640, 0xFED3, 0xFED7, 0xFEDB, 0xFEDF, 0xFEE3, 0xFEE7, 0xFEEB,
+    0xFEED, 0xFEEF, 0xFEF3, 0xFEBD, 0xFECC, 0xFECE, 0xFECD, 0xFEE1,
+    0xFE7D, 0x0651, 0xFEE5, 0xFEE9, 0xFEEC, 0xFEF0, 0xFEF2, 0xFED0,
+    0xFED5, 0xFEF5, 0xFEF6, 0xFEDD, 0xFED9, 0xFEF1, 0x25A0, 0x0000
+};
+
+static const quint16 upper865[ 128 ] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x00FF, 0x00D6, 0x00DC, 0x00F8, 0x00A3, 0x00D8, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00A4,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+};
+
+static const quint16 upper866[ 128 ] = {
+    0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,
+    0x0418, 0x0419, 0x041A, 0x041B, 0x041C, 0x041D, 0x041E, 0x041F,
+    0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427,
+    0x0428, 0x0429, 0x042A, 0x042B, 0x042C, 0x042D, 0x042E, 0x042F,
+    0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,
+    0x0438, 0x0439, 0x043A, 0x043B, 0x043C, 0x043D, 0x043E, 0x043F,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,
+    0x0448, 0x0449, 0x044A, 0x044B, 0x044C, 0x044D, 0x044E, 0x044F,
+    0x0401, 0x0451, 0x0404, 0x0454, 0x0407, 0x0457, 0x040E, 0x045E,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x2116, 0x00A4, 0x25A0, 0x00A0
+};
+
+static const quint16 upper869[ 128 ] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0386, 0x0000,
+    0x00B7, 0x00AC, 0x00A6, 0x2018, 0x2019, 0x0388, 0x2015, 0x0389,
+    0x038A, 0x03AA, 0x038C, 0x0000, 0x0000, 0x038E, 0x03AB, 0x00A9,
+    0x038F, 0x00B2, 0x00B3, 0x03AC, 0x00A3, 0x03AD, 0x03AE, 0x03AF,
+    0x03CA, 0x0390, 0x03CC, 0x03CD, 0x0391, 0x0392, 0x0393, 0x0394,
+    0x0395, 0x0396, 0x0397, 0x00BD, 0x0398, 0x0399, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x039A, 0x039B, 0x039C,
+    0x039D, 0x2563, 0x2551, 0x2557, 0x255D, 0x039E, 0x039F, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x03A0, 0x03A1,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x03A3,
+    0x03A4, 0x03A5, 0x03A6, 0x03A7, 0x03A8, 0x03A9, 0x03B1, 0x03B2,
+    0x03B3, 0x2518, 0x250C, 0x2588, 0x2584, 0x03B4, 0x03B5, 0x2580,
+    0x03B6, 0x03B7, 0x03B8, 0x03B9, 0x03BA, 0x03BB, 0x03BC, 0x03BD,
+    0x03BE, 0x03BF, 0x03C0, 0x03C1, 0x03C3, 0x03C2, 0x03C4, 0x0384,
+    0x00AD, 0x00B1, 0x03C5, 0x03C6, 0x03C7, 0x00A7, 0x03C8, 0x0385,
+    0x00B0, 0x00A8, 0x03C9, 0x03CB, 0x03B0, 0x03CE, 0x25A0, 0x00A0
+};
+
+static const quint16 upper874[ 128 ] = {
+    0x20AC, 0x0000, 0x0000, 0x0000, 0x0000, 0x2026, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x00A0, 0x0E01, 0x0E02, 0x0E03, 0x0E04, 0x0E05, 0x0E06, 0x0E07,
+    0x0E08, 0x0E09, 0x0E0A, 0x0E0B, 0x0E0C, 0x0E0D, 0x0E0E, 0x0E0F,
+    0x0E10, 0x0E11, 0x0E12, 0x0E13, 0x0E14, 0x0E15, 0x0E16, 0x0E17,
+    0x0E18, 0x0E19, 0x0E1A, 0x0E1B, 0x0E1C, 0x0E1D, 0x0E1E, 0x0E1F,
+    0x0E20, 0x0E21, 0x0E22, 0x0E23, 0x0E24, 0x0E25, 0x0E26, 0x0E27,
+    0x0E28, 0x0E29, 0x0E2A, 0x0E2B, 0x0E2C, 0x0E2D, 0x0E2E, 0x0E2F,
+    0x0E30, 0x0E31, 0x0E32, 0x0E33, 0x0E34, 0x0E35, 0x0E36, 0x0E37,
+    0x0E38, 0x0E39, 0x0E3A, 0x0000, 0x0000, 0x0000, 0x0000, 0x0E3F,
+    0x0E40, 0x0E41, 0x0E42, 0x0E43, 0x0E44, 0x0E45, 0x0E46, 0x0E47,
+    0x0E48, 0x0E49, 0x0E4A, 0x0E4B, 0x0E4C, 0x0E4D, 0x0E4E, 0x0E4F,
+    0x0E50, 0x0E51, 0x0E52, 0x0E53, 0x0E54, 0x0E55, 0x0E56, 0x0E57,
+    0x0E58, 0x0E59, 0x0E5A, 0x0E5B, 0x0000, 0x0000, 0x0000, 0x0000
+};
+
+static const quint16 upper1004[ 128 ] = {
+    0x20AC, 0x0000, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x0000, 0x017D, 0x0000,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x0000, 0x017E, 0x0178,
+    0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7,
+    0x00A8, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+    0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+    0x00B8, 0x00B9, 0x00BA, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00BF,
+    0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,
+    0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+    0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,
+    0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,
+    0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,
+    0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+    0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,
+    0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF
+};
+
+static const quint16 upper1250[ 128 ] = {
+    0x20AC, 0x0000, 0x201A, 0x0000, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x0000, 0x2030, 0x0160, 0x2039, 0x015A, 0x0164, 0x017D, 0x0179,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x0000, 0x2122, 0x0161, 0x203A, 0x015B, 0x0165, 0x017E, 0x017A,
+    0x00A0, 0x02C7, 0x02D8, 0x0141, 0x00A4, 0x0104, 0x00A6, 0x00A7,
+    0x00A8, 0x00A9, 0x015E, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x017B,
+    0x00B0, 0x00B1, 0x02DB, 0x0142, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+    0x00B8, 0x0105, 0x015F, 0x00BB, 0x013D, 0x02DD, 0x013E, 0x017C,
+    0x0154, 0x00C1, 0x00C2, 0x0102, 0x00C4, 0x0139, 0x0106, 0x00C7,
+    0x010C, 0x00C9, 0x0118, 0x00CB, 0x011A, 0x00CD, 0x00CE, 0x010E,
+    0x0110, 0x0143, 0x0147, 0x00D3, 0x00D4, 0x0150, 0x00D6, 0x00D7,
+    0x0158, 0x016E, 0x00DA, 0x0170, 0x00DC, 0x00DD, 0x0162, 0x00DF,
+    0x0155, 0x00E1, 0x00E2, 0x0103, 0x00E4, 0x013A, 0x0107, 0x00E7,
+    0x010D, 0x00E9, 0x0119, 0x00EB, 0x011B, 0x00ED, 0x00EE, 0x010F,
+    0x0111, 0x0144, 0x0148, 0x00F3, 0x00F4, 0x0151, 0x00F6, 0x00F7,
+    0x0159, 0x016F, 0x00FA, 0x0171, 0x00FC, 0x00FD, 0x0163, 0x02D9
+};
+
+static const quint16 upper1251[ 128 ] = {
+    0x0402, 0x0403, 0x201A, 0x0453, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x20AC, 0x2030, 0x0409, 0x2039, 0x040A, 0x040C, 0x040B, 0x040F,
+    0x0452, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x0000, 0x2122, 0x0459, 0x203A, 0x045A, 0x045C, 0x045B, 0x045F,
+    0x00A0, 0x040E, 0x045E, 0x0408, 0x00A4, 0x0490, 0x00A6, 0x00A7,
+    0x0401, 0x00A9, 0x0404, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x0407,
+    0x00B0, 0x00B1, 0x0406, 0x0456, 0x0491, 0x00B5, 0x00B6, 0x00B7,
+    0x0451, 0x2116, 0x0454, 0x00BB, 0x0458, 0x0405, 0x0455, 0x0457,
+    0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,
+    0x0418, 0x0419, 0x041A, 0x041B, 0x041C, 0x041D, 0x041E, 0x041F,
+    0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427,
+    0x0428, 0x0429, 0x042A, 0x042B, 0x042C, 0x042D, 0x042E, 0x042F,
+    0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,
+    0x0438, 0x0439, 0x043A, 0x043B, 0x043C, 0x043D, 0x043E, 0x043F,
+    0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,
+    0x0448, 0x0449, 0x044A, 0x044B, 0x044C, 0x044D, 0x044E, 0x044F
+};
+
+static const quint16 upper1252[ 128 ] = {
+    0x20AC, 0x0000, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x0000, 0x017D, 0x0000,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x0000, 0x017E, 0x0178,
+    0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7,
+    0x00A8, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+    0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+    0x00B8, 0x00B9, 0x00BA, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00BF,
+    0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,
+    0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+    0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,
+    0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,
+    0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,
+    0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+    0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,
+    0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF
+};
+
+static const quint16 upper1253[ 128 ] = {
+    0x20AC, 0x0000, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x0000, 0x2030, 0x0000, 0x2039, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x0000, 0x2122, 0x0000, 0x203A, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x00A0, 0x0385, 0x0386, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7,
+    0x00A8, 0x00A9, 0x0000, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x2015,
+    0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x0384, 0x00B5, 0x00B6, 0x00B7,
+    0x0388, 0x0389, 0x038A, 0x00BB, 0x038C, 0x00BD, 0x038E, 0x038F,
+    0x0390, 0x0391, 0x0392, 0x0393, 0x0394, 0x0395, 0x0396, 0x0397,
+    0x0398, 0x0399, 0x039A, 0x039B, 0x039C, 0x039D, 0x039E, 0x039F,
+    0x03A0, 0x03A1, 0x0000, 0x03A3, 0x03A4, 0x03A5, 0x03A6, 0x03A7,
+    0x03A8, 0x03A9, 0x03AA, 0x03AB, 0x03AC, 0x03AD, 0x03AE, 0x03AF,
+    0x03B0, 0x03B1, 0x03B2, 0x03B3, 0x03B4, 0x03B5, 0x03B6, 0x03B7,
+    0x03B8, 0x03B9, 0x03BA, 0x03BB, 0x03BC, 0x03BD, 0x03BE, 0x03BF,
+    0x03C0, 0x03C1, 0x03C2, 0x03C3, 0x03C4, 0x03C5, 0x03C6, 0x03C7,
+    0x03C8, 0x03C9, 0x03CA, 0x03CB, 0x03CC, 0x03CD, 0x03CE, 0x0000
+};
+
+static const quint16 upper1254[ 128 ] = {
+    0x20AC, 0x0000, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x0000, 0x0000, 0x0178,
+    0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7,
+    0x00A8, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+    0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+    0x00B8, 0x00B9, 0x00BA, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00BF,
+    0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,
+    0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+    0x011E, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,
+    0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x0130, 0x015E, 0x00DF,
+    0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,
+    0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+    0x011F, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,
+    0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x0131, 0x015F, 0x00FF
+};
+
+static const quint16 upper1257[ 128 ] = {
+    0x20AC, 0x0000, 0x201A, 0x0000, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x0000, 0x2030, 0x0000, 0x2039, 0x0000, 0x00A8, 0x02C7, 0x00B8,
+    0x0000, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x0000, 0x2122, 0x0000, 0x203A, 0x0000, 0x00AF, 0x02DB, 0x0000,
+    0x00A0, 0x0000, 0x00A2, 0x00A3, 0x00A4, 0x0000, 0x00A6, 0x00A7,
+    0x00D8, 0x00A9, 0x0156, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00C6,
+    0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+    0x00F8, 0x00B9, 0x0157, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00E6,
+    0x0104, 0x012E, 0x0100, 0x0106, 0x00C4, 0x00C5, 0x0118, 0x0112,
+    0x010C, 0x00C9, 0x0179, 0x0116, 0x0122, 0x0136, 0x012A, 0x013B,
+    0x0160, 0x0143, 0x0145, 0x00D3, 0x014C, 0x00D5, 0x00D6, 0x00D7,
+    0x0172, 0x0141, 0x015A, 0x016A, 0x00DC, 0x017B, 0x017D, 0x00DF,
+    0x0105, 0x012F, 0x0101, 0x0107, 0x00E4, 0x00E5, 0x0119, 0x0113,
+    0x010D, 0x00E9, 0x017A, 0x0117, 0x0123, 0x0137, 0x012B, 0x013C,
+    0x0161, 0x0144, 0x0146, 0x00F3, 0x014D, 0x00F5, 0x00F6, 0x00F7,
+    0x0173, 0x0142, 0x015B, 0x016B, 0x00FC, 0x017C, 0x017E, 0x02D9
+};
+
+
+static const struct {
+    quint16        codePage;
+    const char    *description;
+    const quint16 *upper;           // single-byte code pages
+    const char    *codec;           // double-byte code pages
+} codePageTable[] = {
+    {  437, QT_TRANSLATE_NOOP("CodePageCoverage", "United States"), upper437, 0 },
+    {  850, QT_TRANSLATE_NOOP("CodePageCoverage", "Multilingual (Latin-1)"), upper850, 0 },
+    {  852, QT_TRANSLATE_NOOP("CodePageCoverage", "Latin-2 (Central Europe)"), upper852, 0 },
+    {  855, QT_TRANSLATE_NOOP("CodePageCoverage", "Cyrillic"), upper855, 0 },
+    {  857, QT_TRANSLATE_NOOP("CodePageCoverage", "Turkish"), upper857, 0 },
+    {  860, QT_TRANSLATE_NOOP("CodePageCoverage", "Portuguese"), upper860, 0 },
+    {  861, QT_TRANSLATE_NOOP("CodePageCoverage", "Icelandic"), upper861, 0 },
+    {  862, QT_TRANSLATE_NOOP("CodePageCoverage", "Hebrew"), upper862, 0 },
+    {  863, QT_TRANSLATE_NOOP("CodePageCoverage", "Canadian French"), upper863, 0 },
+    {  864, QT_TRANSLATE_NOOP("CodePageCoverage", "Arabic"), upper864, 0 },
+    {  865, QT_TRANSLATE_NOOP("CodePageCoverage", "Nordic"), upper865, 0 },
+    {  866, QT_TRANSLATE_NOOP("CodePageCoverage", "Russian"), upper866, 0 },
+    {  869, QT_TRANSLATE_NOOP("CodePageCoverage", "Greek"), upper869, 0 },
+    {  874, QT_TRANSLATE_NOOP("CodePageCoverage", "Thai"), upper874, 0 },
+    {  932, QT_TRANSLATE_NOOP("CodePageCoverage", "Japanese"), 0, "Shift_JIS" },
+    {  949, QT_TRANSLATE_NOOP("CodePageCoverage", "Korean"), 0, "cp949" },
+    {  950, QT_TRANSLATE_NOOP("CodePageCoverage", "Traditional Chinese"), 0, "Big5" },
+    { 1004, QT_TRANSLATE_NOOP("CodePageCoverage", "Latin-1 desktop publishing"), upper1004, 0 },
+    { 1250, QT_TRANSLATE_NOOP("CodePageCoverage", "Windows Latin-2"), upper1250, 0 },
+    { 1251, QT_TRANSLATE_NOOP("CodePageCoverage", "Windows Cyrillic"), upper1251, 0 },
+    { 1252, QT_TRANSLATE_NOOP("CodePageCoverage", "Windows Latin-1"), upper1252, 0 },
+    { 1253, QT_TRANSLATE_NOOP("CodePageCoverage", "Windows Greek"), upper1253, 0 },
+    { 1254, QT_TRANSLATE_NOOP("CodePageCoverage", "Windows Turkish"), upper1254, 0 },
+    { 1257, QT_TRANSLATE_NOOP("CodePageCoverage", "Windows Baltic"), upper1257, 0 },
+    { 1386, QT_TRANSLATE_NOOP("CodePageCoverage", "Simplified Chinese"), 0, "GBK" }
+};
+
+#define CODE_PAGE_COUNT     (int)( sizeof( codePageTable ) / sizeof( codePageTable[ 0 ] ))
+
+
+/* The combined character set and each code page's bitmap over it.  The
+ * double-byte code pages are left empty unless asked for.
+ */
+class CodePageSets
+{
+public:
+    CodePageSets( bool doubleByte );
+
+    QVector<uint>               characters;     // ascending
+    QHash<uint, int>            bits;           // character -> bit
+    QVector< QVector<quint32> > pages;          // in codePageTable order
+    QVector<int>                totals;
+    int                         words;
+};
+
+class SingleByteSets : public CodePageSets
+{
+public:
+    SingleByteSets(): CodePageSets( false ) {}
+};
+
+class AllCodePageSets : public CodePageSets
+{
+public:
+    AllCodePageSets(): CodePageSets( true ) {}
+};
+
+Q_GLOBAL_STATIC( SingleByteSets, singleByteSets )
+Q_GLOBAL_STATIC( AllCodePageSets, allCodePageSets )
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* Add the character encoded by the given bytes, if they are a complete,
+ * valid, printable character.
+ */
+static void decodeCharacter( QTextCodec *codec, const char *bytes, int length, QList<uint> &found )
+{
+    QTextCodec::ConverterState state( QTextCodec::ConvertInvalidToNull );
+    QString text = codec->toUnicode( bytes, length, &state );
+    if ( state.invalidChars || state.remainingChars || text.size() != 1 )
+        return;
+    ushort u = text.at( 0 ).unicode();
+    if ( u >= 0x20 && u != 0xFFFD && !( u >= 0x7F && u < 0xA0 ))
+        found.append( u );
+}
+
+
+/* List the characters of a double-byte code page: the single bytes above
+ * ASCII, then every lead and trail byte pair.
+ */
+static QList<uint> doubleByteCharacters( const char *codecName )
+{
+    QList<uint> found;
+    QTextCodec *codec = QTextCodec::codecForName( codecName );
+    if ( !codec )
+        return found;
+
+    char bytes[ 2 ];
+    for ( int lead = 0x80; lead <= 0xFF; lead++ ) {
+        bytes[ 0 ] = (char) lead;
+        decodeCharacter( codec, bytes, 1, found );
+        for ( int trail = 0x40; trail <= 0xFE; trail++ ) {
+            bytes[ 1 ] = (char) trail;
+            decodeCharacter( codec, bytes, 2, found );
+        }
+    }
+    return found;
+}
+
+
+CodePageSets::CodePageSets( bool doubleByte )
+{
+    QList< QList<uint> > lists;
+    QList<uint> all;
+    for ( int i = 0; i < CODE_PAGE_COUNT; i++ ) {
+        QList<uint> upper;
+        if ( codePageTable[ i ].upper ) {
+            for ( int b = 0; b < 128; b++ )
+                if ( codePageTable[ i ].upper[ b ] )
+                    upper.append( codePageTable[ i ].upper[ b ] );
+        }
+        else if ( doubleByte )
+            upper = doubleByteCharacters( codePageTable[ i ].codec );
+
+        // A code page with nothing above ASCII has no codec, and is left empty
+        QList<uint> list;
+        if ( !upper.isEmpty() ) {
+            for ( uint c = 0x20; c < 0x7F; c++ )
+                list.append( c );
+            if ( GlyphNames::hasPcGraphics( codePageTable[ i ].codePage )) {
+                for ( uint b = 0x01; b < 0x20; b++ )
+                    list.append( GlyphNames::codePoint( codePageTable[ i ].codePage, b ));
+                list.append( GlyphNames::codePoint( codePageTable[ i ].codePage, 0x7F ));
+            }
+            list += upper;
+        }
+        lists.append( list );
+        all += list;
+    }
+
+    qSort( all );
+    for ( int i = 0; i < all.size(); i++ )
+        if ( i == 0 || all.at( i ) != all.at( i - 1 )) {
+            bits.insert( all.at( i ), characters.size() );
+            characters.append( all.at( i ));
+        }
+
+    words = qbfWordsForWidth( characters.size() );
+    for ( int i = 0; i < lists.size(); i++ ) {
+        QVector<quint32> page( words, 0 );
+        int total = 0;
+        for ( int j = 0; j < lists.at( i ).size(); j++ ) {
+            int bit = bits.value( lists.at( i ).at( j ));
+            if ( !( page.at( bit >> 5 ) & ( 1u << ( bit & 31 )))) {
+                page[ bit >> 5 ] |= 1u << ( bit & 31 );
+                total++;
+            }
+        }
+        pages.append( page );
+        totals.append( total );
+    }
+}
+
+
+static int tableIndex( quint16 codePage )
+{
+    for ( int i = 0; i < CODE_PAGE_COUNT; i++ )
+        if ( codePageTable[ i ].codePage == codePage )
+            return i;
+    return -1;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+CodePageCoverage::CodePageCoverage()
+{
+    pSets       = 0;
+    pDocument   = 0;
+    bDoubleByte = false;
+    iUnmapped   = 0;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* Map every glyph of the font into the combined character set.
+ *
+ * Glyphs are mapped through the font's code page, which only covers its
+ * first 256 characters.  The extra glyphs of an OS/2 font in UGL order
+ * (those past 255 in a font which isn't in UCS-2) have no known Unicode
+ * value, so they aren't counted; unmappedGlyphs() says how many there are.
+ */
+void CodePageCoverage::setDocument( const FontDocument *document )
+{
+    pDocument = document;
+    pSets     = bDoubleByte? (const CodePageSets *) allCodePageSets():
+                             (const CodePageSets *) singleByteSets();
+    iUnmapped = 0;
+
+    const CodePageSets *sets = pSets;
+    present.fill( 0, sets->words );
+    inkedCount.fill( 0, sets->characters.size() );
+    firstGlyph.fill( -1, sets->characters.size() );
+    glyphBits.fill( -1, document->glyphCount() );
+    glyphInked.fill( false, document->glyphCount() );
+
+    for ( int i = 0; i < document->glyphCount(); i++ ) {
+        uint c = GlyphNames::codePoint( document->codePage(), document->firstChar() + i );
+        if ( c == NO_CODE_POINT && document->firstChar() + i > 0xFF )
+            iUnmapped++;
+        int bit = sets->bits.value( c, -1 );
+        glyphBits[ i ] = bit;
+        if ( bit >= 0 && firstGlyph.at( bit ) < 0 )
+            firstGlyph[ bit ] = i;
+        updateGlyph( document, i );
+    }
+}
+
+
+/* Include the double-byte code pages from now on.  Finding their characters
+ * is slow (see CODE PAGE TABLES above), so this is left until they are
+ * actually shown.  The current document, if any, is mapped again.
+ */
+void CodePageCoverage::setDoubleByte( bool include )
+{
+    if ( include == bDoubleByte )
+        return;
+    bDoubleByte = include;
+    if ( pDocument )
+        setDocument( pDocument );
+}
+
+
+void CodePageCoverage::updateGlyph( const FontDocument *document, int index )
+{
+    if ( index < 0 || index >= glyphBits.size() || glyphBits.at( index ) < 0 )
+        return;
+    uint c = pSets->characters.at( glyphBits.at( index ));
+    bool inked = !document->metrics().glyph( index ).blank ||
+                 ( c <= 0xFFFF && QChar( (ushort) c ).isSpace() );
+    setInked( index, inked );
+}
+
+
+/* The coverage of every code page, in order of code page number.  Double-
+ * byte code pages are left out unless setDoubleByte() has been called, or
+ * if Qt has no codec for them.
+ */
+QList<CodePageCoverage::Result> CodePageCoverage::results() const
+{
+    const CodePageSets *sets = pSets;
+    QList<Result> list;
+    if ( !sets )
+        return list;
+    for ( int i = 0; i < CODE_PAGE_COUNT; i++ ) {
+        if ( sets->totals.at( i ) == 0 )
+            continue;
+        Result result;
+        result.codePage = codePageTable[ i ].codePage;
+        result.total    = sets->totals.at( i );
+        result.covered  = 0;
+        const quint32 *page = sets->pages.at( i ).constData();
+        for ( int w = 0; w < present.size(); w++ )
+            result.covered += qbfPopCount( page[ w ] & present.at( w ));
+        list.append( result );
+    }
+    return list;
+}
+
+
+QList<quint16> CodePageCoverage::fullyCovered() const
+{
+    QList<quint16> covered;
+    QList<Result> all = results();
+    for ( int i = 0; i < all.size(); i++ )
+        if ( all.at( i ).covered == all.at( i ).total )
+            covered.append( all.at( i ).codePage );
+    return covered;
+}
+
+
+/* The characters of a code page which the font lacks, in Unicode order.
+ */
+QList<uint> CodePageCoverage::missing( quint16 codePage ) const
+{
+    QList<uint> list;
+    int table = tableIndex( codePage );
+    if ( table < 0 || present.isEmpty() )
+        return list;
+
+    const CodePageSets *sets = pSets;
+    const quint32 *page = sets->pages.at( table ).constData();
+    for ( int w = 0; w < present.size(); w++ ) {
+        quint32 lacking = page[ w ] & ~present.at( w );
+        while ( lacking ) {
+            int bit = qbfTrailingZeros( lacking );
+            list.append( sets->characters.at(( w << 5 ) + bit ));
+            lacking &= lacking - 1;
+        }
+    }
+    return list;
+}
+
+
+/* The glyph for a character, if the font has one at all (blank or not).
+ */
+int CodePageCoverage::glyphForCodePoint( uint codePoint ) const
+{
+    if ( !pSets )
+        return -1;
+    int bit = pSets->bits.value( codePoint, -1 );
+    if ( bit < 0 || bit >= firstGlyph.size() )
+        return -1;
+    return firstGlyph.at( bit );
+}
+
+
+/* A plain text report, one line per code page, optionally followed by the
+ * code points and names of the missing characters.
+ */
+QString CodePageCoverage::report( bool listMissing ) const
+{
+    QString text;
+    QList<Result> all = results();
+    for ( int i = 0; i < all.size(); i++ ) {
+        const Result &result = all.at( i );
+        text += QCoreApplication::translate("CodePageCoverage", "%1 %2: %3 of %4 characters%5\n")
+                    .arg( result.codePage, 5 )
+                    .arg( description( result.codePage ), -28 )
+                    .arg( result.covered, 5 )
+                    .arg( result.total )
+                    .arg( result.covered == result.total?
+                          QCoreApplication::translate("CodePageCoverage", " (complete)"): QString() );
+        if ( !listMissing || result.covered == result.total )
+            continue;
+        QList<uint> lacking = missing( result.codePage );
+        for ( int j = 0; j < lacking.size(); j++ )
+            text += QString("        U+%1  %2\n")
+                        .arg( QString("%1").arg( lacking.at( j ), 4, 16, QChar('0') ).toUpper() )
+                        .arg( GlyphNames::name( lacking.at( j )));
+    }
+    if ( iUnmapped )
+        text += QCoreApplication::translate("CodePageCoverage",
+                                            "%n glyph(s) past character 255 have no Unicode value "
+                                            "in this code page and were not counted.\n", "",
+                                            QCoreApplication::CodecForTr, iUnmapped );
+    return text;
+}
+
+
+QList<quint16> CodePageCoverage::codePages()
+{
+    QList<quint16> list;
+    for ( int i = 0; i < CODE_PAGE_COUNT; i++ )
+        list.append( codePageTable[ i ].codePage );
+    return list;
+}
+
+
+QString CodePageCoverage::description( quint16 codePage )
+{
+    int table = tableIndex( codePage );
+    if ( table < 0 )
+        return QString();
+    return QCoreApplication::translate("CodePageCoverage", codePageTable[ table ].description );
+}
+
+
+/* The Unicode value of each byte 0-255 of a single-byte code page, or
+ * NO_CODE_POINT for bytes with no character.  Bytes below 0x20 and 0x7F
+ * map as in GlyphNames::codePoint(): to the PC graphics characters in the
+ * PC code pages, otherwise to themselves.  Empty for any other code page.
+ */
+QVector<uint> CodePageCoverage::byteTable( quint16 codePage )
+{
+    QVector<uint> table;
+    int index = tableIndex( codePage );
+    if ( index < 0 || !codePageTable[ index ].upper )
+        return table;
+
+    table.resize( 256 );
+    for ( int b = 0; b < 0x80; b++ )
+        table[ b ] = ( b < 0x20 || b == 0x7F )? GlyphNames::codePoint( codePage, b ): b;
+    for ( int b = 0x80; b < 0x100; b++ ) {
+        quint16 u = codePageTable[ index ].upper[ b - 0x80 ];
+        table[ b ] = u? u: NO_CODE_POINT;
+    }
+    return table;
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+void CodePageCoverage::setInked( int glyph, bool inked )
+{
+    if ( glyphInked.at( glyph ) == inked )
+        return;
+    glyphInked[ glyph ] = inked;
+
+    int bit = glyphBits.at( glyph );
+    inkedCount[ bit ] += inked? 1: -1;
+    if ( inkedCount.at( bit ))
+        present[ bit >> 5 ] |= 1u << ( bit & 31 );
+    else
+        present[ bit >> 5 ] &= ~( 1u << ( bit & 31 ));
+}
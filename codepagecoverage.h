@@ -0,0 +1,88 @@
+/******************************************************************************
+** codepagecoverage.h
+**
+** Which code pages a font fully covers, and which glyphs each one lacks.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#ifndef CODEPAGECOVERAGE_H
+#define CODEPAGECOVERAGE_H
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+class CodePageSets;
+class FontDocument;
+
+
+/* Every character of every known code page is given a bit in one combined
+ * set, ordered by Unicode value, and each code page is a bitmap over that
+ * set.  The font's glyphs are mapped into the same set, so the coverage of
+ * each code page is a word-wide AND and population count, and its missing
+ * characters are the bits of an AND NOT.
+ *
+ * A character counts as present if its glyph has any ink, or if it is a
+ * space character.  After setDocument(), updateGlyph() keeps the set up to
+ * date as single glyphs change.  Only the single-byte code pages are
+ * included until setDoubleByte() is called.
+ */
+class CodePageCoverage
+{
+public:
+    struct Result {
+        quint16 codePage;
+        int     covered;
+        int     total;
+    };
+
+    CodePageCoverage();
+
+    void    setDocument( const FontDocument *document );
+    void    setDoubleByte( bool include );
+    void    updateGlyph( const FontDocument *document, int index );
+    int     unmappedGlyphs() const { return iUnmapped; }
+
+    QList<Result>  results() const;
+    QList<quint16> fullyCovered() const;
+    QList<uint>    missing( quint16 codePage ) const;
+    int            glyphForCodePoint( uint codePoint ) const;
+    QString        report( bool listMissing ) const;
+
+    static QList<quint16> codePages();
+    static QString        description( quint16 codePage );
+    static QVector<uint>  byteTable( quint16 codePage );
+
+private:
+    void    setInked( int glyph, bool inked );
+
+    const CodePageSets *pSets;
+    const FontDocument *pDocument;
+    bool                bDoubleByte;
+    int                 iUnmapped;      // glyphs with no Unicode value
+
+    QVector<quint32> present;       // one bit per character of the combined set
+    QVector<int>     inkedCount;    // glyphs with ink for each character
+    QVector<int>     glyphBits;     // character of each glyph, or -1
+    QVector<int>     firstGlyph;    // first glyph for each character, or -1
+    QVector<bool>    glyphInked;
+};
+
+#endif  // CODEPAGECOVERAGE_H
@@ -0,0 +1,221 @@
+/******************************************************************************
+** codepageremap.cpp
+**
+** Generation of code page specific fonts from a Unicode master font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QtConcurrentMap>
+
+#include "codepagecoverage.h"
+#include "codepageremap.h"
+#include "fontdocument.h"
+#include "glyphnames.h"
+#include "os2fontfile.h"
+
+// Every variant holds one full single-byte code page
+#define VARIANT_GLYPHS      256
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* Build the permutation for a code page from its byte table, given the
+ * master glyph for each Unicode value.
+ */
+static QVector<int> permutationFor( const QHash<uint, int> &glyphs, const QVector<uint> &bytes )
+{
+    QVector<int> table( VARIANT_GLYPHS, -1 );
+    for ( int b = 0; b < bytes.size() && b < VARIANT_GLYPHS; b++ )
+        table[ b ] = glyphs.value( bytes.at( b ), -1 );
+    return table;
+}
+
+
+static QHash<uint, int> masterCodePoints( const FontDocument *master )
+{
+    QHash<uint, int> glyphs;
+    for ( int i = master->glyphCount() - 1; i >= 0; i-- ) {
+        uint c = GlyphNames::codePoint( master->codePage(), master->firstChar() + i );
+        if ( c != NO_CODE_POINT )
+            glyphs.insert( c, i );
+    }
+    return glyphs;
+}
+
+
+/* Count the printable characters of the code page which have no glyph.
+ * In the PC code pages these include the graphics characters at 0x01-0x1F
+ * and 0x7F.
+ */
+static int countMissing( const QVector<int> &table, const QVector<uint> &bytes )
+{
+    int missing = 0;
+    for ( int b = 0; b < table.size(); b++ ) {
+        uint c = bytes.at( b );
+        if ( table.at( b ) < 0 && c != NO_CODE_POINT && c >= 0x20 && !( c >= 0x7F && c < 0xA0 ))
+            missing++;
+    }
+    return missing;
+}
+
+
+static FontDocument *buildVariant( const FontDocument *master, quint16 codePage,
+                                   const QVector<int> &table, const QHash<int, GlyphBitmap> &bitmaps,
+                                   const GlyphBitmap &blank, QObject *parent )
+{
+    QVector<GlyphBitmap> glyphs( VARIANT_GLYPHS );
+    for ( int b = 0; b < VARIANT_GLYPHS; b++ )
+        glyphs[ b ] = ( table.at( b ) >= 0 )? bitmaps.value( table.at( b )): blank;
+
+    FontDocument *variant = new FontDocument( parent );
+    variant->setFamilyName( master->familyName() );
+    variant->setFaceName( master->faceName() );
+    variant->setCodePage( codePage );
+    variant->setPointSize( master->pointSize() );
+    variant->setFirstChar( 0 );
+    variant->setBaseLine( master->baseLine() );
+    variant->setGlyphs( glyphs );
+    return variant;
+}
+
+
+static GlyphBitmap blankCell( const FontDocument *master )
+{
+    return GlyphBitmap( qMax( master->metrics().averageIncrement(), 1 ), qMax( master->cellHeight(), 1 ));
+}
+
+
+// ---------------------------------------------------------------------------
+// Builds and writes one variant (for QtConcurrent).  Everything it reads is
+// shared between the jobs and left unchanged; each job only creates and
+// deletes its own document.
+//
+struct VariantJob
+{
+    typedef void result_type;
+
+    void operator()( CodePageRemap::Variant &variant ) const
+    {
+        if ( !variant.error.isEmpty() )
+            return;
+
+        const QVector<int> &table = tables->value( variant.codePage );
+        FontDocument *document = buildVariant( master, variant.codePage, table, *bitmaps, blank, 0 );
+        QByteArray data = OS2FontFile::write( document );
+        delete document;
+
+        QFile file( variant.fileName );
+        if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ))
+            variant.error = file.errorString();
+        else if ( file.write( data ) != data.size() )
+            variant.error = file.errorString();
+    }
+
+    const FontDocument                  *master;
+    const QHash<quint16, QVector<int> > *tables;
+    const QHash<int, GlyphBitmap>       *bitmaps;
+    GlyphBitmap                          blank;
+};
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC FUNCTIONS
+//
+
+/* The master glyph for each byte of the code page, or -1 where there is
+ * none.  Empty if the code page isn't a known single-byte code page.
+ */
+QVector<int> CodePageRemap::permutation( const FontDocument *master, quint16 codePage )
+{
+    QVector<uint> bytes = CodePageCoverage::byteTable( codePage );
+    if ( bytes.isEmpty() )
+        return QVector<int>();
+    return permutationFor( masterCodePoints( master ), bytes );
+}
+
+
+/* Create a single variant as a new document, e.g. to be edited further.
+ */
+FontDocument *CodePageRemap::remap( const FontDocument *master, quint16 codePage, QObject *parent )
+{
+    QVector<int> table = permutation( master, codePage );
+    if ( table.isEmpty() )
+        return 0;
+
+    QHash<int, GlyphBitmap> bitmaps;
+    for ( int b = 0; b < table.size(); b++ )
+        if ( table.at( b ) >= 0 && !bitmaps.contains( table.at( b )))
+            bitmaps.insert( table.at( b ), master->decodeGlyph( table.at( b )));
+    return buildVariant( master, codePage, table, bitmaps, blankCell( master ), parent );
+}
+
+
+/* Write a variant for each of the code pages into the directory, named
+ * baseName followed by the code page number.  Returns what became of each.
+ */
+QList<CodePageRemap::Variant> CodePageRemap::generate( const FontDocument *master, const QList<quint16> &codePages,
+                                                       const QString &directory, const QString &baseName )
+{
+    QHash<uint, int>               glyphs = masterCodePoints( master );
+    QHash<quint16, QVector<int> >  tables;
+    QHash<int, GlyphBitmap>        bitmaps;
+    QVector<Variant>               variants;
+
+    for ( int i = 0; i < codePages.size(); i++ ) {
+        if ( tables.contains( codePages.at( i )))
+            continue;
+
+        Variant variant;
+        variant.codePage = codePages.at( i );
+        variant.fileName = QDir( directory ).filePath( QString("%1%2.fnt").arg( baseName ).arg( variant.codePage ));
+        variant.missing  = 0;
+
+        QVector<uint> bytes = CodePageCoverage::byteTable( variant.codePage );
+        if ( bytes.isEmpty() )
+            variant.error = QCoreApplication::translate("CodePageRemap", "Code page %1 is not a single-byte code page.")
+                                .arg( variant.codePage );
+        else {
+            QVector<int> table = permutationFor( glyphs, bytes );
+            variant.missing = countMissing( table, bytes );
+            tables.insert( variant.codePage, table );
+
+            // Each master glyph is decoded once, however many variants use it
+            for ( int b = 0; b < table.size(); b++ )
+                if ( table.at( b ) >= 0 && !bitmaps.contains( table.at( b )))
+                    bitmaps.insert( table.at( b ), master->decodeGlyph( table.at( b )));
+        }
+        variants.append( variant );
+    }
+
+    VariantJob job;
+    job.master  = master;
+    job.tables  = &tables;
+    job.bitmaps = &bitmaps;
+    job.blank   = blankCell( master );
+    QtConcurrent::blockingMap( variants, job );
+
+    return variants.toList();
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+** codepageremap.h
+**
+** Generation of code page specific fonts from a Unicode master font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#ifndef CODEPAGEREMAP_H
+#define CODEPAGEREMAP_H
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+class QObject;
+class FontDocument;
+
+
+/* Each variant is a 256-character font in one single-byte code page, whose
+ * glyphs are taken from the master font (normally a Unicode font, though
+ * any font whose glyphs have known Unicode values will do).  The mapping
+ * is a permutation table giving the master glyph for each byte, built from
+ * the code page tables in CodePageCoverage.  Characters which the master
+ * lacks are left as blank cells.
+ *
+ * generate() decodes every master glyph any variant needs just once; the
+ * variants all share those bitmaps, and are built and written in parallel.
+ */
+namespace CodePageRemap {
+    struct Variant {
+        quint16 codePage;
+        QString fileName;
+        int     missing;        // characters the master has no glyph for
+        QString error;          // empty if the file was written
+    };
+
+    QVector<int>    permutation( const FontDocument *master, quint16 codePage );
+    FontDocument   *remap( const FontDocument *master, quint16 codePage, QObject *parent = 0 );
+    QList<Variant>  generate( const FontDocument *master, const QList<quint16> &codePages,
+                              const QString &directory, const QString &baseName );
+};
+
+#endif  // CODEPAGEREMAP_H
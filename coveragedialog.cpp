@@ -0,0 +1,152 @@
+/******************************************************************************
+** coveragedialog.cpp
+**
+** Dialog showing which code pages a font covers and what each one lacks.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#include <QtGui>
+
+#include "coveragedialog.h"
+#include "glyphnames.h"
+
+// Missing characters listed for one code page, at most
+#define MAX_MISSING_LISTED  2000
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+CoverageDialog::CoverageDialog( QWidget *parent ): QDialog( parent )
+{
+    pCoverage = 0;
+
+    pageTree = new QTreeWidget();
+    pageTree->setRootIsDecorated( false );
+    pageTree->setHeaderLabels( QStringList() << tr("Code page") << tr("Name") << tr("Covered") << tr("Missing") );
+    connect( pageTree, SIGNAL( itemSelectionChanged() ), this, SLOT( showMissing() ));
+
+    missingList = new QListWidget();
+    connect( missingList, SIGNAL( itemActivated( QListWidgetItem * )),
+             this, SLOT( activateItem( QListWidgetItem * )));
+
+    QLabel *missingLabel = new QLabel( tr("&Missing characters:") );
+    missingLabel->setBuddy( missingList );
+
+    unmappedLabel = new QLabel();
+    unmappedLabel->setWordWrap( true );
+    unmappedLabel->hide();
+
+    QDialogButtonBox *buttons = new QDialogButtonBox( QDialogButtonBox::Close );
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( close() ));
+
+    QVBoxLayout *layout = new QVBoxLayout();
+    layout->addWidget( pageTree, 3 );
+    layout->addWidget( unmappedLabel );
+    layout->addWidget( missingLabel );
+    layout->addWidget( missingList, 2 );
+    layout->addWidget( buttons );
+    setLayout( layout );
+
+    setWindowTitle( tr("Code Page Coverage") );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* Refresh the list of code pages, keeping the current one selected.
+ */
+void CoverageDialog::setCoverage( const CodePageCoverage *coverage )
+{
+    pCoverage = coverage;
+
+    int selected = -1;
+    if ( pageTree->currentItem() )
+        selected = pageTree->currentItem()->data( 0, Qt::UserRole ).toInt();
+
+    QList<CodePageCoverage::Result> results = coverage->results();
+    pageTree->clear();
+    for ( int i = 0; i < results.size(); i++ ) {
+        const CodePageCoverage::Result &result = results.at( i );
+        QTreeWidgetItem *item = new QTreeWidgetItem( pageTree );
+        item->setText( 0, QString::number( result.codePage ));
+        item->setText( 1, CodePageCoverage::description( result.codePage ));
+        item->setText( 2, tr("%1 of %2").arg( result.covered ).arg( result.total ));
+        item->setText( 3, QString::number( result.total - result.covered ));
+        item->setData( 0, Qt::UserRole, result.codePage );
+        item->setTextAlignment( 2, Qt::AlignRight );
+        item->setTextAlignment( 3, Qt::AlignRight );
+        if ( result.covered == result.total )
+            item->setIcon( 0, style()->standardIcon( QStyle::SP_DialogApplyButton ));
+        if ( result.codePage == selected )
+            pageTree->setCurrentItem( item );
+    }
+    for ( int i = 0; i < pageTree->columnCount(); i++ )
+        pageTree->resizeColumnToContents( i );
+
+    // Glyphs past 255 (e.g. those of an OS/2 UGL font) can't be mapped to Unicode
+    int unmapped = coverage->unmappedGlyphs();
+    unmappedLabel->setText( tr("%n glyph(s) past character 255 have no Unicode value in the font's "
+                               "code page, and are not counted.", "", unmapped ));
+    unmappedLabel->setVisible( unmapped > 0 );
+    showMissing();
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void CoverageDialog::showMissing()
+{
+    missingList->clear();
+    QTreeWidgetItem *item = pageTree->currentItem();
+    if ( !item || !pCoverage )
+        return;
+
+    QList<uint> missing = pCoverage->missing( item->data( 0, Qt::UserRole ).toInt() );
+    for ( int i = 0; i < missing.size() && i < MAX_MISSING_LISTED; i++ ) {
+        uint c = missing.at( i );
+        QListWidgetItem *entry = new QListWidgetItem( QString("U+%1  %2")
+                                                        .arg( QString("%1").arg( c, 4, 16, QChar('0') ).toUpper() )
+                                                        .arg( GlyphNames::name( c )));
+        int glyph = pCoverage->glyphForCodePoint( c );
+        if ( glyph >= 0 )
+            entry->setData( Qt::UserRole, glyph );
+        else
+            entry->setForeground( palette().brush( QPalette::Disabled, QPalette::Text ));
+        missingList->addItem( entry );
+    }
+    if ( missing.size() > MAX_MISSING_LISTED )
+        missingList->addItem( tr("(%n more)", "", missing.size() - MAX_MISSING_LISTED ));
+    if ( missing.isEmpty() )
+        missingList->addItem( tr("None: the font covers this code page.") );
+}
+
+
+void CoverageDialog::activateItem( QListWidgetItem *item )
+{
+    QVariant index = item->data( Qt::UserRole );
+    if ( index.isValid() )
+        emit glyphActivated( index.toInt() );
+}
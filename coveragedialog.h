@@ -0,0 +1,66 @@
+/******************************************************************************
+** coveragedialog.h
+**
+** Dialog showing which code pages a font covers and what each one lacks.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#ifndef COVERAGEDIALOG_H
+#define COVERAGEDIALOG_H
+
+#include <QDialog>
+
+#include "codepagecoverage.h"
+
+class QLabel;
+class QListWidget;
+class QListWidgetItem;
+class QTreeWidget;
+
+
+/* A non-modal dialog, refreshed by the main window with setCoverage()
+ * whenever the font changes.  Selecting a code page lists its missing
+ * characters; activating one of those which has a (blank) glyph in the
+ * font emits glyphActivated().
+ */
+class CoverageDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    CoverageDialog( QWidget *parent = 0 );
+
+    void    setCoverage( const CodePageCoverage *coverage );
+
+signals:
+    void glyphActivated( int index );
+
+private slots:
+    void showMissing();
+    void activateItem( QListWidgetItem *item );
+
+private:
+    const CodePageCoverage *pCoverage;
+    QTreeWidget *pageTree;
+    QListWidget *missingList;
+    QLabel      *unmappedLabel;
+};
+
+#endif  // COVERAGEDIALOG_H
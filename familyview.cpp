@@ -0,0 +1,379 @@
+/******************************************************************************
+** familyview.cpp
+**
+** Side-by-side view of one character in every size of a font family.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "familyview.h"
+#include "glyphnames.h"
+
+// Space around each pane's canvas, in pixels
+#define PANE_MARGIN     4
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+FamilyPane::FamilyPane( FontDocument *document, QWidget *parent ): QWidget( parent ),
+    doc( document ), iIndex( -1 ), iZoom( 4 ), bDrawing( false ), bInk( true )
+{
+    setBackgroundRole( QPalette::Base );
+    setAutoFillBackground( true );
+    setSizePolicy( QSizePolicy::Fixed, QSizePolicy::Fixed );
+    connect( doc, SIGNAL( glyphChanged( int )), this, SLOT( updateGlyph( int )));
+    connect( doc, SIGNAL( metricsChanged() ), this, SLOT( updateMetrics() ));
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+void FamilyPane::setGlyph( int index )
+{
+    if ( index == iIndex )
+        return;
+    iIndex   = index;
+    bDrawing = false;
+    update();
+}
+
+
+void FamilyPane::setZoom( int zoom )
+{
+    iZoom = qMax( 1, zoom );
+    updateGeometry();
+    update();
+}
+
+
+QSize FamilyPane::sizeHint() const
+{
+    if ( !doc )
+        return QSize( 0, 0 );
+    return QSize( doc->metrics().maxIncrement() * iZoom + 2 * PANE_MARGIN,
+                  doc->cellHeight() * iZoom + fontMetrics().height() + 3 * PANE_MARGIN );
+}
+
+
+// ---------------------------------------------------------------------------
+// OVERRIDDEN EVENTS
+//
+
+void FamilyPane::paintEvent( QPaintEvent *event )
+{
+    Q_UNUSED( event );
+    if ( !doc )
+        return;
+
+    QPainter painter( this );
+    painter.setPen( palette().text().color() );
+    painter.drawText( QRect( PANE_MARGIN, PANE_MARGIN, width() - 2 * PANE_MARGIN, fontMetrics().height() ),
+                      Qt::AlignCenter, tr("%1 pt").arg( doc->pointSize() ));
+    if ( iIndex < 0 )
+        return;
+
+    GlyphBitmap glyph = bDrawing? working: doc->glyph( iIndex );
+    QRect       canvas = canvasRect();
+    painter.drawImage( canvas, glyph.toImage( palette().text().color().rgb(), palette().base().color().rgb() ));
+
+    // Mark the cell outline and baseline; a grid helps at larger zooms
+    painter.setPen( palette().mid().color() );
+    if ( iZoom >= 4 ) {
+        for ( int x = 1; x < glyph.width(); x++ )
+            painter.drawLine( canvas.left() + x * iZoom, canvas.top(), canvas.left() + x * iZoom, canvas.bottom() );
+        for ( int y = 1; y < glyph.height(); y++ )
+            painter.drawLine( canvas.left(), canvas.top() + y * iZoom, canvas.right(), canvas.top() + y * iZoom );
+    }
+    painter.drawRect( canvas.adjusted( -1, -1, 0, 0 ));
+    painter.setPen( palette().highlight().color() );
+    int baseLine = canvas.top() + ( glyph.height() - doc->baseLine() ) * iZoom;
+    painter.drawLine( canvas.left(), baseLine, canvas.right(), baseLine );
+}
+
+
+void FamilyPane::mousePressEvent( QMouseEvent *event )
+{
+    if ( !doc || iIndex < 0 || ( event->button() != Qt::LeftButton && event->button() != Qt::RightButton )) {
+        QWidget::mousePressEvent( event );
+        return;
+    }
+    working  = doc->glyph( iIndex );
+    bInk     = ( event->button() == Qt::LeftButton );
+    bDrawing = true;
+    paintPixel( event->pos() );
+}
+
+
+void FamilyPane::mouseMoveEvent( QMouseEvent *event )
+{
+    if ( bDrawing )
+        paintPixel( event->pos() );
+}
+
+
+void FamilyPane::mouseReleaseEvent( QMouseEvent *event )
+{
+    Q_UNUSED( event );
+    if ( !bDrawing )
+        return;
+    bDrawing = false;
+    if ( doc && working != doc->glyph( iIndex ))
+        emit glyphEdited( doc, iIndex, working );
+    update();
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void FamilyPane::updateGlyph( int index )
+{
+    if ( index == iIndex && !bDrawing )
+        update();
+}
+
+
+/* The widest glyph may have changed (e.g. the font has been scaled or its
+ * widths fitted), so the pane may need resizing; the font may also have
+ * fewer glyphs than before.
+ */
+void FamilyPane::updateMetrics()
+{
+    if ( doc && iIndex >= doc->glyphCount() ) {
+        iIndex   = -1;
+        bDrawing = false;
+    }
+    updateGeometry();
+    update();
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+/* The glyph is drawn centred below the size caption.
+ */
+QRect FamilyPane::canvasRect() const
+{
+    int glyphWidth = doc->metrics().glyph( iIndex ).increment;
+    int top = 2 * PANE_MARGIN + fontMetrics().height();
+    return QRect(( width() - glyphWidth * iZoom ) / 2, top, glyphWidth * iZoom, doc->cellHeight() * iZoom );
+}
+
+
+void FamilyPane::paintPixel( const QPoint &pos )
+{
+    QRect  canvas = canvasRect();
+    QPoint cell(( pos.x() - canvas.left() ) / iZoom, ( pos.y() - canvas.top() ) / iZoom );
+    if ( !canvas.contains( pos ) || !working.rect().contains( cell ) || working.pixel( cell.x(), cell.y() ) == bInk )
+        return;
+    working.setPixel( cell.x(), cell.y(), bInk );
+    update( canvas.left() + cell.x() * iZoom, canvas.top() + cell.y() * iZoom, iZoom, iZoom );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+FamilyView::FamilyView( QWidget *parent ): QDialog( parent )
+{
+    iCharacter = 0;
+    iFirstChar = 0;
+    iLastChar  = -1;
+
+    characterLabel = new QLabel();
+    characterLabel->setSizePolicy( QSizePolicy::Expanding, QSizePolicy::Preferred );
+
+    QToolButton *previousButton = new QToolButton();
+    previousButton->setArrowType( Qt::LeftArrow );
+    previousButton->setToolTip( tr("Previous character") );
+    previousButton->setAutoRepeat( true );
+    connect( previousButton, SIGNAL( clicked() ), this, SLOT( previousCharacter() ));
+
+    QToolButton *nextButton = new QToolButton();
+    nextButton->setArrowType( Qt::RightArrow );
+    nextButton->setToolTip( tr("Next character") );
+    nextButton->setAutoRepeat( true );
+    connect( nextButton, SIGNAL( clicked() ), this, SLOT( nextCharacter() ));
+
+    zoomSpin = new QSpinBox();
+    zoomSpin->setRange( 1, 16 );
+    zoomSpin->setValue( 4 );
+    zoomSpin->setPrefix( tr("Zoom ") );
+    zoomSpin->setSuffix( tr("x") );
+    connect( zoomSpin, SIGNAL( valueChanged( int )), this, SLOT( updateZoom( int )));
+
+    QPushButton *rescanButton = new QPushButton( tr("&Rescan windows") );
+    rescanButton->setToolTip( tr("Look again for open fonts of this family") );
+    connect( rescanButton, SIGNAL( clicked() ), this, SIGNAL( rescanRequested() ));
+
+    QWidget *paneBox = new QWidget();
+    paneLayout = new QHBoxLayout();
+    paneLayout->addStretch( 1 );
+    paneBox->setLayout( paneLayout );
+
+    QScrollArea *scroller = new QScrollArea();
+    scroller->setWidget( paneBox );
+    scroller->setWidgetResizable( true );
+
+    QDialogButtonBox *buttons = new QDialogButtonBox( QDialogButtonBox::Close );
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( close() ));
+
+    QHBoxLayout *topLayout = new QHBoxLayout();
+    topLayout->addWidget( previousButton );
+    topLayout->addWidget( nextButton );
+    topLayout->addWidget( characterLabel, 1 );
+    topLayout->addWidget( zoomSpin );
+    topLayout->addWidget( rescanButton );
+
+    QVBoxLayout *layout = new QVBoxLayout();
+    layout->addLayout( topLayout );
+    layout->addWidget( scroller, 1 );
+    layout->addWidget( buttons );
+    setLayout( layout );
+
+    setWindowTitle( tr("Font Family") );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* Show the given documents, one pane each.  Panes are reused for sizes
+ * which were already shown.
+ */
+void FamilyView::setSizes( const QList<FontDocument *> &documents )
+{
+    family.setSizes( documents );
+
+    QList<FamilyPane *> old = panes;
+    panes.clear();
+    for ( int i = 0; i < family.count(); i++ ) {
+        FontDocument *document = family.size( i );
+        FamilyPane *pane = 0;
+        for ( int j = 0; j < old.size(); j++ ) {
+            if ( old.at( j )->document() == document ) {
+                pane = old.takeAt( j );
+                break;
+            }
+        }
+        if ( !pane ) {
+            pane = new FamilyPane( document );
+            pane->setZoom( zoomSpin->value() );
+            connect( pane, SIGNAL( glyphEdited( FontDocument *, int, const GlyphBitmap & )),
+                     this, SIGNAL( glyphEdited( FontDocument *, int, const GlyphBitmap & )));
+            connect( document, SIGNAL( destroyed() ), this, SLOT( removeClosedSizes() ), Qt::QueuedConnection );
+        }
+        paneLayout->removeWidget( pane );
+        paneLayout->insertWidget( i, pane );
+        panes.append( pane );
+    }
+    qDeleteAll( old );
+
+    setWindowTitle( family.count()? tr("Font Family - %1").arg( family.name() ): tr("Font Family") );
+    int character = iCharacter;
+    iCharacter = -1;
+    setCharacter( character );
+}
+
+
+/* Limit stepping from character to character to the given range, that of
+ * the font in the window which owns the view.
+ */
+void FamilyView::setCharacterRange( int first, int last )
+{
+    iFirstChar = first;
+    iLastChar  = last;
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+/* Show the character in every size.  Each pane only records its glyph and
+ * asks to be repainted, so however many sizes there are the view is redrawn
+ * once, and only the panes scrolled into view decode their glyphs.
+ */
+void FamilyView::setCharacter( int character )
+{
+    if ( character == iCharacter )
+        return;
+    iCharacter = character;
+
+    for ( int i = 0; i < panes.size(); i++ )
+        panes.at( i )->setGlyph( family.glyphIndex( i, character ));
+
+    // Only characters beyond a single-byte code page are numbered by UGL value
+    QString number = ( character > 0xFF && family.codePage() != UCS2_CODEPAGE )?
+                     tr("UGL %1").arg( character ): tr("Character %1").arg( character );
+    uint value = family.codePoint( character );
+    if ( value == NO_CODE_POINT )
+        characterLabel->setText( number );
+    else
+        characterLabel->setText( tr("%1   U+%2   %3").arg( number )
+                                     .arg( QString("%1").arg( value, 4, 16, QChar('0') ).toUpper() )
+                                     .arg( family.glyphName( character )));
+}
+
+
+void FamilyView::previousCharacter()
+{
+    if ( iCharacter <= qMax( family.firstChar(), iFirstChar ))
+        return;
+    setCharacter( iCharacter - 1 );
+    emit characterSelected( iCharacter );
+}
+
+
+void FamilyView::nextCharacter()
+{
+    if ( iCharacter >= qMin( family.lastChar(), iLastChar ))
+        return;
+    setCharacter( iCharacter + 1 );
+    emit characterSelected( iCharacter );
+}
+
+
+void FamilyView::updateZoom( int zoom )
+{
+    for ( int i = 0; i < panes.size(); i++ )
+        panes.at( i )->setZoom( zoom );
+}
+
+
+/* A size's window has been closed; drop it from the family.
+ */
+void FamilyView::removeClosedSizes()
+{
+    QList<FontDocument *> documents;
+    for ( int i = 0; i < family.count(); i++ )
+        if ( family.size( i ))
+            documents.append( family.size( i ));
+    setSizes( documents );
+}
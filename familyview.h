@@ -0,0 +1,128 @@
+/******************************************************************************
+** familyview.h
+**
+** Side-by-side view of one character in every size of a font family.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef FAMILYVIEW_H
+#define FAMILYVIEW_H
+
+#include <QDialog>
+#include <QPointer>
+
+#include "fontfamily.h"
+
+class QHBoxLayout;
+class QLabel;
+class QSpinBox;
+
+
+/* A small canvas showing one glyph of one size, on which pixels can be set
+ * (left button) or cleared (right button).  The change is kept locally
+ * while the button is down and handed on by glyphEdited() when it is
+ * released, for the window owning the document to store as an undo step.
+ * Its width is fixed by the size's widest glyph, so stepping from glyph to
+ * glyph never changes the layout, and the glyph is only decoded when the
+ * pane is actually painted.
+ */
+class FamilyPane : public QWidget
+{
+    Q_OBJECT
+
+public:
+    FamilyPane( FontDocument *document, QWidget *parent = 0 );
+
+    FontDocument *document() const { return doc; }
+    void    setGlyph( int index );
+    void    setZoom( int zoom );
+
+    QSize   sizeHint() const;
+
+signals:
+    void glyphEdited( FontDocument *document, int index, const GlyphBitmap &glyph );
+
+protected:
+    void    paintEvent( QPaintEvent *event );
+    void    mousePressEvent( QMouseEvent *event );
+    void    mouseMoveEvent( QMouseEvent *event );
+    void    mouseReleaseEvent( QMouseEvent *event );
+
+private slots:
+    void    updateGlyph( int index );
+    void    updateMetrics();
+
+private:
+    QRect   canvasRect() const;
+    void    paintPixel( const QPoint &pos );
+
+    QPointer<FontDocument> doc;
+    int          iIndex;
+    int          iZoom;
+    bool         bDrawing;
+    bool         bInk;
+    GlyphBitmap  working;       // the glyph being drawn on
+};
+
+
+/* A non-modal dialog with a pane for each size of the family, which the
+ * main window keeps on the character it is editing.  Moving to another
+ * character here emits characterSelected() for the main window to follow,
+ * so it stays within the range of characters that window's font has (sizes
+ * without the character show an empty pane).  The character data shared by
+ * all sizes is kept once, in FontFamily.
+ */
+class FamilyView : public QDialog
+{
+    Q_OBJECT
+
+public:
+    FamilyView( QWidget *parent = 0 );
+
+    void    setSizes( const QList<FontDocument *> &documents );
+    void    setCharacterRange( int first, int last );
+    int     character() const { return iCharacter; }
+
+public slots:
+    void    setCharacter( int character );
+
+signals:
+    void characterSelected( int character );
+    void glyphEdited( FontDocument *document, int index, const GlyphBitmap &glyph );
+    void rescanRequested();
+
+private slots:
+    void previousCharacter();
+    void nextCharacter();
+    void updateZoom( int zoom );
+    void removeClosedSizes();
+
+private:
+    FontFamily          family;
+    QList<FamilyPane *> panes;
+    int                 iCharacter;
+    int                 iFirstChar;     // range that can be stepped through
+    int                 iLastChar;
+
+    QLabel      *characterLabel;
+    QSpinBox    *zoomSpin;
+    QHBoxLayout *paneLayout;
+};
+
+#endif  // FAMILYVIEW_H
@@ -0,0 +1,89 @@
+/******************************************************************************
+** fitdialog.cpp
+**
+** Options for fitting glyph widths to their ink.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "fitdialog.h"
+
+// Widest side bearing or space offered, in pixels
+#define MAX_FIT_WIDTH   64
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+FitDialog::FitDialog( QWidget *parent ): QDialog( parent )
+{
+    GlyphFitter::Options defaults;
+
+    leftSpin = new QSpinBox();
+    leftSpin->setRange( 0, MAX_FIT_WIDTH );
+    leftSpin->setValue( defaults.leftBearing );
+
+    rightSpin = new QSpinBox();
+    rightSpin->setRange( 0, MAX_FIT_WIDTH );
+    rightSpin->setValue( defaults.rightBearing );
+
+    spaceSpin = new QSpinBox();
+    spaceSpin->setRange( 0, MAX_FIT_WIDTH );
+    spaceSpin->setSpecialValueText( tr("Unchanged") );
+    spaceSpin->setValue( defaults.spaceWidth );
+
+    QLabel *leftLabel = new QLabel( tr("&Left side bearing:") );
+    leftLabel->setBuddy( leftSpin );
+    QLabel *rightLabel = new QLabel( tr("&Right side bearing:") );
+    rightLabel->setBuddy( rightSpin );
+    QLabel *spaceLabel = new QLabel( tr("&Blank glyph width:") );
+    spaceLabel->setBuddy( spaceSpin );
+
+    QDialogButtonBox *buttons = new QDialogButtonBox( QDialogButtonBox::Ok | QDialogButtonBox::Cancel );
+    connect( buttons, SIGNAL( accepted() ), this, SLOT( accept() ));
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( reject() ));
+
+    QGridLayout *layout = new QGridLayout();
+    layout->addWidget( leftLabel, 0, 0 );
+    layout->addWidget( leftSpin, 0, 1 );
+    layout->addWidget( rightLabel, 1, 0 );
+    layout->addWidget( rightSpin, 1, 1 );
+    layout->addWidget( spaceLabel, 2, 0 );
+    layout->addWidget( spaceSpin, 2, 1 );
+    layout->addWidget( buttons, 3, 0, 1, 2 );
+    setLayout( layout );
+
+    setWindowTitle( tr("Fit Widths to Ink") );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+GlyphFitter::Options FitDialog::options() const
+{
+    GlyphFitter::Options options;
+    options.leftBearing  = leftSpin->value();
+    options.rightBearing = rightSpin->value();
+    options.spaceWidth   = spaceSpin->value();
+    return options;
+}
@@ -0,0 +1,228 @@
+/******************************************************************************
+** fontdocument.cpp
+**
+** The in-memory representation of a bitmap font being edited.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include "fontdocument.h"
+#include "glyphpool.h"
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTORS
+//
+
+FontDocument::FontDocument( QObject *parent ): QObject( parent )
+{
+    usCodePage = 850;
+    iPointSize = 0;
+    iFirstChar = 0;
+    iCellHeight = 0;
+    iBaseLine = 0;
+}
+
+
+FontDocument::FontDocument( int glyphCount, int width, int height, int baseLine, QObject *parent ): QObject( parent )
+{
+    usCodePage = 850;
+    iPointSize = 0;
+    iFirstChar = 0;
+    iCellHeight = height;
+    iBaseLine = baseLine;
+
+    // The glyphs all start out sharing the same blank bitmap
+    glyphs.fill( GlyphBitmap( width, height ), glyphCount );
+    rebuildMetrics();
+}
+
+
+// ---------------------------------------------------------------------------
+// DESTRUCTOR
+//
+
+/* The store is emptied first, so that the purge can drop this font's
+ * glyphs from the pool (unless another document still uses them).
+ */
+FontDocument::~FontDocument()
+{
+    glyphs.clear();
+    GlyphPool::purge();
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* Create a copy of the font.  The copy shares its stored glyphs with this
+ * one until either document is edited, and starts out with the same
+ * metrics, so nothing has to be re-measured.
+ */
+FontDocument *FontDocument::duplicate( QObject *parent ) const
+{
+    FontDocument *copy = new FontDocument( parent );
+    copy->strFamily    = strFamily;
+    copy->strFace      = strFace;
+    copy->usCodePage   = usCodePage;
+    copy->iPointSize   = iPointSize;
+    copy->iFirstChar   = iFirstChar;
+    copy->iCellHeight  = iCellHeight;
+    copy->iBaseLine    = iBaseLine;
+    copy->glyphs       = glyphs;
+    copy->metricsIndex = metricsIndex;
+    copy->kerningTable = kerningTable;
+    return copy;
+}
+
+
+GlyphBitmap FontDocument::glyph( int index ) const
+{
+    if ( index < 0 || index >= glyphs.size() )
+        return GlyphBitmap();
+    return glyphs.at( index );
+}
+
+
+/* Return a glyph without going through the shared decode cache.  Passes
+ * over the whole font use this, so that they don't push out the glyphs
+ * being viewed.  Like glyph(), it may be called from worker threads as long
+ * as the document isn't being changed.
+ */
+GlyphBitmap FontDocument::decodeGlyph( int index ) const
+{
+    return glyphs.decode( index );
+}
+
+
+/* Replace a glyph.  Only that glyph is re-measured; the font-wide metrics
+ * are then updated in O(log n).
+ */
+void FontDocument::setGlyph( int index, const GlyphBitmap &bitmap )
+{
+    if ( index < 0 || index >= glyphs.size() )
+        return;
+    if ( glyphs.at( index ) == bitmap )
+        return;
+
+    glyphs.set( index, bitmap );
+    if ( bitmap.height() > iCellHeight )
+        iCellHeight = bitmap.height();
+
+    int oldExtent    = metricsIndex.maxBaselineExtent();
+    int oldIncrement = metricsIndex.maxIncrement();
+    int oldAverage   = metricsIndex.averageIncrement();
+    metricsIndex.update( index, GlyphMetrics::measure( bitmap, iBaseLine ));
+
+    emit glyphChanged( index );
+    if ( metricsIndex.maxBaselineExtent() != oldExtent ||
+         metricsIndex.maxIncrement() != oldIncrement ||
+         metricsIndex.averageIncrement() != oldAverage )
+        emit metricsChanged();
+}
+
+
+/* Replace all glyphs at once (e.g. after loading or generating a font).
+ * The glyphs are compressed into the store, sharing any identical glyphs
+ * with this and the other open fonts; those they replace are then dropped.
+ */
+void FontDocument::setGlyphs( const QVector<GlyphBitmap> &bitmaps )
+{
+    glyphs.assign( bitmaps );
+    GlyphPool::purge();
+    iCellHeight = 0;
+    for ( int i = 0; i < bitmaps.size(); i++ )
+        iCellHeight = qMax( iCellHeight, bitmaps.at( i ).height() );
+    rebuildMetrics();
+    emit metricsChanged();
+}
+
+
+/* Replace a scattered set of glyphs, e.g. as they arrive from a font which
+ * is still loading.  Like setGlyph(), each one only costs an O(log n)
+ * metrics update, but metricsChanged() is emitted at most once for the
+ * whole batch.
+ */
+void FontDocument::setGlyphBatch( const QList< QPair<int, GlyphBitmap> > &batch )
+{
+    int oldExtent    = metricsIndex.maxBaselineExtent();
+    int oldIncrement = metricsIndex.maxIncrement();
+    int oldAverage   = metricsIndex.averageIncrement();
+
+    for ( int i = 0; i < batch.size(); i++ ) {
+        int index = batch.at( i ).first;
+        if ( index < 0 || index >= glyphs.size() )
+            continue;
+        const GlyphBitmap &bitmap = batch.at( i ).second;
+        glyphs.set( index, bitmap );
+        if ( bitmap.height() > iCellHeight )
+            iCellHeight = bitmap.height();
+        metricsIndex.update( index, GlyphMetrics::measure( bitmap, iBaseLine ));
+        emit glyphChanged( index );
+    }
+
+    if ( metricsIndex.maxBaselineExtent() != oldExtent ||
+         metricsIndex.maxIncrement() != oldIncrement ||
+         metricsIndex.averageIncrement() != oldAverage )
+        emit metricsChanged();
+}
+
+
+/* Add, change or (with an amount of 0) remove a kerning pair.
+ */
+void FontDocument::setKerningPair( quint16 first, quint16 second, int amount )
+{
+    if ( kerningTable.amount( first, second ) == amount )
+        return;
+    kerningTable.setAmount( first, second, amount );
+    emit kerningChanged();
+}
+
+
+void FontDocument::setKerningPairs( const QVector<KerningPair> &pairs )
+{
+    kerningTable.assign( pairs );
+    emit kerningChanged();
+}
+
+
+/* Moving the baseline changes every glyph's ascent and descent, so this is
+ * the one change which requires the whole font to be re-measured.
+ */
+void FontDocument::setBaseLine( int offset )
+{
+    if ( offset == iBaseLine )
+        return;
+    iBaseLine = offset;
+    rebuildMetrics();
+    emit metricsChanged();
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+void FontDocument::rebuildMetrics()
+{
+    QVector<GlyphMetrics> all( glyphs.size() );
+    for ( int i = 0; i < glyphs.size(); i++ )
+        all[ i ] = GlyphMetrics::measure( glyphs.decode( i ), iBaseLine );
+    metricsIndex.reset( all );
+}
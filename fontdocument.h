@@ -0,0 +1,104 @@
+/******************************************************************************
+** fontdocument.h
+**
+** The in-memory representation of a bitmap font being edited.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef FONTDOCUMENT_H
+#define FONTDOCUMENT_H
+
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include "glyphbitmap.h"
+#include "glyphstore.h"
+#include "kerningtable.h"
+#include "metricsindex.h"
+
+
+/* A font is a run of glyphs, all of the same cell height, indexed from
+ * firstChar.  Each glyph's increment is the width of its bitmap.  The
+ * baseline is given as the number of cell rows below it.
+ */
+class FontDocument : public QObject
+{
+    Q_OBJECT
+
+public:
+    FontDocument( QObject *parent = 0 );
+    FontDocument( int glyphCount, int width, int height, int baseLine, QObject *parent = 0 );
+    ~FontDocument();
+
+    FontDocument *duplicate( QObject *parent = 0 ) const;
+
+    QString familyName() const { return strFamily; }
+    void    setFamilyName( const QString &name ) { strFamily = name; }
+    QString faceName() const { return strFace; }
+    void    setFaceName( const QString &name ) { strFace = name; }
+
+    quint16 codePage() const { return usCodePage; }
+    void    setCodePage( quint16 codePage ) { usCodePage = codePage; }
+    int     pointSize() const { return iPointSize; }
+    void    setPointSize( int size ) { iPointSize = size; }
+    int     firstChar() const { return iFirstChar; }
+    void    setFirstChar( int first ) { iFirstChar = first; }
+
+    int     cellHeight() const { return iCellHeight; }
+    int     baseLine() const { return iBaseLine; }
+    void    setBaseLine( int offset );
+
+    int         glyphCount() const { return glyphs.size(); }
+    GlyphBitmap glyph( int index ) const;
+    GlyphBitmap decodeGlyph( int index ) const;
+    void        setGlyph( int index, const GlyphBitmap &bitmap );
+    void        setGlyphs( const QVector<GlyphBitmap> &bitmaps );
+    void        setGlyphBatch( const QList< QPair<int, GlyphBitmap> > &batch );
+
+    const FontMetricsIndex &metrics() const { return metricsIndex; }
+
+    const KerningTable &kerning() const { return kerningTable; }
+    void    setKerningPair( quint16 first, quint16 second, int amount );
+    void    setKerningPairs( const QVector<KerningPair> &pairs );
+
+signals:
+    void glyphChanged( int index );
+    void metricsChanged();
+    void kerningChanged();
+
+private:
+    void    rebuildMetrics();
+
+    QString strFamily;
+    QString strFace;
+    quint16 usCodePage;
+    int     iPointSize;
+    int     iFirstChar;
+    int     iCellHeight;
+    int     iBaseLine;
+
+    GlyphStore          glyphs;
+    FontMetricsIndex    metricsIndex;
+    KerningTable        kerningTable;
+};
+
+#endif  // FONTDOCUMENT_H
@@ -0,0 +1,121 @@
+/******************************************************************************
+** fontfamily.cpp
+**
+** The sizes of one font family, with the character data they share.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtAlgorithms>
+
+#include "fontfamily.h"
+#include "glyphnames.h"
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static bool sizeLessThan( const FontDocument *a, const FontDocument *b )
+{
+    if ( a->pointSize() != b->pointSize() )
+        return a->pointSize() < b->pointSize();
+    return a->cellHeight() < b->cellHeight();
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+FontFamily::FontFamily()
+{
+    usCodePage = 0;
+    iFirstChar = 0;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* Take the given documents, which should all be of one family (see
+ * isSameFamily()), as the family's sizes.
+ */
+void FontFamily::setSizes( const QList<FontDocument *> &documents )
+{
+    QList<FontDocument *> sorted = documents;
+    qStableSort( sorted.begin(), sorted.end(), sizeLessThan );
+
+    sizes.clear();
+    codePoints.clear();
+    names.clear();
+    if ( sorted.isEmpty() )
+        return;
+
+    familyName = sorted.first()->familyName();
+    usCodePage = sorted.first()->codePage();
+    int first = sorted.first()->firstChar();
+    int last  = first - 1;
+    for ( int i = 0; i < sorted.size(); i++ ) {
+        sizes.append( sorted.at( i ));
+        first = qMin( first, sorted.at( i )->firstChar() );
+        last  = qMax( last, sorted.at( i )->firstChar() + sorted.at( i )->glyphCount() - 1 );
+    }
+
+    iFirstChar = first;
+    codePoints.resize( qMax( last - first + 1, 0 ));
+    for ( int i = 0; i < codePoints.size(); i++ ) {
+        codePoints[ i ] = GlyphNames::codePoint( usCodePage, first + i );
+        names.append( GlyphNames::name( codePoints.at( i )));
+    }
+}
+
+
+bool FontFamily::isSameFamily( const FontDocument *a, const FontDocument *b )
+{
+    return a->codePage() == b->codePage() &&
+           a->familyName().compare( b->familyName(), Qt::CaseInsensitive ) == 0;
+}
+
+
+/* The glyph for a character in size i, or -1 if that size lacks it or has
+ * been closed.
+ */
+int FontFamily::glyphIndex( int i, int character ) const
+{
+    const FontDocument *document = sizes.at( i );
+    if ( !document )
+        return -1;
+    int index = character - document->firstChar();
+    return ( index >= 0 && index < document->glyphCount() )? index: -1;
+}
+
+
+uint FontFamily::codePoint( int character ) const
+{
+    int i = character - iFirstChar;
+    return ( i >= 0 && i < codePoints.size() )? codePoints.at( i ): NO_CODE_POINT;
+}
+
+
+QString FontFamily::glyphName( int character ) const
+{
+    int i = character - iFirstChar;
+    return ( i >= 0 && i < names.size() )? names.at( i ): QString();
+}
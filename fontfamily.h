@@ -0,0 +1,72 @@
+/******************************************************************************
+** fontfamily.h
+**
+** The sizes of one font family, with the character data they share.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef FONTFAMILY_H
+#define FONTFAMILY_H
+
+#include <QList>
+#include <QPointer>
+#include <QStringList>
+#include <QVector>
+
+#include "fontdocument.h"
+
+
+/* A family is the fonts of one name and code page, in different sizes,
+ * ordered by point size.  What depends only on the name and code page --
+ * the Unicode value and glyph name of each character -- is worked out once
+ * for the whole family over the range of characters any size covers; each
+ * size then only needs its first character to find its glyph for one.
+ * The documents themselves belong to their editor windows, and drop out of
+ * the family if they are closed.
+ */
+class FontFamily
+{
+public:
+    FontFamily();
+
+    void    setSizes( const QList<FontDocument *> &documents );
+    static bool isSameFamily( const FontDocument *a, const FontDocument *b );
+
+    int           count() const { return sizes.size(); }
+    FontDocument *size( int i ) const { return sizes.at( i ); }
+    QString       name() const { return familyName; }
+    quint16       codePage() const { return usCodePage; }
+
+    int     firstChar() const { return iFirstChar; }
+    int     lastChar() const { return iFirstChar + codePoints.size() - 1; }
+    int     glyphIndex( int i, int character ) const;
+    uint    codePoint( int character ) const;
+    QString glyphName( int character ) const;
+
+private:
+    QList< QPointer<FontDocument> > sizes;
+    QString     familyName;
+    quint16     usCodePage;
+    int         iFirstChar;
+
+    QVector<uint> codePoints;       // of each character from firstChar
+    QStringList   names;            // of each character from firstChar
+};
+
+#endif  // FONTFAMILY_H
@@ -0,0 +1,76 @@
+/******************************************************************************
+** fontfile.cpp
+**
+** Common interface for reading bitmap font files.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QCoreApplication>
+
+#include "fontfile.h"
+#include "fontmodule.h"
+#include "os2fontfile.h"
+#include "winfontfile.h"
+
+// How many modules deep a font may be found.  No real module has another
+// module as a font resource; the limit stops a damaged one whose resource
+// is the module itself from recursing without end.
+#define MAX_MODULE_DEPTH        1
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static FontFileReader *createReader( const uchar *data, qint64 size, int resource, QString *errorString, int depth )
+{
+    QString error;
+    if ( FontModule::recognize( data, size )) {
+        if ( depth >= MAX_MODULE_DEPTH )
+            error = QCoreApplication::translate("FontFileReader", "The font resource is itself a module.");
+        else {
+            QList<FontModule::Resource> fonts = FontModule::fontResources( data, size, &error );
+            if ( !fonts.isEmpty() ) {
+                const FontModule::Resource &font = fonts.at( qBound( 0, resource, fonts.size() - 1 ));
+                return createReader( data + font.offset, font.size, 0, errorString, depth + 1 );
+            }
+        }
+    }
+    else if ( OS2FontFile::recognize( data, size ))
+        return new OS2FontFile( data, size );
+    else if ( WinFontFile::recognize( data, size ))
+        return new WinFontFile( data, size );
+    else
+        error = QCoreApplication::translate("FontFileReader", "The file is not in a recognized font format.");
+
+    if ( errorString )
+        *errorString = error;
+    return 0;
+}
+
+
+// ---------------------------------------------------------------------------
+// Create a reader for the font format found in the data, or return 0 if the
+// format is not recognized.  If the data is an executable module, the reader
+// is for the given font resource within it, read in place.
+//
+FontFileReader *FontFileReader::create( const uchar *data, qint64 size, int resource, QString *errorString )
+{
+    return createReader( data, size, resource, errorString, 0 );
+}
@@ -0,0 +1,84 @@
+/******************************************************************************
+** fontfile.h
+**
+** Common interface for reading bitmap font files.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef FONTFILE_H
+#define FONTFILE_H
+
+#include <QString>
+#include <QVector>
+
+#include "glyphbitmap.h"
+#include "kerningtable.h"
+
+
+/* What is known about a font once its header has been read.  The baseline
+ * is given as the number of cell rows below it, as in FontDocument.  An
+ * imported font is one in a format that we can read but don't save in.
+ */
+struct FontFileInfo
+{
+    FontFileInfo(): codePage( 850 ), pointSize( 0 ), firstChar( 0 ),
+                    glyphCount( 0 ), cellHeight( 0 ), baseLine( 0 ), imported( false ) {}
+
+    QString familyName;
+    QString faceName;
+    quint16 codePage;
+    int     pointSize;
+    int     firstChar;
+    int     glyphCount;
+    int     cellHeight;
+    int     baseLine;
+    bool    imported;
+
+    QVector<KerningPair> kerningPairs;
+};
+
+
+/* A reader works directly on the file data, which must stay valid (and
+ * unchanged) for as long as the reader is used.  parse() reads the header
+ * and glyph table only; each glyph is then decoded on demand by glyph(),
+ * which only reads the data and so may be called from any thread.
+ */
+class FontFileReader
+{
+public:
+    FontFileReader( const uchar *data, qint64 size ): pData( data ), llSize( size ) {}
+    virtual ~FontFileReader() {}
+
+    virtual bool        parse() = 0;
+    virtual int         glyphWidth( int index ) const = 0;
+    virtual GlyphBitmap glyph( int index ) const = 0;
+
+    const FontFileInfo &info() const { return fontInfo; }
+    QString             errorString() const { return strError; }
+
+    static FontFileReader *create( const uchar *data, qint64 size, int resource = 0, QString *errorString = 0 );
+
+protected:
+    const uchar  *pData;
+    qint64        llSize;
+    FontFileInfo  fontInfo;
+    QString       strError;
+};
+
+#endif  // FONTFILE_H
@@ -0,0 +1,318 @@
+/******************************************************************************
+** fontheader.cpp
+**
+** Exporting a font as C/C++ source tables.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QHash>
+#include <QPair>
+#include <QTextStream>
+#include <QVector>
+
+#include "fontdocument.h"
+#include "fontheader.h"
+#include "glyphnames.h"
+
+#define VALUES_PER_LINE         12
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* Collects pixels into bytes, taking them 32 at a time, leftmost (i.e.
+ * first) pixel in the most significant bit.
+ */
+class BitStream
+{
+public:
+    BitStream( bool lsbFirst ): bLsbFirst( lsbFirst ), acc( 0 ), iBits( 0 ) {}
+
+    void put( quint32 pixels, int count )
+    {
+        if ( count < 32 )
+            pixels >>= 32 - count;
+        acc = ( acc << count ) | pixels;
+        iBits += count;
+        while ( iBits >= 8 ) {
+            iBits -= 8;
+            emitByte( (uchar)( acc >> iBits ));
+        }
+    }
+
+    // Pad the last byte with blank pixels
+    QByteArray finish()
+    {
+        if ( iBits )
+            put( 0, 8 - iBits );
+        return bytes;
+    }
+
+private:
+    void emitByte( uchar value )
+    {
+        if ( bLsbFirst )
+            value = (uchar)( qbfReverseBits( value ) >> 24 );
+        bytes.append( (char) value );
+    }
+
+    bool       bLsbFirst;
+    quint64    acc;
+    int        iBits;
+    QByteArray bytes;
+};
+
+
+/* The rows [top, top + rows) of a glyph as a bit stream.  Rows are copied
+ * a word at a time from the glyph's packed scan lines; columns are
+ * gathered 32 rows at a time.
+ */
+static QByteArray glyphBits( const GlyphBitmap &glyph, int top, int rows, const FontHeader::Options &options )
+{
+    BitStream stream( options.lsbFirst );
+    int width = glyph.width();
+
+    if ( !options.columnMajor ) {
+        for ( int y = top; y < top + rows; y++ ) {
+            const quint32 *line = glyph.constScanLine( y );
+            for ( int x = 0; x < width; x += 32 )
+                stream.put( line[ x >> 5 ], qMin( 32, width - x ));
+        }
+    }
+    else {
+        for ( int x = 0; x < width; x++ ) {
+            quint32 mask = qbfPixelBit( x );
+            for ( int y = top; y < top + rows; y += 32 ) {
+                int     count  = qMin( 32, top + rows - y );
+                quint32 column = 0;
+                for ( int i = 0; i < count; i++ )
+                    if ( glyph.constScanLine( y + i )[ x >> 5 ] & mask )
+                        column |= 0x80000000u >> i;
+                stream.put( column, count );
+            }
+        }
+    }
+    return stream.finish();
+}
+
+
+// The smallest unsigned C type which holds every value up to max
+static const char *cType( quint32 max )
+{
+    if ( max <= 0xFF )
+        return "uint8_t";
+    if ( max <= 0xFFFF )
+        return "uint16_t";
+    return "uint32_t";
+}
+
+
+static void writeArray( QTextStream &out, const QString &storage, const QString &name,
+                        const QVector<quint32> &values, bool hex )
+{
+    quint32 max = 0;
+    for ( int i = 0; i < values.size(); i++ )
+        max = qMax( max, values.at( i ));
+
+    out << storage << " " << cType( max ) << " " << name << "[ " << values.size() << " ] = {";
+    for ( int i = 0; i < values.size(); i++ ) {
+        if ( i % VALUES_PER_LINE == 0 )
+            out << "\n   ";
+        if ( hex )
+            out << " 0x" << QString::number( values.at( i ), 16 ).toUpper().rightJustified( 2, '0' );
+        else
+            out << " " << values.at( i );
+        if ( i + 1 < values.size() )
+            out << ",";
+    }
+    out << "\n};\n\n";
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC FUNCTIONS
+//
+
+/* A C identifier made from the family name and point size.
+ */
+QString FontHeader::defaultName( const FontDocument *document )
+{
+    QString name = QString("%1_%2").arg( document->familyName() ).arg( document->pointSize() ).toLower();
+    for ( int i = 0; i < name.size(); i++ )
+        if ( !( name.at( i ).isLetterOrNumber() && name.at( i ).unicode() < 0x80 ))
+            name[ i ] = '_';
+    if ( name.at( 0 ).isDigit() )
+        name.prepend("font_");
+    return name;
+}
+
+
+QByteArray FontHeader::generate( const FontDocument *document, const Options &options )
+{
+    const QString &name = options.name;
+    QString upper = name.toUpper();
+    int count  = document->glyphCount();
+    int height = document->cellHeight();
+
+    // Glyphs are looked up by Unicode code point where the code page allows,
+    // otherwise by character value
+    QVector< QPair<quint32, int> > codes;
+    for ( int i = 0; i < count; i++ ) {
+        uint codePoint = GlyphNames::codePoint( document->codePage(), document->firstChar() + i );
+        if ( codePoint != NO_CODE_POINT )
+            codes.append( qMakePair( (quint32) codePoint, i ));
+    }
+    bool byCharacter = codes.isEmpty();
+    if ( byCharacter )
+        for ( int i = 0; i < count; i++ )
+            codes.append( qMakePair( (quint32)( document->firstChar() + i ), i ));
+    qSort( codes );
+
+    // Trim and encode each glyph, storing identical bitmaps once
+    QVector<quint32> offsets( count ), widths( count ), tops( count ), rows( count );
+    QVector<quint32> bitmaps;
+    QHash<QByteArray, quint32> stored;
+    for ( int i = 0; i < count; i++ ) {
+        GlyphBitmap glyph = document->decodeGlyph( i );
+        QRect ink = glyph.inkBounds();
+        widths[ i ] = glyph.width();
+        if ( ink.isEmpty() )
+            continue;
+        tops[ i ] = ink.top();
+        rows[ i ] = ink.height();
+
+        // The key includes the shape, since the streams alone may be ambiguous
+        QByteArray bits = glyphBits( glyph, ink.top(), ink.height(), options );
+        QByteArray key  = QByteArray::number( glyph.width() ) + 'x' + QByteArray::number( ink.height() ) + ':' + bits;
+        QHash<QByteArray, quint32>::const_iterator found = stored.constFind( key );
+        if ( found != stored.constEnd() ) {
+            offsets[ i ] = found.value();
+            continue;
+        }
+        offsets[ i ] = bitmaps.size();
+        stored.insert( key, bitmaps.size() );
+        for ( int b = 0; b < bits.size(); b++ )
+            bitmaps.append( (uchar) bits.at( b ));
+    }
+
+    // Runs of code points which map to consecutive glyphs go in the range
+    // table; the rest are listed singly
+    QVector<quint32> ranges, singles, singleGlyphs;
+    quint32 rangeMax = 0;
+    for ( int i = 0; i < codes.size(); ) {
+        int run = 1;
+        while ( i + run < codes.size() &&
+                codes.at( i + run ).first == codes.at( i ).first + run &&
+                codes.at( i + run ).second == codes.at( i ).second + run )
+            run++;
+        if ( run > 1 ) {
+            ranges << codes.at( i ).first << run << codes.at( i ).second;
+            rangeMax = qMax( rangeMax, qMax( codes.at( i ).first, (quint32) qMax( run, codes.at( i ).second )));
+        }
+        else {
+            singles << codes.at( i ).first;
+            singleGlyphs << codes.at( i ).second;
+        }
+        i += run;
+    }
+
+    QString text;
+    QTextStream out( &text );
+    QString storage = upper + "_TABLE";
+
+    out << "/* " << name << ".h\n"
+        << " *\n"
+        << " * " << document->faceName() << ", " << document->pointSize() << " pt: "
+        << count << " glyphs, " << height << " pixels high.  Generated by QBFont.\n"
+        << " *\n"
+        << " * Glyph i is " << name << "_widths[i] pixels wide.  Only rows " << name << "_tops[i] to\n"
+        << " * " << name << "_tops[i] + " << name << "_rows[i] - 1 of its cell are stored; the\n"
+        << " * others are blank.  They are stored from " << name << "_bitmaps[" << name << "_offsets[i]]\n"
+        << " * as a stream of bits, " << ( options.columnMajor? "column by column, each from the top":
+                                                                 "row by row, each from the left" ) << ",\n"
+        << " * " << ( options.lsbFirst? "least": "most" ) << " significant bit first, padded to a whole byte.\n"
+        << " *\n"
+        << " * " << name << "_glyph() returns the glyph for a "
+        << ( byCharacter? "character value": "Unicode code point" ) << ", or -1.\n"
+        << " */\n\n"
+        << "#ifndef " << upper << "_H\n"
+        << "#define " << upper << "_H\n\n"
+        << "#include <stdint.h>\n\n"
+        << "#if defined( __cplusplus ) && __cplusplus >= 201103L\n"
+        << "#define " << storage << " static constexpr\n"
+        << "#else\n"
+        << "#define " << storage << " static const\n"
+        << "#endif\n\n"
+        << "#define " << upper << "_GLYPHS " << count << "\n"
+        << "#define " << upper << "_HEIGHT " << height << "\n"
+        << "#define " << upper << "_ASCENT " << ( height - document->baseLine() ) << "\n\n";
+
+    if ( bitmaps.isEmpty() )
+        bitmaps.append( 0 );
+    writeArray( out, storage, name + "_bitmaps", bitmaps, true );
+    writeArray( out, storage, name + "_offsets", offsets, false );
+    writeArray( out, storage, name + "_widths", widths, false );
+    writeArray( out, storage, name + "_tops", tops, false );
+    writeArray( out, storage, name + "_rows", rows, false );
+
+    int rangeCount = ranges.size() / 3;
+    if ( rangeCount ) {
+        out << "/* First code, number of codes, first glyph */\n"
+            << storage << " " << cType( rangeMax ) << " " << name << "_ranges[ " << rangeCount << " ][ 3 ] = {\n";
+        for ( int i = 0; i < rangeCount; i++ )
+            out << "    { " << ranges.at( 3 * i ) << ", " << ranges.at( 3 * i + 1 ) << ", " << ranges.at( 3 * i + 2 )
+                << (( i + 1 < rangeCount )? " },\n": " }\n");
+        out << "};\n\n";
+    }
+    if ( !singles.isEmpty() ) {
+        writeArray( out, storage, name + "_codes", singles, false );
+        writeArray( out, storage, name + "_code_glyphs", singleGlyphs, false );
+    }
+
+    out << "static inline int " << name << "_glyph( uint32_t code )\n"
+        << "{\n"
+        << "    int lo, hi, mid;\n";
+    if ( rangeCount )
+        out << "    for ( lo = 0, hi = " << rangeCount - 1 << "; lo <= hi; ) {\n"
+            << "        mid = ( lo + hi ) / 2;\n"
+            << "        if ( code < " << name << "_ranges[ mid ][ 0 ] )\n"
+            << "            hi = mid - 1;\n"
+            << "        else if ( code - " << name << "_ranges[ mid ][ 0 ] >= " << name << "_ranges[ mid ][ 1 ] )\n"
+            << "            lo = mid + 1;\n"
+            << "        else\n"
+            << "            return (int)( " << name << "_ranges[ mid ][ 2 ] + ( code - " << name << "_ranges[ mid ][ 0 ] ));\n"
+            << "    }\n";
+    if ( !singles.isEmpty() )
+        out << "    for ( lo = 0, hi = " << singles.size() - 1 << "; lo <= hi; ) {\n"
+            << "        mid = ( lo + hi ) / 2;\n"
+            << "        if ( code < " << name << "_codes[ mid ] )\n"
+            << "            hi = mid - 1;\n"
+            << "        else if ( code > " << name << "_codes[ mid ] )\n"
+            << "            lo = mid + 1;\n"
+            << "        else\n"
+            << "            return " << name << "_code_glyphs[ mid ];\n"
+            << "    }\n";
+    out << "    (void) lo; (void) hi; (void) mid;\n"
+        << "    return -1;\n"
+        << "}\n\n"
+        << "#endif  /* " << upper << "_H */\n";
+    out.flush();
+    return text.toLatin1();
+}
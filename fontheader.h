@@ -0,0 +1,54 @@
+/******************************************************************************
+** fontheader.h
+**
+** Exporting a font as C/C++ source tables.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef FONTHEADER_H
+#define FONTHEADER_H
+
+#include <QByteArray>
+#include <QString>
+
+class FontDocument;
+
+
+/* Generates a self-contained C/C++ header for small (e.g. microcontroller)
+ * targets.  Each glyph is trimmed to the rows which contain ink and stored
+ * as a bit stream, in rows or columns and with either bit order; identical
+ * trimmed bitmaps are stored once.  Glyphs are looked up by code point
+ * through a table of ranges of consecutive glyphs, then a sorted list of
+ * the remaining code points.  The tables are constexpr in C++11 and plain
+ * const arrays otherwise, so they can be placed in flash.
+ */
+namespace FontHeader {
+    struct Options {
+        Options(): columnMajor( false ), lsbFirst( false ) {}
+
+        QString name;           // C identifier prefix
+        bool    columnMajor;    // store columns left to right, not rows
+        bool    lsbFirst;       // first pixel in the least significant bit
+    };
+
+    QString     defaultName( const FontDocument *document );
+    QByteArray  generate( const FontDocument *document, const Options &options );
+};
+
+#endif  // FONTHEADER_H
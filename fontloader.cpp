@@ -0,0 +1,228 @@
+/******************************************************************************
+** fontloader.cpp
+**
+** Loading of font files on a worker thread.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QHash>
+#include <QMutexLocker>
+#include <QTime>
+
+#include "fontdocument.h"
+#include "fontfile.h"
+#include "fontloader.h"
+
+// How often decoded glyphs are handed over to the GUI thread (ms)
+#define BATCH_INTERVAL      20
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+FontLoader::FontLoader( const QString &fileName, int resource, QObject *parent ): QThread( parent )
+{
+    strFileName = fileName;
+    iResource = resource;
+    reader = 0;
+    bCancelled = false;
+}
+
+
+// ---------------------------------------------------------------------------
+// DESTRUCTOR
+//
+
+FontLoader::~FontLoader()
+{
+    cancel();
+    wait();
+    delete reader;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+QString FontLoader::errorString() const
+{
+    QMutexLocker lock( &mutex );
+    return strError;
+}
+
+
+bool FontLoader::isCancelled() const
+{
+    QMutexLocker lock( &mutex );
+    return bCancelled;
+}
+
+
+/* Whether the font came from a module, or from a file format that we don't
+ * save in; either way, saving it must not overwrite the original file.
+ * Only meaningful once the header has been loaded.
+ */
+bool FontLoader::isImported() const
+{
+    return ( iResource >= 0 ) || ( reader && reader->info().imported );
+}
+
+
+/* Create a document for the font, with blank glyphs of the right widths.
+ * This may only be called once headerLoaded() has been emitted; the glyph
+ * table does not change after that, so it is safe to read here.
+ */
+FontDocument *FontLoader::createDocument( QObject *parent ) const
+{
+    if ( !reader )
+        return 0;
+
+    const FontFileInfo &info = reader->info();
+    FontDocument *document = new FontDocument( parent );
+    document->setFamilyName( info.familyName );
+    document->setFaceName( info.faceName );
+    document->setCodePage( info.codePage );
+    document->setPointSize( info.pointSize );
+    document->setFirstChar( info.firstChar );
+    document->setBaseLine( info.baseLine );
+    document->setKerningPairs( info.kerningPairs );
+
+    // Glyphs of the same width share one blank bitmap until they arrive
+    QHash<int, GlyphBitmap> blanks;
+    QVector<GlyphBitmap> glyphs( info.glyphCount );
+    for ( int i = 0; i < info.glyphCount; i++ ) {
+        int width = reader->glyphWidth( i );
+        if ( !blanks.contains( width ))
+            blanks.insert( width, GlyphBitmap( width, info.cellHeight ));
+        glyphs[ i ] = blanks.value( width );
+    }
+    document->setGlyphs( glyphs );
+    return document;
+}
+
+
+QList< QPair<int, GlyphBitmap> > FontLoader::takeGlyphs()
+{
+    QMutexLocker lock( &mutex );
+    QList< QPair<int, GlyphBitmap> > batch = pending;
+    pending.clear();
+    return batch;
+}
+
+
+/* Ask for the given glyphs to be loaded next, in the order given.  This
+ * replaces any earlier request, since only the latest view matters.
+ */
+void FontLoader::prioritize( const QList<int> &indices )
+{
+    QMutexLocker lock( &mutex );
+    priority = indices;
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void FontLoader::cancel()
+{
+    QMutexLocker lock( &mutex );
+    bCancelled = true;
+}
+
+
+// ---------------------------------------------------------------------------
+// PROTECTED METHODS
+//
+
+void FontLoader::run()
+{
+    file.setFileName( strFileName );
+    if ( !file.open( QIODevice::ReadOnly )) {
+        QMutexLocker lock( &mutex );
+        strError = file.errorString();
+        return;
+    }
+
+    // Map the file if possible, so that only the pages we use are read in
+    qint64       size = file.size();
+    const uchar *data = file.map( 0, size );
+    if ( !data ) {
+        buffer = file.readAll();
+        data = (const uchar *) buffer.constData();
+        size = buffer.size();
+    }
+
+    QString error;
+    reader = FontFileReader::create( data, size, iResource, &error );
+    if ( !reader || !reader->parse() ) {
+        QMutexLocker lock( &mutex );
+        strError = reader? reader->errorString(): error;
+        return;
+    }
+    emit headerLoaded();
+
+    int count  = reader->info().glyphCount;
+    int loaded = 0;
+    int next   = 0;
+    QVector<bool> done( count, false );
+    QTime batchTime;
+    batchTime.start();
+
+    while ( loaded < count && !isCancelled() ) {
+        int index = nextGlyph( done, next );
+        GlyphBitmap bitmap = reader->glyph( index );
+        done[ index ] = true;
+        loaded++;
+        {
+            QMutexLocker lock( &mutex );
+            pending.append( qMakePair( index, bitmap ));
+        }
+        if ( batchTime.elapsed() >= BATCH_INTERVAL || loaded == count ) {
+            emit glyphsLoaded();
+            emit progress( loaded, count );
+            batchTime.restart();
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+/* Pick the next glyph to decode: the first requested one not yet done, or
+ * else the next one in order.
+ */
+int FontLoader::nextGlyph( const QVector<bool> &done, int &next )
+{
+    {
+        QMutexLocker lock( &mutex );
+        while ( !priority.isEmpty() ) {
+            int index = priority.takeFirst();
+            if ( index >= 0 && index < done.size() && !done.at( index ))
+                return index;
+        }
+    }
+    while ( done.at( next ))
+        next++;
+    return next;
+}
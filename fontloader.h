@@ -0,0 +1,94 @@
+/******************************************************************************
+** fontloader.h
+**
+** Loading of font files on a worker thread.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef FONTLOADER_H
+#define FONTLOADER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QThread>
+
+#include "glyphbitmap.h"
+
+class FontDocument;
+class FontFileReader;
+
+
+/* Reads a font file on its own thread.  headerLoaded() is emitted as soon
+ * as the header and glyph table have been read, at which point
+ * createDocument() gives a document with every glyph present but blank.
+ * The glyphs are then decoded one at a time, those named by prioritize()
+ * first and the rest in order, and handed over in batches: on each
+ * glyphsLoaded(), takeGlyphs() returns everything decoded since the last
+ * call.  The loader never touches the document itself, so the document is
+ * only ever changed on the GUI thread.
+ */
+class FontLoader : public QThread
+{
+    Q_OBJECT
+
+public:
+    FontLoader( const QString &fileName, int resource, QObject *parent = 0 );
+    ~FontLoader();
+
+    QString fileName() const { return strFileName; }
+    int     resource() const { return iResource; }
+    bool    isImported() const;
+    QString errorString() const;
+    bool    isCancelled() const;
+
+    FontDocument *createDocument( QObject *parent = 0 ) const;
+    QList< QPair<int, GlyphBitmap> > takeGlyphs();
+    void    prioritize( const QList<int> &indices );
+
+public slots:
+    void cancel();
+
+signals:
+    void headerLoaded();
+    void glyphsLoaded();
+    void progress( int loaded, int total );
+
+protected:
+    void run();
+
+private:
+    int  nextGlyph( const QVector<bool> &done, int &next );
+
+    QString         strFileName;
+    int             iResource;      // font resource in a module, or -1
+    QString         strError;
+    QFile           file;           // only used by the worker thread
+    QByteArray      buffer;         // the file contents, if it can't be mapped
+    FontFileReader *reader;
+
+    mutable QMutex  mutex;          // guards the members below
+    QList<int>      priority;
+    QList< QPair<int, GlyphBitmap> > pending;
+    bool            bCancelled;
+};
+
+#endif  // FONTLOADER_H
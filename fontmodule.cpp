@@ -0,0 +1,294 @@
+/******************************************************************************
+** fontmodule.cpp
+**
+** Locating font resources in OS/2 and Windows executable modules.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QCoreApplication>
+#include <QtEndian>
+
+#include "fontmodule.h"
+
+// Font resource types
+#define OS2_RT_FONT             7
+#define WIN_RT_FONT             0x8008
+
+// Offset of the new-style header's offset in the DOS (MZ) stub
+#define MZ_NEW_HEADER           0x3C
+
+// Largest page or segment alignment shift taken as valid
+#define MAX_ALIGN_SHIFT         16
+
+// LX header fields
+#define LX_PAGE_SIZE            0x28
+#define LX_PAGE_SHIFT           0x2C
+#define LX_OBJECT_TABLE         0x40
+#define LX_OBJECT_COUNT         0x44
+#define LX_PAGE_TABLE           0x48
+#define LX_RESOURCE_TABLE       0x50
+#define LX_RESOURCE_COUNT       0x54
+#define LX_DATA_PAGES           0x80
+#define LX_HEADER_SIZE          0xC4
+
+#define LX_OBJECT_SIZE          24
+#define LX_PAGE_ENTRY_SIZE      8
+#define LX_RESOURCE_SIZE        14
+#define LX_PAGE_VALID           0x0000
+
+// NE header fields
+#define NE_SEGMENT_COUNT        0x1C
+#define NE_SEGMENT_TABLE        0x22
+#define NE_RESOURCE_TABLE       0x24
+#define NE_ALIGN_SHIFT          0x32
+#define NE_RESOURCE_SEGMENTS    0x34
+#define NE_TARGET_OS            0x36
+#define NE_HEADER_SIZE          0x40
+
+#define NE_SEGMENT_SIZE         8
+#define NE_SEGMENT_ITERATED     0x0008
+#define NE_TARGET_WINDOWS       2
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static inline quint16 readWord( const uchar *p )  { return qFromLittleEndian<quint16>( p ); }
+static inline quint32 readLong( const uchar *p )  { return qFromLittleEndian<quint32>( p ); }
+
+/* Find the LX or NE header, after the DOS stub if there is one.  Returns -1
+ * if there is no such header.
+ */
+static qint64 newHeader( const uchar *data, qint64 size )
+{
+    qint64 offset = 0;
+    if ( size >= MZ_NEW_HEADER + 4 && data[ 0 ] == 'M' && data[ 1 ] == 'Z' )
+        offset = readLong( data + MZ_NEW_HEADER );
+    if ( offset + 2 > size )
+        return -1;
+    if (( data[ offset ] == 'L' && data[ offset + 1 ] == 'X' ) ||
+        ( data[ offset ] == 'N' && data[ offset + 1 ] == 'E' ))
+        return offset;
+    return -1;
+}
+
+
+/* 32-bit OS/2 modules keep resources in objects, which are made up of
+ * pages.  A resource can be used in place only if every page it touches is
+ * stored uncompressed and the pages follow each other in the file.
+ */
+static QList<FontModule::Resource> lxFonts( const uchar *data, qint64 size, qint64 lx, QString *error )
+{
+    QList<FontModule::Resource> fonts;
+    if ( lx + LX_HEADER_SIZE > size ) {
+        *error = QCoreApplication::translate("FontModule", "The module header is damaged.");
+        return fonts;
+    }
+
+    const uchar *h         = data + lx;
+    qint64       pageSize  = readLong( h + LX_PAGE_SIZE );
+    quint32      pageShift = readLong( h + LX_PAGE_SHIFT );
+    qint64       objects   = lx + readLong( h + LX_OBJECT_TABLE );
+    quint32      objCount  = readLong( h + LX_OBJECT_COUNT );
+    qint64       pages     = lx + readLong( h + LX_PAGE_TABLE );
+    qint64       resources = lx + readLong( h + LX_RESOURCE_TABLE );
+    quint32      resCount  = readLong( h + LX_RESOURCE_COUNT );
+    qint64       dataPages = readLong( h + LX_DATA_PAGES );
+
+    if ( pageSize <= 0 || pageShift > MAX_ALIGN_SHIFT || resources + (qint64) resCount * LX_RESOURCE_SIZE > size ) {
+        *error = QCoreApplication::translate("FontModule", "The module header is damaged.");
+        return fonts;
+    }
+
+    int skipped = 0;
+    for ( quint32 i = 0; i < resCount; i++ ) {
+        const uchar *r = data + resources + i * LX_RESOURCE_SIZE;
+        if ( readWord( r ) != OS2_RT_FONT )
+            continue;
+
+        quint16 id     = readWord( r + 2 );
+        qint64  length = readLong( r + 4 );
+        quint16 object = readWord( r + 8 );
+        qint64  start  = readLong( r + 10 );
+        if ( object < 1 || object > objCount || length < 1 ||
+             objects + (qint64) object * LX_OBJECT_SIZE > size ) {
+            skipped++;
+            continue;
+        }
+
+        // Pages are numbered from 1 in the object table; the rest count from 0
+        const uchar *o         = data + objects + ( object - 1 ) * LX_OBJECT_SIZE;
+        qint64       pageBase  = (qint64) readLong( o + 12 ) - 1;
+        qint64       pageCount = readLong( o + 16 );
+        qint64       firstPage = start / pageSize;
+        qint64       lastPage  = ( start + length - 1 ) / pageSize;
+
+        bool   usable = ( pageBase >= 0 && lastPage < pageCount &&
+                          pages + ( pageBase + lastPage + 1 ) * LX_PAGE_ENTRY_SIZE <= size );
+        qint64 first  = 0;
+        for ( qint64 p = firstPage; usable && p <= lastPage; p++ ) {
+            const uchar *e      = data + pages + ( pageBase + p ) * LX_PAGE_ENTRY_SIZE;
+            qint64       at     = dataPages + ((qint64) readLong( e ) << pageShift );
+            qint64       stored = readWord( e + 4 );
+            qint64       needed = ( p < lastPage )? pageSize: ( start + length - 1 ) % pageSize + 1;
+
+            if ( p == firstPage )
+                first = at;
+            usable = ( readWord( e + 6 ) == LX_PAGE_VALID ) &&
+                     ( stored >= needed ) &&
+                     ( at == first + ( p - firstPage ) * pageSize );
+        }
+        qint64 offset = first + start % pageSize;
+
+        if ( usable && offset + length <= size ) {
+            FontModule::Resource font = { id, offset, length };
+            fonts.append( font );
+        }
+        else
+            skipped++;
+    }
+
+    if ( fonts.isEmpty() )
+        *error = skipped? QCoreApplication::translate("FontModule", "The fonts in this module are compressed, which is not supported."):
+                          QCoreApplication::translate("FontModule", "This module does not contain any fonts.");
+    return fonts;
+}
+
+
+/* 16-bit OS/2 modules list the type and name of each resource, and store
+ * the resources themselves as the last segments of the module.
+ */
+static QList<FontModule::Resource> neOS2Fonts( const uchar *data, qint64 size, qint64 ne, QString *error )
+{
+    QList<FontModule::Resource> fonts;
+    const uchar *h         = data + ne;
+    int          segCount  = readWord( h + NE_SEGMENT_COUNT );
+    qint64       segments  = ne + readWord( h + NE_SEGMENT_TABLE );
+    qint64       resources = ne + readWord( h + NE_RESOURCE_TABLE );
+    int          shift     = readWord( h + NE_ALIGN_SHIFT );
+    int          resCount  = readWord( h + NE_RESOURCE_SEGMENTS );
+
+    if ( resCount > segCount || shift > MAX_ALIGN_SHIFT ||
+         resources + resCount * 4 > size || segments + segCount * NE_SEGMENT_SIZE > size ) {
+        *error = QCoreApplication::translate("FontModule", "The module header is damaged.");
+        return fonts;
+    }
+
+    int skipped = 0;
+    for ( int i = 0; i < resCount; i++ ) {
+        const uchar *r = data + resources + i * 4;
+        if ( readWord( r ) != OS2_RT_FONT )
+            continue;
+
+        const uchar *s      = data + segments + ( segCount - resCount + i ) * NE_SEGMENT_SIZE;
+        qint64       offset = (qint64) readWord( s ) << shift;
+        qint64       length = readWord( s + 2 );
+        if ( length == 0 )
+            length = 0x10000;
+        if ( offset == 0 || ( readWord( s + 4 ) & NE_SEGMENT_ITERATED ) || offset + length > size ) {
+            skipped++;
+            continue;
+        }
+        FontModule::Resource font = { readWord( r + 2 ), offset, length };
+        fonts.append( font );
+    }
+
+    if ( fonts.isEmpty() )
+        *error = skipped? QCoreApplication::translate("FontModule", "The fonts in this module are compressed, which is not supported."):
+                          QCoreApplication::translate("FontModule", "This module does not contain any fonts.");
+    return fonts;
+}
+
+
+/* Windows modules group their resources by type; each entry gives the
+ * resource's position and length in units of the alignment shift.
+ */
+static QList<FontModule::Resource> neWindowsFonts( const uchar *data, qint64 size, qint64 ne, QString *error )
+{
+    QList<FontModule::Resource> fonts;
+    qint64 table = ne + readWord( data + ne + NE_RESOURCE_TABLE );
+    if ( table + 2 > size ) {
+        *error = QCoreApplication::translate("FontModule", "The module header is damaged.");
+        return fonts;
+    }
+
+    int    shift = readWord( data + table );
+    qint64 entry = table + 2;
+    while ( shift <= MAX_ALIGN_SHIFT && entry + 8 <= size ) {
+        quint16 type  = readWord( data + entry );
+        int     count = readWord( data + entry + 2 );
+        if ( type == 0 )
+            break;
+        entry += 8;
+        for ( int i = 0; i < count && entry + 12 <= size; i++, entry += 12 ) {
+            if ( type != WIN_RT_FONT )
+                continue;
+            qint64 offset = (qint64) readWord( data + entry ) << shift;
+            qint64 length = (qint64) readWord( data + entry + 2 ) << shift;
+            if ( offset + length > size )
+                length = size - offset;
+            if ( offset > 0 && length > 0 ) {
+                FontModule::Resource font = { (quint16)( readWord( data + entry + 6 ) & 0x7FFF ), offset, length };
+                fonts.append( font );
+            }
+        }
+    }
+
+    if ( fonts.isEmpty() )
+        *error = QCoreApplication::translate("FontModule", "This module does not contain any fonts.");
+    return fonts;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC FUNCTIONS
+//
+
+bool FontModule::recognize( const uchar *data, qint64 size )
+{
+    return newHeader( data, size ) >= 0;
+}
+
+
+/* List the font resources in a module, in the order the module lists them.
+ * If there are none that can be used, the list is empty and errorString
+ * (if given) says why.
+ */
+QList<FontModule::Resource> FontModule::fontResources( const uchar *data, qint64 size, QString *errorString )
+{
+    QString error;
+    QList<Resource> fonts;
+    qint64 header = newHeader( data, size );
+
+    if ( header < 0 )
+        error = QCoreApplication::translate("FontModule", "This is not an OS/2 or Windows module.");
+    else if ( data[ header ] == 'L' )
+        fonts = lxFonts( data, size, header, &error );
+    else if ( header + NE_HEADER_SIZE > size )
+        error = QCoreApplication::translate("FontModule", "The module header is damaged.");
+    else if ( data[ header + NE_TARGET_OS ] == NE_TARGET_WINDOWS )
+        fonts = neWindowsFonts( data, size, header, &error );
+    else
+        fonts = neOS2Fonts( data, size, header, &error );
+
+    if ( errorString )
+        *errorString = error;
+    return fonts;
+}
@@ -0,0 +1,48 @@
+/******************************************************************************
+** fontmodule.h
+**
+** Locating font resources in OS/2 and Windows executable modules.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef FONTMODULE_H
+#define FONTMODULE_H
+
+#include <QList>
+#include <QString>
+
+
+/* OS/2 font DLLs (LX or 16-bit NE) and Windows .FON files (NE) carry their
+ * fonts as resources.  Each font resource is located as a byte range of the
+ * module file, so that a reader can work on it in place, straight out of
+ * the memory-mapped module.  Resources which aren't stored as one plain
+ * range (i.e. compressed or iterated LX pages) are skipped.
+ */
+namespace FontModule {
+    struct Resource {
+        quint16 id;
+        qint64  offset;         // from the start of the module
+        qint64  size;
+    };
+
+    bool            recognize( const uchar *data, qint64 size );
+    QList<Resource> fontResources( const uchar *data, qint64 size, QString *errorString = 0 );
+};
+
+#endif  // FONTMODULE_H
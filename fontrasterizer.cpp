@@ -0,0 +1,336 @@
+/******************************************************************************
+** fontrasterizer.cpp
+**
+** Rendering of outline (TrueType/OpenType/Type 1) fonts into bitmap fonts.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QStringList>
+#include <QtConcurrentMap>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "fontdocument.h"
+#include "fontrasterizer.h"
+#include "glyphnames.h"
+
+// Number of code points rendered by one worker before it takes the next chunk
+#define RASTER_CHUNK        256
+
+// Highest code point that can be rendered
+#define MAX_CODE_POINT      0x10FFFF
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* OR one row of a FreeType monochrome bitmap into a packed glyph row at
+ * pixel offset x.  Both use the same bit order (leftmost pixel in the most
+ * significant bit), so the row is moved four bytes at a time.
+ */
+static void copyMonoRow( quint32 *dst, int words, int x, const uchar *src, int bits )
+{
+    int bytes = ( bits + 7 ) / 8;
+    for ( int b = 0; b < bytes; b += 4 ) {
+        quint32 w = 0;
+        for ( int i = 0; i < 4; i++ )
+            w = ( w << 8 ) | ( b + i < bytes ? src[ b + i ] : 0 );
+        int remain = bits - b * 8;
+        if ( remain < 32 )
+            w &= ~0u << ( 32 - remain );
+
+        int pos = x + b * 8;
+        int k   = pos >> 5;
+        int s   = pos & 31;
+        if ( k < words )
+            dst[ k ] |= w >> s;
+        if ( s && k + 1 < words )
+            dst[ k + 1 ] |= w << ( 32 - s );
+    }
+}
+
+
+/* Render one code point into a glyph cell of the given height, with the
+ * baseline 'ascent' rows from the top.  The cell is as wide as the advance,
+ * or wider if the ink extends past it; ink to the left of the origin is
+ * moved into the cell.  Code points which the face has no glyph for give a
+ * null bitmap, rather than a copy of its .notdef box.
+ */
+static GlyphBitmap renderGlyph( FT_Face face, uint code, int ascent, int height )
+{
+    FT_UInt index = FT_Get_Char_Index( face, code );
+    if ( !index || FT_Load_Glyph( face, index, FT_LOAD_RENDER | FT_LOAD_TARGET_MONO | FT_LOAD_MONOCHROME ))
+        return GlyphBitmap();
+
+    FT_GlyphSlot    slot = face->glyph;
+    const FT_Bitmap &bm  = slot->bitmap;
+
+    int x     = qMax( slot->bitmap_left, 0 );
+    int width = qMax( (int)(( slot->advance.x + 32 ) >> 6 ), x + (int) bm.width );
+    GlyphBitmap glyph( qMax( width, 1 ), height );
+
+    // Faces with embedded greyscale strikes may ignore the mono target
+    if ( bm.pixel_mode != FT_PIXEL_MODE_MONO || !bm.buffer )
+        return glyph;
+
+    const uchar *top = bm.buffer;
+    if ( bm.pitch < 0 )
+        top -= bm.pitch * ( (int) bm.rows - 1 );
+
+    int y = ascent - slot->bitmap_top;
+    for ( int row = 0; row < (int) bm.rows; row++, y++ ) {
+        if ( y < 0 || y >= height )
+            continue;
+        copyMonoRow( glyph.scanLine( y ), glyph.wordsPerLine(), x,
+                     top + row * bm.pitch, bm.width );
+    }
+    return glyph;
+}
+
+
+// ---------------------------------------------------------------------------
+// Renders one chunk of code points (for QtConcurrent).  FreeType objects
+// may not be shared between threads, so each chunk opens its own library
+// and face over the shared font data, and writes straight into its own
+// slots of the glyph array.
+//
+struct RasterJob
+{
+    typedef void result_type;
+
+    void operator()( const uint &first ) const
+    {
+        FT_Library library;
+        FT_Face    face;
+
+        if ( FT_Init_FreeType( &library ))
+            return;
+        if ( FT_New_Memory_Face( library, (const FT_Byte *) data->constData(),
+                                 data->size(), faceIndex, &face ) == 0 )
+        {
+            FT_Set_Pixel_Sizes( face, 0, pixelSize );
+            for ( uint code = first; code <= lastChar && code < first + RASTER_CHUNK; code++ )
+                glyphs[ code - firstChar ] = renderGlyph( face, code, ascent, height );
+            FT_Done_Face( face );
+        }
+        FT_Done_FreeType( library );
+    }
+
+    const QByteArray *data;
+    int               faceIndex;
+    int               pixelSize;
+    int               ascent;
+    int               height;
+    uint              firstChar;
+    uint              lastChar;
+    GlyphBitmap      *glyphs;
+};
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+FontRasterizer::FontRasterizer()
+{
+    iFaceIndex = 0;
+    iFirstChar = 0;
+    iPixelSize = 0;
+    iHeight    = 0;
+    iDescent   = 0;
+}
+
+
+// ---------------------------------------------------------------------------
+// DESTRUCTOR
+//
+
+/* The workers write into this object, so they have to stop first.
+ */
+FontRasterizer::~FontRasterizer()
+{
+    rasterFuture.cancel();
+    rasterFuture.waitForFinished();
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* The face name for fonts made from this one: the family followed by the
+ * style, except for a plain style such as "Regular" (as in
+ * GlyphStyler::styleName()).
+ */
+QString FontRasterizer::faceName() const
+{
+    QStringList words = strStyle.split(' ', QString::SkipEmptyParts );
+    words.removeAll("Regular");
+    words.removeAll("Normal");
+    words.removeAll("Roman");
+    words.prepend( strFamily );
+    return words.join(" ");
+}
+
+
+/* Load an outline font file and check that FreeType can use it.
+ */
+bool FontRasterizer::open( const QString &fileName, int faceIndex )
+{
+    if ( rasterFuture.isRunning() )
+        return false;
+    fontData.clear();
+    strFamily.clear();
+    strStyle.clear();
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly )) {
+        strError = file.errorString();
+        return false;
+    }
+    QByteArray data = file.readAll();
+
+    FT_Library library;
+    FT_Face    face;
+    bool       ok = false;
+
+    if ( FT_Init_FreeType( &library )) {
+        strError = QCoreApplication::translate("FontRasterizer", "The font engine could not be started.");
+        return false;
+    }
+    if ( FT_New_Memory_Face( library, (const FT_Byte *) data.constData(),
+                             data.size(), faceIndex, &face ) == 0 )
+    {
+        if ( FT_IS_SCALABLE( face )) {
+            strFamily = QString::fromLatin1( face->family_name );
+            strStyle  = QString::fromLatin1( face->style_name );
+            ok = true;
+        }
+        else
+            strError = QCoreApplication::translate("FontRasterizer", "This is not an outline font.");
+        FT_Done_Face( face );
+    }
+    else
+        strError = QCoreApplication::translate("FontRasterizer", "The file is not a supported font format.");
+    FT_Done_FreeType( library );
+
+    if ( ok ) {
+        fontData   = data;
+        iFaceIndex = faceIndex;
+    }
+    return ok;
+}
+
+
+/* Start rendering the code points firstChar to lastChar.  The cell height
+ * and baseline come from the face's scaled ascender and descender; each
+ * glyph's increment is its hinted advance width.  Returns false, without
+ * starting, if the font can't be rendered at this size.
+ */
+bool FontRasterizer::start( uint firstChar, uint lastChar, int pixelSize )
+{
+    if ( rasterFuture.isRunning() )
+        return false;
+    if ( fontData.isEmpty() || lastChar < firstChar || lastChar > MAX_CODE_POINT || pixelSize < 1 ) {
+        strError = QCoreApplication::translate("FontRasterizer", "Invalid font, size or character range.");
+        return false;
+    }
+
+    // Work out the cell metrics once, so that every worker agrees on them
+    FT_Library library;
+    FT_Face    face;
+    int        ascent  = 0;
+    int        descent = 0;
+
+    if ( FT_Init_FreeType( &library )) {
+        strError = QCoreApplication::translate("FontRasterizer", "The font engine could not be started.");
+        return false;
+    }
+    if ( FT_New_Memory_Face( library, (const FT_Byte *) fontData.constData(),
+                             fontData.size(), iFaceIndex, &face ) == 0 )
+    {
+        if ( FT_Set_Pixel_Sizes( face, 0, pixelSize ) == 0 ) {
+            ascent  = ( face->size->metrics.ascender + 63 ) >> 6;
+            descent = ( -face->size->metrics.descender + 63 ) >> 6;
+        }
+        FT_Done_Face( face );
+    }
+    FT_Done_FreeType( library );
+
+    int height = ascent + descent;
+    if ( height < 1 ) {
+        strError = QCoreApplication::translate("FontRasterizer", "The font cannot be rendered at this size.");
+        return false;
+    }
+
+    iFirstChar = firstChar;
+    iPixelSize = pixelSize;
+    iHeight    = height;
+    iDescent   = descent;
+    glyphs.fill( GlyphBitmap(), lastChar - firstChar + 1 );
+    chunks.clear();
+    for ( uint first = firstChar; first <= lastChar; first += RASTER_CHUNK )
+        chunks.append( first );
+
+    RasterJob job;
+    job.data      = &fontData;
+    job.faceIndex = iFaceIndex;
+    job.pixelSize = pixelSize;
+    job.ascent    = ascent;
+    job.height    = height;
+    job.firstChar = firstChar;
+    job.lastChar  = lastChar;
+    job.glyphs    = glyphs.data();
+    rasterFuture = QtConcurrent::map( chunks, job );
+    return true;
+}
+
+
+/* The rendered font as a new document, once future() has finished.  Null
+ * if the rendering was cancelled.
+ */
+FontDocument *FontRasterizer::takeDocument( QObject *parent )
+{
+    rasterFuture.waitForFinished();
+    if ( rasterFuture.isCanceled() || glyphs.isEmpty() ) {
+        strError = QCoreApplication::translate("FontRasterizer", "The rendering was cancelled.");
+        glyphs.clear();
+        return 0;
+    }
+
+    // Anything that could not be rendered, or which the face lacks, is left as an empty cell
+    for ( int i = 0; i < glyphs.size(); i++ )
+        if ( glyphs.at( i ).isNull() )
+            glyphs[ i ] = GlyphBitmap( qMax( iPixelSize / 2, 1 ), iHeight );
+
+    FontDocument *document = new FontDocument( parent );
+    document->setFamilyName( strFamily );
+    document->setFaceName( faceName() );
+    document->setCodePage( UCS2_CODEPAGE );
+    document->setFirstChar( iFirstChar );
+    document->setPointSize( qRound( iPixelSize * 72.0 / 96.0 ));
+    document->setBaseLine( iDescent );
+    document->setGlyphs( glyphs );
+    glyphs.clear();
+    return document;
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+** fontrasterizer.h
+**
+** Rendering of outline (TrueType/OpenType/Type 1) fonts into bitmap fonts.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef FONTRASTERIZER_H
+#define FONTRASTERIZER_H
+
+#include <QByteArray>
+#include <QFuture>
+#include <QString>
+#include <QVector>
+
+#include "glyphbitmap.h"
+
+class QObject;
+class FontDocument;
+
+
+/* Renders a range of code points from an outline font at a fixed pixel size,
+ * using FreeType's monochrome hinting.  The font file is read into memory
+ * once; the glyphs are then rendered in chunks across a thread pool, each
+ * worker opening its own FreeType instance on the shared file data.
+ *
+ * start() returns as soon as the rendering is under way; its progress (in
+ * chunks) can be followed, or the rendering cancelled, through future().
+ * Once that has finished, takeDocument() gives the finished font.
+ */
+class FontRasterizer
+{
+public:
+    FontRasterizer();
+    ~FontRasterizer();
+
+    bool    open( const QString &fileName, int faceIndex = 0 );
+    QString errorString() const { return strError; }
+    QString familyName() const { return strFamily; }
+    QString styleName() const { return strStyle; }
+    QString faceName() const;
+
+    bool            start( uint firstChar, uint lastChar, int pixelSize );
+    QFuture<void>   future() const { return rasterFuture; }
+    FontDocument   *takeDocument( QObject *parent = 0 );
+
+private:
+    QByteArray fontData;
+    int        iFaceIndex;
+    QString    strFamily;
+    QString    strStyle;
+    QString    strError;
+
+    // The rendering under way
+    QFuture<void>        rasterFuture;
+    QVector<uint>        chunks;        // first code point of each chunk
+    QVector<GlyphBitmap> glyphs;
+    uint                 iFirstChar;
+    int                  iPixelSize;
+    int                  iHeight;
+    int                  iDescent;
+};
+
+#endif  // FONTRASTERIZER_H
@@ -0,0 +1,342 @@
+/******************************************************************************
+** glyphatlas.cpp
+**
+** Packing a font into a texture atlas with a metrics index.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QHash>
+#include <QtConcurrentMap>
+#include <qmath.h>
+
+#include "fontdocument.h"
+#include "glyphatlas.h"
+#include "glyphnames.h"
+
+#define ATLAS_VERSION           1
+#define ATLAS_MAX_SIZE          0xFFFF      // atlas positions are 16 bits
+#define ATLAS_MAX_GLYPH         0xFF        // glyph cells are 8 bits
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+// A glyph cropped to its ink bounds (for QtConcurrent).
+struct AtlasCrop
+{
+    GlyphBitmap image;
+    QRect       ink;
+};
+
+struct AtlasCropJob
+{
+    typedef void result_type;
+
+    void operator()( AtlasCrop &crop ) const
+    {
+        crop.ink = crop.image.inkBounds();
+        crop.image = crop.ink.isEmpty()? GlyphBitmap(): crop.image.copy( crop.ink );
+    }
+};
+
+
+// A distinct glyph image to be placed, with its padding included.
+struct AtlasItem
+{
+    int width;
+    int height;
+    int image;
+};
+
+static bool tallerThan( const AtlasItem &a, const AtlasItem &b )
+{
+    if ( a.height != b.height )
+        return a.height > b.height;
+    return a.width > b.width;
+}
+
+static bool codePointLessThan( const GlyphAtlas::Entry &a, const GlyphAtlas::Entry &b )
+{
+    return a.codePoint < b.codePoint;
+}
+
+
+/* One attempt at packing the items into an atlas of a given width, using
+ * the skyline bottom-left method: the top edge of everything placed so far
+ * is kept as a list of horizontal segments, and each item goes wherever its
+ * top edge ends up lowest.  The trials for several widths are run in
+ * parallel (for QtConcurrent) and the one with the least area is kept.
+ */
+struct AtlasTrial
+{
+    int             width;
+    QSize           used;
+    QVector<QPoint> positions;      // of each item
+};
+
+struct AtlasPackJob
+{
+    typedef void result_type;
+
+    AtlasPackJob( const QVector<AtlasItem> *i ): items( i ) {}
+    void operator()( AtlasTrial &trial ) const;
+
+    const QVector<AtlasItem> *items;
+};
+
+void AtlasPackJob::operator()( AtlasTrial &trial ) const
+{
+    struct Segment { int x, y, width; };
+    QVector<Segment> sky;
+    Segment floor = { 0, 0, trial.width };
+    sky.append( floor );
+
+    trial.positions.resize( items->size() );
+    int right = 0, bottom = 0;
+
+    for ( int n = 0; n < items->size(); n++ ) {
+        int w = items->at( n ).width;
+        int h = items->at( n ).height;
+
+        // Find the segment to start from which leaves the item lowest
+        int best = -1, bestY = 0, bestTop = 0;
+        for ( int i = 0; i < sky.size() && sky.at( i ).x + w <= trial.width; i++ ) {
+            int y = 0;
+            for ( int j = i, covered = 0; covered < w; covered += sky.at( j++ ).width )
+                y = qMax( y, sky.at( j ).y );
+            if ( best < 0 || y + h < bestTop ) {
+                best    = i;
+                bestY   = y;
+                bestTop = y + h;
+            }
+        }
+
+        int x = sky.at( best ).x;
+        trial.positions[ n ] = QPoint( x, bestY );
+        right  = qMax( right, x + w );
+        bottom = qMax( bottom, bestTop );
+
+        // Raise the skyline over the item, trimming what is now beneath it
+        Segment top = { x, bestTop, w };
+        sky.insert( best, top );
+        for ( int i = best + 1; i < sky.size() && sky.at( i ).x < x + w; ) {
+            int overlap = x + w - sky.at( i ).x;
+            if ( overlap < sky.at( i ).width ) {
+                sky[ i ].x     += overlap;
+                sky[ i ].width -= overlap;
+                break;
+            }
+            sky.remove( i );
+        }
+        for ( int i = qMax( best - 1, 0 ); i + 1 < sky.size() && i <= best; ) {
+            if ( sky.at( i ).y == sky.at( i + 1 ).y ) {
+                sky[ i ].width += sky.at( i + 1 ).width;
+                sky.remove( i + 1 );
+            }
+            else
+                i++;
+        }
+    }
+    trial.used = QSize( right, bottom );
+}
+
+
+/* Expand a 1-bit canvas into 8-bit greyscale, a word at a time.
+ */
+static QImage grayImage( const GlyphBitmap &canvas )
+{
+    QImage image( canvas.width(), canvas.height(), QImage::Format_Indexed8 );
+    QVector<QRgb> greys( 256 );
+    for ( int i = 0; i < 256; i++ )
+        greys[ i ] = qRgb( i, i, i );
+    image.setColorTable( greys );
+
+    for ( int y = 0; y < canvas.height(); y++ ) {
+        const quint32 *src = canvas.constScanLine( y );
+        uchar         *dst = image.scanLine( y );
+        for ( int x = 0; x < canvas.width(); x += QBF_WORD_BITS ) {
+            quint32 bits = src[ x >> 5 ];
+            int     end  = qMin( QBF_WORD_BITS, canvas.width() - x );
+            for ( int i = 0; i < end; i++, bits <<= 1 )
+                *dst++ = ( bits & 0x80000000u )? 0xFF: 0;
+        }
+    }
+    return image;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC FUNCTIONS
+//
+
+/* The index stores cell positions and sizes in bytes, so glyphs larger
+ * than 255 pixels cannot be exported.
+ */
+bool GlyphAtlas::canExport( const FontDocument *document, QString *errorString )
+{
+    QString error;
+    if ( document->glyphCount() > 0x10000 )
+        error = QCoreApplication::translate("GlyphAtlas", "An atlas can hold at most 65536 glyphs.");
+    else if ( document->cellHeight() > ATLAS_MAX_GLYPH ||
+              document->metrics().maxIncrement() > ATLAS_MAX_GLYPH )
+        error = QCoreApplication::translate("GlyphAtlas", "An atlas cannot hold glyphs larger than %1 pixels.").arg( ATLAS_MAX_GLYPH );
+
+    if ( errorString )
+        *errorString = error;
+    return error.isEmpty();
+}
+
+
+/* Crop, pack and draw every glyph of the font, leaving at least padding
+ * blank pixels between neighbouring images.  The glyphs are cropped in
+ * parallel, and several atlas widths around the square root of the total
+ * area are tried in parallel, keeping whichever packs into the least area
+ * without growing taller than the index can address.  The widest possible
+ * atlas is always among those tried; if even that is too tall, the atlas
+ * returned has a null image.
+ */
+GlyphAtlas::Atlas GlyphAtlas::build( const FontDocument *document, Format format, int padding, QString *errorString )
+{
+    int count = document->glyphCount();
+    QVector<AtlasCrop> crops( count );
+    for ( int i = 0; i < count; i++ )
+        crops[ i ].image = document->decodeGlyph( i );
+    QtConcurrent::blockingMap( crops, AtlasCropJob() );
+
+    // Each distinct image is placed only once
+    QVector<int>          imageOf( count, -1 );
+    QVector<AtlasItem>    items;
+    QHash<GlyphBitmap, int> distinct;
+    qint64 area = 0, glyphArea = 0;
+    int    widest = 1;
+    for ( int i = 0; i < count; i++ ) {
+        const GlyphBitmap &image = crops.at( i ).image;
+        if ( image.isNull() )
+            continue;
+        QHash<GlyphBitmap, int>::const_iterator found = distinct.constFind( image );
+        if ( found != distinct.constEnd() ) {
+            imageOf[ i ] = found.value();
+            continue;
+        }
+        AtlasItem item = { image.width() + padding, image.height() + padding, i };
+        imageOf[ i ] = items.size();
+        distinct.insert( image, items.size() );
+        items.append( item );
+        area      += (qint64) item.width * item.height;
+        glyphArea += (qint64) image.width() * image.height();
+        widest     = qMax( widest, item.width );
+    }
+
+    // Place the tallest items first; the order of imageOf is kept in 'slot'
+    QVector<AtlasItem> order = items;
+    qSort( order.begin(), order.end(), tallerThan );
+    QVector<int> slot( items.size() );
+    for ( int n = 0; n < order.size(); n++ )
+        slot[ imageOf.at( order.at( n ).image ) ] = n;
+
+    QVector<AtlasTrial> trials;
+    int side = qMax( widest, qCeil( qSqrt( (qreal) area )));
+    for ( int step = 6; step <= 20; step++ ) {
+        AtlasTrial trial;
+        trial.width = qBound( widest, side * step / 10, (int) ATLAS_MAX_SIZE + padding );
+        if ( trials.isEmpty() || trials.last().width != trial.width )
+            trials.append( trial );
+    }
+    if ( trials.last().width != (int) ATLAS_MAX_SIZE + padding ) {
+        AtlasTrial widest;
+        widest.width = ATLAS_MAX_SIZE + padding;
+        trials.append( widest );
+    }
+    QtConcurrent::blockingMap( trials, AtlasPackJob( &order ));
+
+    int best = -1;
+    for ( int i = 0; i < trials.size(); i++ ) {
+        if ( trials.at( i ).used.height() - padding > ATLAS_MAX_SIZE )
+            continue;
+        qint64 a = (qint64) trials.at( i ).used.width() * trials.at( i ).used.height();
+        if ( best < 0 || a < (qint64) trials.at( best ).used.width() * trials.at( best ).used.height() )
+            best = i;
+    }
+    if ( best < 0 ) {
+        if ( errorString )
+            *errorString = QCoreApplication::translate("GlyphAtlas", "The glyphs do not fit in an atlas of %1 by %1 pixels.")
+                               .arg( ATLAS_MAX_SIZE );
+        return Atlas();
+    }
+    const AtlasTrial &trial = trials.at( best );
+
+    // Draw the images, and describe each glyph
+    int width  = qMax( trial.used.width() - padding, 1 );
+    int height = qMax( trial.used.height() - padding, 1 );
+    GlyphBitmap canvas( width, height );
+    for ( int n = 0; n < items.size(); n++ )
+        canvas.blit( trial.positions.at( slot.at( n )), crops.at( items.at( n ).image ).image, GlyphBitmap::Copy );
+
+    Atlas atlas;
+    atlas.image = ( format == Gray )? grayImage( canvas ): canvas.toImage( qRgb( 255, 255, 255 ), qRgb( 0, 0, 0 ));
+    atlas.glyphArea = glyphArea;
+    for ( int i = 0; i < count; i++ ) {
+        uint codePoint = GlyphNames::codePoint( document->codePage(), document->firstChar() + i );
+        if ( codePoint == NO_CODE_POINT )
+            continue;
+
+        Entry entry = { codePoint, 0, 0, 0, 0, 0, 0, (quint16) document->metrics().glyph( i ).increment, (quint16) i };
+        if ( imageOf.at( i ) >= 0 ) {
+            QPoint at    = trial.positions.at( slot.at( imageOf.at( i )));
+            entry.x      = at.x();
+            entry.y      = at.y();
+            entry.width  = crops.at( i ).ink.width();
+            entry.height = crops.at( i ).ink.height();
+            entry.left   = crops.at( i ).ink.left();
+            entry.top    = crops.at( i ).ink.top();
+        }
+        atlas.entries.append( entry );
+    }
+    qStableSort( atlas.entries.begin(), atlas.entries.end(), codePointLessThan );
+    return atlas;
+}
+
+
+/* The binary index for an atlas, as described in glyphatlas.h.
+ */
+QByteArray GlyphAtlas::index( const FontDocument *document, const Atlas &atlas )
+{
+    QByteArray data;
+    QDataStream out( &data, QIODevice::WriteOnly );
+    out.setByteOrder( QDataStream::LittleEndian );
+
+    out.writeRawData( "QBFA", 4 );
+    out << (quint16) ATLAS_VERSION
+        << (quint16) atlas.image.depth()
+        << (quint32) atlas.entries.size()
+        << (quint16) document->cellHeight()
+        << (quint16)( document->cellHeight() - document->baseLine() );
+
+    for ( int i = 0; i < atlas.entries.size(); i++ ) {
+        const Entry &entry = atlas.entries.at( i );
+        out << (quint32) entry.codePoint
+            << entry.x << entry.y
+            << entry.width << entry.height << entry.left << entry.top
+            << entry.advance << entry.glyph;
+    }
+    return data;
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+** glyphatlas.h
+**
+** Packing a font into a texture atlas with a metrics index.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+#include <QVector>
+
+class FontDocument;
+
+
+/* An atlas holds every glyph of a font, cropped to its ink bounds, packed
+ * into a single image for use as a texture; identical crops are stored only
+ * once.  The index lists each glyph which has a Unicode code point, in
+ * code point order, as little-endian records:
+ *
+ *   header (16 bytes): "QBFA", version (2), bits per pixel (2),
+ *                      entry count (4), cell height (2), ascent (2)
+ *   entry (16 bytes):  code point (4), atlas x (2), atlas y (2),
+ *                      width (1), height (1), left (1), top (1),
+ *                      advance (2), glyph index (2)
+ *
+ * where left and top place the cropped image within the glyph cell.  Blank
+ * glyphs have a width and height of 0.
+ */
+namespace GlyphAtlas {
+    enum Format {
+        Mono,           // 1 bit per pixel
+        Gray            // 8 bits per pixel, each 0 or 255
+    };
+
+    struct Entry {
+        uint    codePoint;
+        quint16 x;
+        quint16 y;
+        quint8  width;
+        quint8  height;
+        quint8  left;
+        quint8  top;
+        quint16 advance;
+        quint16 glyph;
+    };
+
+    struct Atlas {
+        QImage          image;
+        QVector<Entry>  entries;        // sorted by code point
+        qint64          glyphArea;      // pixels taken up by glyph images
+    };
+
+    bool        canExport( const FontDocument *document, QString *errorString = 0 );
+    Atlas       build( const FontDocument *document, Format format, int padding, QString *errorString = 0 );
+    QByteArray  index( const FontDocument *document, const Atlas &atlas );
+};
+
+#endif  // GLYPHATLAS_H
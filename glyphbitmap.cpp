@@ -0,0 +1,946 @@
+/******************************************************************************
+** glyphbitmap.cpp
+**
+** Packed 1bpp glyph bitmap with implicit (copy-on-write) sharing.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QDataStream>
+#include <QVarLengthArray>
+#include <QtEndian>
+#include <qmath.h>
+
+#include <string.h>
+
+#include "glyphbitmap.h"
+
+
+// ---------------------------------------------------------------------------
+// CONSTRUCTORS
+//
+
+GlyphBitmap::GlyphBitmap()
+{
+    d = new GlyphBitmapData;
+}
+
+
+GlyphBitmap::GlyphBitmap( int width, int height )
+{
+    d = new GlyphBitmapData;
+    if ( width > 0 && height > 0 ) {
+        d->width  = width;
+        d->height = height;
+        d->stride = qbfWordsForWidth( width );
+        d->bits.fill( 0, d->stride * height );
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// PIXEL ACCESS
+//
+
+bool GlyphBitmap::pixel( int x, int y ) const
+{
+    if ( x < 0 || y < 0 || x >= d->width || y >= d->height )
+        return false;
+    return ( d->bits.at( y * d->stride + ( x >> 5 )) & qbfPixelBit( x )) != 0;
+}
+
+
+void GlyphBitmap::setPixel( int x, int y, bool on )
+{
+    if ( x < 0 || y < 0 || x >= d->width || y >= d->height )
+        return;
+    quint32 &word = d->bits[ y * d->stride + ( x >> 5 ) ];
+    if ( on )
+        word |= qbfPixelBit( x );
+    else
+        word &= ~qbfPixelBit( x );
+}
+
+
+void GlyphBitmap::fill( bool on )
+{
+    if ( !on ) {
+        d->bits.fill( 0 );
+        return;
+    }
+    quint32 tail = qbfSpanMask( d->stride - 1, 0, d->width );
+    for ( int y = 0; y < d->height; y++ ) {
+        quint32 *row = scanLine( y );
+        for ( int k = 0; k < d->stride - 1; k++ )
+            row[ k ] = 0xFFFFFFFFu;
+        row[ d->stride - 1 ] = tail;
+    }
+}
+
+
+quint32 *GlyphBitmap::scanLine( int y )
+{
+    return d->bits.data() + y * d->stride;
+}
+
+
+const quint32 *GlyphBitmap::constScanLine( int y ) const
+{
+    return d->bits.constData() + y * d->stride;
+}
+
+
+void GlyphBitmap::fillRect( const QRect &area, bool on )
+{
+    QRect r = area & rect();
+    if ( r.isEmpty() )
+        return;
+    int lo = r.left(),
+        hi = r.right() + 1;
+    for ( int y = r.top(); y <= r.bottom(); y++ ) {
+        quint32 *row = scanLine( y );
+        for ( int k = lo >> 5; k <= ( hi - 1 ) >> 5; k++ ) {
+            if ( on )
+                row[ k ] |= qbfSpanMask( k, lo, hi );
+            else
+                row[ k ] &= ~qbfSpanMask( k, lo, hi );
+        }
+    }
+}
+
+
+/* Draw a one-pixel line with Bresenham's algorithm.  Pixels falling outside
+ * the bitmap are skipped, so the end points need not lie inside it.
+ */
+void GlyphBitmap::drawLine( const QPoint &from, const QPoint &to, bool on )
+{
+    int x  = from.x(),
+        y  = from.y();
+    int dx = qAbs( to.x() - x ),
+        dy = -qAbs( to.y() - y );
+    int sx = ( x < to.x() )? 1: -1,
+        sy = ( y < to.y() )? 1: -1;
+    int err = dx + dy;
+
+    for (;;) {
+        setPixel( x, y, on );
+        if ( x == to.x() && y == to.y() )
+            break;
+        int e2 = 2 * err;
+        if ( e2 >= dy ) {
+            err += dy;
+            x += sx;
+        }
+        if ( e2 <= dx ) {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+
+/* Draw the outline of a rectangle, one pixel wide, as four filled spans.
+ */
+void GlyphBitmap::drawRect( const QRect &area, bool on )
+{
+    QRect r = area.normalized();
+    fillRect( QRect( r.left(), r.top(), r.width(), 1 ), on );
+    fillRect( QRect( r.left(), r.bottom(), r.width(), 1 ), on );
+    fillRect( QRect( r.left(), r.top(), 1, r.height() ), on );
+    fillRect( QRect( r.right(), r.top(), 1, r.height() ), on );
+}
+
+
+/* The span of columns [*left, *right] which row y of the ellipse inscribed
+ * in area covers, or false if it covers none.  Coordinates are doubled so
+ * that centres and radii falling between pixels stay exact; the radii are
+ * taken half a pixel wide so that the ellipse's extreme rows and columns
+ * are spans rather than single pixels.  The middle row (or two) always
+ * spans the full width, and the top and bottom rows at least the middle
+ * column (or two), so that the ellipse touches every side of the area.
+ */
+static bool ellipseSpan( const QRect &area, int y, int *left, int *right )
+{
+    if ( y < area.top() || y > area.bottom() )
+        return false;
+    int cx = area.left() + area.right();
+    int cy = area.top() + area.bottom();
+    if ( qAbs( 2 * y - cy ) <= 1 ) {
+        *left  = area.left();
+        *right = area.right();
+        return true;
+    }
+
+    double rx = area.width();
+    double ry = area.height();
+    double dy = ( 2 * y - cy ) / ry;
+    double hx = rx * qSqrt( qMax( 0.0, 1.0 - dy * dy ));
+    *left  = qMin( qCeil(( cx - hx ) / 2 ), cx / 2 );
+    *right = qMax( qFloor(( cx + hx ) / 2 ), ( cx + 1 ) / 2 );
+    return true;
+}
+
+
+/* Draw the ellipse inscribed in a rectangle.  Each row is worked out as a
+ * span and filled a word at a time; for an outline, the part of the span
+ * which is also inside the rows above and below is left out.
+ */
+void GlyphBitmap::drawEllipse( const QRect &area, bool on, bool filled )
+{
+    QRect r = area.normalized();
+    for ( int y = qMax( r.top(), 0 ); y <= qMin( r.bottom(), d->height - 1 ); y++ ) {
+        int left, right;
+        if ( !ellipseSpan( r, y, &left, &right ))
+            continue;
+        int above0, above1, below0, below1;
+        if ( filled || !ellipseSpan( r, y - 1, &above0, &above1 ) || !ellipseSpan( r, y + 1, &below0, &below1 )) {
+            fillRect( QRect( left, y, right - left + 1, 1 ), on );
+            continue;
+        }
+        int inner0 = qMax( qMax( above0, below0 ), left + 1 );
+        int inner1 = qMin( qMin( above1, below1 ), right - 1 );
+        if ( inner0 > inner1 ) {
+            fillRect( QRect( left, y, right - left + 1, 1 ), on );
+            continue;
+        }
+        fillRect( QRect( left, y, inner0 - left, 1 ), on );
+        fillRect( QRect( inner1 + 1, y, right - inner1, 1 ), on );
+    }
+}
+
+
+/* The first column at or after x whose pixel is not 'value', or width if
+ * there is none.  Whole words are skipped while they match, and the change
+ * is found by counting leading zeros.
+ */
+static inline int findChange( const quint32 *row, int width, int x, bool value )
+{
+    if ( x >= width )
+        return width;
+    quint32 flip  = value? 0xFFFFFFFFu: 0;
+    int     words = qbfWordsForWidth( width );
+    int     k     = x >> 5;
+    quint32 bits  = ( row[ k ] ^ flip ) & ( 0xFFFFFFFFu >> ( x & 31 ));
+    while ( !bits ) {
+        if ( ++k >= words )
+            return width;
+        bits = row[ k ] ^ flip;
+    }
+    return qMin(( k << 5 ) + qbfLeadingZeros( bits ), width );
+}
+
+
+/* The last column at or before x whose pixel is not 'value', or -1.
+ */
+static inline int findChangeBack( const quint32 *row, int x, bool value )
+{
+    quint32 flip = value? 0xFFFFFFFFu: 0;
+    int     k    = x >> 5;
+    quint32 bits = ( row[ k ] ^ flip ) & ~( 0xFFFFFFFFu >> ( x & 31 ) >> 1 );
+    while ( !bits ) {
+        if ( --k < 0 )
+            return -1;
+        bits = row[ k ] ^ flip;
+    }
+    return ( k << 5 ) + 31 - qbfTrailingZeros( bits );
+}
+
+
+/* Set (or clear) the 4-connected area of pixels around seed which are not
+ * already set (or clear), returning the rectangle changed.  This is a span
+ * fill: each span is found by bit scans from the seed in both directions
+ * and filled a word at a time, and the rows above and below are scanned
+ * along the span for runs to continue into, each run being queued once.
+ */
+QRect GlyphBitmap::floodFill( const QPoint &seed, bool on )
+{
+    if ( !rect().contains( seed ) || pixel( seed.x(), seed.y() ) == on )
+        return QRect();
+
+    d.detach();     // so that the row pointers below stay valid while filling
+    bool  value = !on;
+    QRect damage;
+    QVector<QPoint> pending;
+    pending.append( seed );
+
+    while ( !pending.isEmpty() ) {
+        QPoint p = pending.last();
+        pending.removeLast();
+        const quint32 *row = constScanLine( p.y() );
+        if ( bool( row[ p.x() >> 5 ] & qbfPixelBit( p.x() )) != value )
+            continue;
+
+        int left  = findChangeBack( row, p.x(), value ) + 1;
+        int right = findChange( row, d->width, p.x(), value );
+        QRect span( left, p.y(), right - left, 1 );
+        fillRect( span, on );
+        damage |= span;
+
+        for ( int y = p.y() - 1; y <= p.y() + 1; y += 2 ) {
+            if ( y < 0 || y >= d->height )
+                continue;
+            const quint32 *next = constScanLine( y );
+            int x = findChange( next, d->width, left, !value );
+            while ( x < right ) {
+                pending.append( QPoint( x, y ));
+                x = findChange( next, d->width, findChange( next, d->width, x, value ), !value );
+            }
+        }
+    }
+    return damage;
+}
+
+
+bool GlyphBitmap::isBlank() const
+{
+    const quint32 *bits = d->bits.constData();
+    for ( int i = 0; i < d->bits.size(); i++ )
+        if ( bits[ i ] )
+            return false;
+    return true;
+}
+
+
+// ---------------------------------------------------------------------------
+// SET OPERATIONS
+//
+
+void GlyphBitmap::unite( const GlyphBitmap &other )
+{
+    combine( other, Unite );
+}
+
+
+void GlyphBitmap::intersect( const GlyphBitmap &other )
+{
+    combine( other, Intersect );
+}
+
+
+void GlyphBitmap::subtract( const GlyphBitmap &other )
+{
+    combine( other, Subtract );
+}
+
+
+void GlyphBitmap::invert()
+{
+    if ( isNull() )
+        return;
+    quint32 tail = qbfSpanMask( d->stride - 1, 0, d->width );
+    for ( int y = 0; y < d->height; y++ ) {
+        quint32 *row = scanLine( y );
+        for ( int k = 0; k < d->stride; k++ )
+            row[ k ] = ~row[ k ];
+        row[ d->stride - 1 ] &= tail;
+    }
+}
+
+
+/* Take the pixels of 'changed' wherever 'mask' is set, and keep our own
+ * pixels everywhere else.  This is how an operation is confined to a
+ * selection: it is applied to a copy, and the result merged back through
+ * the selection mask.
+ */
+void GlyphBitmap::merge( const GlyphBitmap &changed, const GlyphBitmap &mask )
+{
+    int height = qMin( d->height, qMin( changed.height(), mask.height() ));
+    int stride = qMin( d->stride, qMin( changed.wordsPerLine(), mask.wordsPerLine() ));
+    for ( int y = 0; y < height; y++ ) {
+        const quint32 *src = changed.constScanLine( y );
+        const quint32 *sel = mask.constScanLine( y );
+        quint32       *dst = scanLine( y );
+        for ( int k = 0; k < stride; k++ )
+            dst[ k ] = ( src[ k ] & sel[ k ] ) | ( dst[ k ] & ~sel[ k ] );
+        dst[ d->stride - 1 ] &= qbfSpanMask( d->stride - 1, 0, d->width );
+    }
+}
+
+
+void GlyphBitmap::combine( const GlyphBitmap &other, SetOp op )
+{
+    int height = qMin( d->height, other.height() );
+    int stride = qMin( d->stride, other.wordsPerLine() );
+    for ( int y = 0; y < height; y++ ) {
+        const quint32 *src = other.constScanLine( y );
+        quint32       *dst = scanLine( y );
+        switch ( op ) {
+            case Unite:
+                for ( int k = 0; k < stride; k++ ) dst[ k ] |= src[ k ];
+                break;
+            case Intersect:
+                for ( int k = 0; k < stride; k++ ) dst[ k ] &= src[ k ];
+                for ( int k = stride; k < d->stride; k++ ) dst[ k ] = 0;
+                break;
+            case Subtract:
+                for ( int k = 0; k < stride; k++ ) dst[ k ] &= ~src[ k ];
+                break;
+        }
+        dst[ d->stride - 1 ] &= qbfSpanMask( d->stride - 1, 0, d->width );
+    }
+    if ( op == Intersect ) {
+        for ( int y = height; y < d->height; y++ )
+            memset( scanLine( y ), 0, d->stride * sizeof( quint32 ));
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// BLOCK OPERATIONS
+//
+
+/* Return a copy of the given area.  As with QImage::copy(), any part of the
+ * area which lies outside the bitmap is returned as blank pixels, so this may
+ * also be used to grow or shrink the bitmap.
+ */
+GlyphBitmap GlyphBitmap::copy( const QRect &area ) const
+{
+    GlyphBitmap result( area.width(), area.height() );
+    if ( result.isNull() )
+        return result;
+
+    int   stride = result.wordsPerLine();
+    quint32 tail = qbfSpanMask( stride - 1, 0, result.width() );
+    for ( int y = 0; y < result.height(); y++ ) {
+        int sy = area.y() + y;
+        if ( sy < 0 || sy >= d->height )
+            continue;
+        const quint32 *src = constScanLine( sy );
+        quint32       *dst = result.scanLine( y );
+        for ( int k = 0; k < stride; k++ )
+            dst[ k ] = qbfFetchBits( src, d->stride, area.x() + ( k << 5 ));
+        dst[ stride - 1 ] &= tail;
+    }
+    return result;
+}
+
+
+/* Return a mirrored copy.  Horizontal mirroring reverses the word order and
+ * the bits within each word, then realigns the row to drop the padding that
+ * has ended up on the left.
+ */
+GlyphBitmap GlyphBitmap::mirrored( bool horizontal, bool vertical ) const
+{
+    GlyphBitmap result( d->width, d->height );
+    if ( result.isNull() )
+        return result;
+
+    int pad = ( d->stride << 5 ) - d->width;
+    QVector<quint32> reversed( d->stride );
+    for ( int y = 0; y < d->height; y++ ) {
+        const quint32 *src = constScanLine( vertical? d->height - 1 - y: y );
+        quint32       *dst = result.scanLine( y );
+        if ( !horizontal ) {
+            memcpy( dst, src, d->stride * sizeof( quint32 ));
+            continue;
+        }
+        for ( int k = 0; k < d->stride; k++ )
+            reversed[ k ] = qbfReverseBits( src[ d->stride - 1 - k ] );
+        for ( int k = 0; k < d->stride; k++ )
+            dst[ k ] = qbfFetchBits( reversed.constData(), d->stride, ( k << 5 ) + pad );
+    }
+    return result;
+}
+
+
+/* Combine the source bitmap into this one with its top left corner at pos.
+ * Each destination word is produced from (at most) two source words, so the
+ * cost is proportional to the number of words touched, not to the number of
+ * pixels.
+ */
+void GlyphBitmap::blit( const QPoint &pos, const GlyphBitmap &source, RasterOp op )
+{
+    int lo = qMax( pos.x(), 0 );
+    int hi = qMin( pos.x() + source.width(), d->width );
+    if ( lo >= hi )
+        return;
+
+    int firstWord = lo >> 5;
+    int lastWord  = ( hi - 1 ) >> 5;
+    int y0 = qMax( pos.y(), 0 );
+    int y1 = qMin( pos.y() + source.height(), d->height );
+
+    for ( int y = y0; y < y1; y++ ) {
+        const quint32 *src = source.constScanLine( y - pos.y() );
+        quint32       *dst = scanLine( y );
+        for ( int k = firstWord; k <= lastWord; k++ ) {
+            quint32 mask = qbfSpanMask( k, lo, hi );
+            quint32 bits = qbfFetchBits( src, source.wordsPerLine(), ( k << 5 ) - pos.x() ) & mask;
+            switch ( op ) {
+                case Copy:   dst[ k ] = ( dst[ k ] & ~mask ) | bits; break;
+                case Or:     dst[ k ] |= bits;                      break;
+                case AndNot: dst[ k ] &= ~bits;                     break;
+                case Xor:    dst[ k ] ^= bits;                      break;
+            }
+        }
+    }
+}
+
+
+/* Shift the pixels in columns [lo, hi) of every row so that column x takes
+ * the old value of column x + delta.  Pixels shifted in from outside the
+ * range are blank; columns outside the range are not touched.
+ */
+void GlyphBitmap::shiftColumns( int lo, int hi, int delta )
+{
+    lo = qMax( lo, 0 );
+    hi = qMin( hi, d->width );
+    if ( lo >= hi || !delta )
+        return;
+
+    QVector<quint32> span( d->stride );
+    for ( int y = 0; y < d->height; y++ ) {
+        quint32 *row = scanLine( y );
+        for ( int k = 0; k < d->stride; k++ )
+            span[ k ] = row[ k ] & qbfSpanMask( k, lo, hi );
+        for ( int k = lo >> 5; k <= ( hi - 1 ) >> 5; k++ ) {
+            quint32 mask = qbfSpanMask( k, lo, hi );
+            quint32 bits = qbfFetchBits( span.constData(), d->stride, ( k << 5 ) + delta );
+            row[ k ] = ( row[ k ] & ~mask ) | ( bits & mask );
+        }
+    }
+}
+
+
+/* Shift rows [lo, hi) so that row y takes the old contents of row y + delta,
+ * blanking any row whose source lies outside the range.
+ */
+void GlyphBitmap::shiftRows( int lo, int hi, int delta )
+{
+    lo = qMax( lo, 0 );
+    hi = qMin( hi, d->height );
+    if ( lo >= hi || !delta )
+        return;
+
+    size_t bytes = d->stride * sizeof( quint32 );
+    if ( delta > 0 ) {
+        for ( int y = lo; y < hi; y++ ) {
+            if ( y + delta < hi )
+                memcpy( scanLine( y ), constScanLine( y + delta ), bytes );
+            else
+                memset( scanLine( y ), 0, bytes );
+        }
+    }
+    else {
+        for ( int y = hi - 1; y >= lo; y-- ) {
+            if ( y + delta >= lo )
+                memcpy( scanLine( y ), constScanLine( y + delta ), bytes );
+            else
+                memset( scanLine( y ), 0, bytes );
+        }
+    }
+}
+
+
+/* Return the smallest rectangle containing every set pixel, or a null
+ * rectangle if the bitmap is blank.  The rows are OR-reduced into a single
+ * row, whose first and last set bits give the horizontal bounds.
+ */
+QRect GlyphBitmap::inkBounds() const
+{
+    QVector<quint32> merged( d->stride, 0 );
+    int top = -1,
+        bottom = -1;
+
+    for ( int y = 0; y < d->height; y++ ) {
+        const quint32 *row = constScanLine( y );
+        quint32 any = 0;
+        for ( int k = 0; k < d->stride; k++ ) {
+            merged[ k ] |= row[ k ];
+            any |= row[ k ];
+        }
+        if ( any ) {
+            if ( top < 0 ) top = y;
+            bottom = y;
+        }
+    }
+    if ( top < 0 )
+        return QRect();
+
+    int left = 0,
+        right = 0;
+    for ( int k = 0; k < d->stride; k++ ) {
+        if ( merged[ k ] ) {
+            left = ( k << 5 ) + qbfLeadingZeros( merged[ k ] );
+            break;
+        }
+    }
+    for ( int k = d->stride - 1; k >= 0; k-- ) {
+        if ( merged[ k ] ) {
+            right = ( k << 5 ) + 31 - qbfTrailingZeros( merged[ k ] );
+            break;
+        }
+    }
+    return QRect( QPoint( left, top ), QPoint( right, bottom ));
+}
+
+
+// ---------------------------------------------------------------------------
+// CONVERSION
+//
+
+/* Convert to a Format_Mono image, which shares our MSB-first bit order, so
+ * that each row can be written out a byte at a time.
+ */
+QImage GlyphBitmap::toImage( QRgb on, QRgb off ) const
+{
+    QImage image( qMax( d->width, 1 ), qMax( d->height, 1 ), QImage::Format_Mono );
+    QVector<QRgb> colours;
+    colours << off << on;
+    image.setColorTable( colours );
+    image.fill( 0 );
+
+    int bytes = ( d->width + 7 ) / 8;
+    for ( int y = 0; y < d->height; y++ ) {
+        const quint32 *src = constScanLine( y );
+        uchar         *dst = image.scanLine( y );
+        for ( int i = 0; i < bytes; i++ )
+            dst[ i ] = (uchar)( src[ i >> 2 ] >> ( 24 - 8 * ( i & 3 )));
+    }
+    return image;
+}
+
+
+/* Convert an arbitrary image, treating any dark and mostly-opaque pixel as
+ * set.  Images of our own Mono format are converted a byte at a time.
+ */
+GlyphBitmap GlyphBitmap::fromImage( const QImage &image )
+{
+    GlyphBitmap bitmap( image.width(), image.height() );
+    if ( bitmap.isNull() )
+        return bitmap;
+
+    int stride = bitmap.wordsPerLine();
+    if ( image.format() == QImage::Format_Mono && image.colorCount() == 2 &&
+         qGray( image.color( 1 )) < qGray( image.color( 0 )))
+    {
+        int     bytes = ( image.width() + 7 ) / 8;
+        quint32 tail  = qbfSpanMask( stride - 1, 0, image.width() );
+        for ( int y = 0; y < image.height(); y++ ) {
+            const uchar *src = image.constScanLine( y );
+            quint32     *dst = bitmap.scanLine( y );
+            for ( int i = 0; i < bytes; i++ )
+                dst[ i >> 2 ] |= (quint32) src[ i ] << ( 24 - 8 * ( i & 3 ));
+            dst[ stride - 1 ] &= tail;
+        }
+        return bitmap;
+    }
+
+    QImage argb = image.convertToFormat( QImage::Format_ARGB32 );
+    for ( int y = 0; y < argb.height(); y++ ) {
+        const QRgb *src = (const QRgb *) argb.constScanLine( y );
+        quint32    *dst = bitmap.scanLine( y );
+        for ( int x = 0; x < argb.width(); x++ ) {
+            if ( qAlpha( src[ x ] ) >= 128 && qGray( src[ x ] ) < 128 )
+                dst[ x >> 5 ] |= qbfPixelBit( x );
+        }
+    }
+    return bitmap;
+}
+
+
+/* Font files store each glyph as strips eight pixels wide, left to right;
+ * each strip is one byte per row, top to bottom.  Four strips make up one
+ * word of each of our rows, so four rows at a time are converted with a
+ * byte transpose: a word of four rows becomes four bytes of each strip.
+ */
+QByteArray GlyphBitmap::toByteColumns() const
+{
+    int strips = ( d->width + 7 ) / 8;
+    QByteArray data( strips * d->height, 0 );
+    uchar *out = (uchar *) data.data();
+
+    for ( int word = 0; word < d->stride; word++ ) {
+        int      count = qMin( 4, strips - 4 * word );
+        uchar   *strip = out + 4 * word * d->height;
+        const quint32 *bits = d->bits.constData() + word;
+
+        int y = 0;
+        for ( ; y + 4 <= d->height; y += 4, bits += 4 * d->stride ) {
+            quint32 w[ 4 ] = { bits[ 0 ], bits[ d->stride ], bits[ 2 * d->stride ], bits[ 3 * d->stride ] };
+            qbfTransposeBytes( w[ 0 ], w[ 1 ], w[ 2 ], w[ 3 ] );
+            for ( int s = 0; s < count; s++ )
+                qToBigEndian<quint32>( w[ s ], strip + s * d->height + y );
+        }
+        for ( ; y < d->height; y++, bits += d->stride )
+            for ( int s = 0; s < count; s++ )
+                strip[ s * d->height + y ] = (uchar)( *bits >> ( 24 - 8 * s ));
+    }
+    return data;
+}
+
+
+/* The reverse of toByteColumns().  The data must hold (width + 7) / 8 strips
+ * of height bytes each.
+ */
+GlyphBitmap GlyphBitmap::fromByteColumns( const uchar *data, int width, int height )
+{
+    GlyphBitmap bitmap( width, height );
+    if ( bitmap.isNull() )
+        return bitmap;
+
+    int      strips = ( width + 7 ) / 8;
+    int      stride = bitmap.wordsPerLine();
+    quint32 *bits   = bitmap.d->bits.data();
+
+    for ( int word = 0; word < stride; word++ ) {
+        int          count = qMin( 4, strips - 4 * word );
+        const uchar *strip = data + 4 * word * height;
+        quint32     *row   = bits + word;
+
+        int y = 0;
+        for ( ; y + 4 <= height; y += 4, row += 4 * stride ) {
+            quint32 w[ 4 ] = { 0, 0, 0, 0 };
+            for ( int s = 0; s < count; s++ )
+                w[ s ] = qFromBigEndian<quint32>( strip + s * height + y );
+            qbfTransposeBytes( w[ 0 ], w[ 1 ], w[ 2 ], w[ 3 ] );
+            row[ 0 ]          = w[ 0 ];
+            row[ stride ]     = w[ 1 ];
+            row[ 2 * stride ] = w[ 2 ];
+            row[ 3 * stride ] = w[ 3 ];
+        }
+        for ( ; y < height; y++, row += stride )
+            for ( int s = 0; s < count; s++ )
+                *row |= (quint32) strip[ s * height + y ] << ( 24 - 8 * s );
+    }
+
+    quint32 tail = qbfSpanMask( stride - 1, 0, width );
+    for ( int y = 0; y < height; y++ )
+        bits[ y * stride + stride - 1 ] &= tail;
+    return bitmap;
+}
+
+
+/* The run-length form describes each row by the positions where the pixels
+ * change between blank and set, as gaps from the previous change; rows
+ * which repeat the previous row (or, at the top, are blank) are counted
+ * instead.  All numbers are stored seven bits to a byte, low bits first,
+ * with the top bit set on every byte but the last:
+ *
+ *   width, height, then for each row either
+ *     0, n           - the next n + 1 rows repeat the previous one
+ *     1, bytes...    - the row's pixels as they are, eight to a byte
+ *     k + 2, gaps... - the row changes colour k times
+ *
+ * The plain form is only used for rows too busy to gain anything from the
+ * runs.  A typical 32x32 glyph takes 30-60 bytes rather than 128, and a
+ * blank one just four.  Changes are found a word at a time by comparing
+ * each word with itself shifted right by one pixel.
+ */
+static inline void putNumber( QByteArray &out, uint value )
+{
+    while ( value >= 0x80 ) {
+        out.append( (char)( value | 0x80 ));
+        value >>= 7;
+    }
+    out.append( (char) value );
+}
+
+static inline bool getNumber( const uchar *&p, const uchar *end, uint &value )
+{
+    value = 0;
+    for ( int shift = 0; p < end && shift < 32; shift += 7 ) {
+        uchar byte = *p++;
+        value |= (uint)( byte & 0x7F ) << shift;
+        if ( !( byte & 0x80 ))
+            return true;
+    }
+    return false;
+}
+
+
+QByteArray GlyphBitmap::toRuns() const
+{
+    QByteArray out;
+    putNumber( out, d->width );
+    putNumber( out, d->height );
+
+    const quint32 *previous = 0;
+    int repeats = 0;
+    for ( int y = 0; y < d->height; y++ ) {
+        const quint32 *row = d->bits.constData() + y * d->stride;
+        bool same;
+        if ( previous )
+            same = memcmp( row, previous, d->stride * sizeof( quint32 )) == 0;
+        else {
+            same = true;
+            for ( int w = 0; w < d->stride && same; w++ )
+                same = ( row[ w ] == 0 );
+        }
+        previous = row;
+        if ( same ) {
+            repeats++;
+            continue;
+        }
+        if ( repeats ) {
+            putNumber( out, 0 );
+            putNumber( out, repeats - 1 );
+            repeats = 0;
+        }
+
+        // Pixel x differs from pixel x - 1 (pixel -1 being blank)
+        QVarLengthArray<int, 32> changes;
+        quint32 carry = 0;
+        for ( int w = 0; w < d->stride; w++ ) {
+            quint32 diff = row[ w ] ^ (( row[ w ] >> 1 ) | carry );
+            carry = row[ w ] << 31;
+            while ( diff ) {
+                int bit = qbfLeadingZeros( diff );
+                int x   = ( w << 5 ) + bit;
+                if ( x < d->width )
+                    changes.append( x );
+                diff &= ~qbfPixelBit( bit );
+            }
+        }
+        int bytes = ( d->width + 7 ) / 8;
+        if ( changes.size() >= bytes ) {
+            putNumber( out, 1 );
+            for ( int i = 0; i < bytes; i++ )
+                out.append( (char)( row[ i >> 2 ] >> ( 24 - 8 * ( i & 3 ))));
+            continue;
+        }
+        putNumber( out, changes.size() + 2 );
+        for ( int i = 0, last = 0; i < changes.size(); last = changes.at( i++ ))
+            putNumber( out, changes.at( i ) - last );
+    }
+    if ( repeats ) {
+        putNumber( out, 0 );
+        putNumber( out, repeats - 1 );
+    }
+    return out;
+}
+
+
+/* The reverse of toRuns().  Damaged data gives a null bitmap.
+ */
+GlyphBitmap GlyphBitmap::fromRuns( const uchar *data, int size )
+{
+    const uchar *p   = data;
+    const uchar *end = data + size;
+    uint width, height;
+    if ( !getNumber( p, end, width ) || !getNumber( p, end, height ) ||
+         width > 0xFFFF || height > 0xFFFF )
+        return GlyphBitmap();
+
+    GlyphBitmap bitmap( width, height );
+    int      stride = bitmap.d->stride;
+    quint32 *bits   = bitmap.d->bits.data();
+
+    for ( uint y = 0; y < height; ) {
+        uint token;
+        if ( !getNumber( p, end, token ))
+            return GlyphBitmap();
+
+        quint32 *row = bits + y * stride;
+        if ( token == 0 ) {
+            uint count;
+            if ( !getNumber( p, end, count ) || count >= height - y )
+                return GlyphBitmap();
+            for ( uint i = 0; i <= count; i++, y++ )
+                if ( y > 0 )
+                    memcpy( bits + y * stride, bits + ( y - 1 ) * stride, stride * sizeof( quint32 ));
+            continue;
+        }
+        if ( token == 1 ) {
+            uint bytes = ( width + 7 ) / 8;
+            if ( (uint)( end - p ) < bytes )
+                return GlyphBitmap();
+            for ( uint i = 0; i < bytes; i++ )
+                row[ i >> 2 ] |= (quint32) *p++ << ( 24 - 8 * ( i & 3 ));
+            row[ stride - 1 ] &= qbfSpanMask( stride - 1, 0, width );
+            y++;
+            continue;
+        }
+
+        // Each pair of changes bounds a span of set pixels
+        uint x = 0, start = 0;
+        for ( uint i = 2; i < token; i++ ) {
+            uint gap;
+            if ( !getNumber( p, end, gap ) || gap > width - x )
+                return GlyphBitmap();
+            x += gap;
+            if ( i & 1 )
+                for ( int w = start >> 5; w <= (int)( x - 1 ) >> 5; w++ )
+                    row[ w ] |= qbfSpanMask( w, start, x );
+            else
+                start = x;
+        }
+        if ( token & 1 )
+            for ( int w = start >> 5; w < stride; w++ )
+                row[ w ] |= qbfSpanMask( w, start, width );
+        y++;
+    }
+    return bitmap;
+}
+
+
+bool GlyphBitmap::operator==( const GlyphBitmap &other ) const
+{
+    if ( d == other.d )
+        return true;
+    return ( d->width == other.d->width ) &&
+           ( d->height == other.d->height ) &&
+           ( d->bits == other.d->bits );
+}
+
+
+/* Hash of the size and pixels, for finding identical bitmaps.
+ */
+uint qHash( const GlyphBitmap &bitmap )
+{
+    uint hash = ( bitmap.width() << 16 ) ^ bitmap.height();
+    for ( int y = 0; y < bitmap.height(); y++ ) {
+        const quint32 *row = bitmap.constScanLine( y );
+        for ( int k = 0; k < bitmap.wordsPerLine(); k++ )
+            hash = ( hash * 31 ) ^ row[ k ];
+    }
+    return hash;
+}
+
+
+// ---------------------------------------------------------------------------
+// SERIALIZATION
+//
+
+QDataStream &operator<<( QDataStream &out, const GlyphBitmap &bitmap )
+{
+    out << (quint16) bitmap.width() << (quint16) bitmap.height();
+    for ( int y = 0; y < bitmap.height(); y++ ) {
+        const quint32 *row = bitmap.constScanLine( y );
+        for ( int k = 0; k < bitmap.wordsPerLine(); k++ )
+            out << row[ k ];
+    }
+    return out;
+}
+
+
+QDataStream &operator>>( QDataStream &in, GlyphBitmap &bitmap )
+{
+    quint16 width, height;
+    in >> width >> height;
+    bitmap = GlyphBitmap( width, height );
+
+    quint32 tail = qbfSpanMask( bitmap.wordsPerLine() - 1, 0, width );
+    for ( int y = 0; y < bitmap.height(); y++ ) {
+        quint32 *row = bitmap.scanLine( y );
+        for ( int k = 0; k < bitmap.wordsPerLine(); k++ )
+            in >> row[ k ];
+        row[ bitmap.wordsPerLine() - 1 ] &= tail;
+    }
+    return in;
+}
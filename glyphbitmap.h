@@ -0,0 +1,132 @@
+/******************************************************************************
+** glyphbitmap.h
+**
+** Packed 1bpp glyph bitmap with implicit (copy-on-write) sharing.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHBITMAP_H
+#define GLYPHBITMAP_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QRect>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QVector>
+
+#include "qbf_bits.h"
+
+class QDataStream;
+
+
+class GlyphBitmapData : public QSharedData
+{
+public:
+    GlyphBitmapData(): width( 0 ), height( 0 ), stride( 0 ) {}
+
+    int              width;
+    int              height;
+    int              stride;        // 32-bit words per row
+    QVector<quint32> bits;
+};
+
+
+/* Each row is stored as a run of 32-bit words, leftmost pixel in the most
+ * significant bit.  Any padding bits to the right of the last pixel are
+ * always kept at zero, so that whole words may be compared, counted and
+ * scanned without masking.
+ */
+class GlyphBitmap
+{
+public:
+    enum RasterOp {
+        Copy,           // replace the destination area
+        Or,             // set destination pixels which are set in the source
+        AndNot,         // clear destination pixels which are set in the source
+        Xor
+    };
+
+    GlyphBitmap();
+    GlyphBitmap( int width, int height );
+
+    bool    isNull() const { return d->width == 0 || d->height == 0; }
+    int     width() const { return d->width; }
+    int     height() const { return d->height; }
+    int     wordsPerLine() const { return d->stride; }
+    QSize   size() const { return QSize( d->width, d->height ); }
+    QRect   rect() const { return QRect( 0, 0, d->width, d->height ); }
+
+    bool    pixel( int x, int y ) const;
+    void    setPixel( int x, int y, bool on );
+    void    fill( bool on );
+    void    fillRect( const QRect &area, bool on );
+    void    drawLine( const QPoint &from, const QPoint &to, bool on );
+    void    drawRect( const QRect &area, bool on );
+    void    drawEllipse( const QRect &area, bool on, bool filled );
+    QRect   floodFill( const QPoint &seed, bool on );
+    bool    isBlank() const;
+
+    // Word-wise set operations; the other bitmap should be the same size.
+    void    unite( const GlyphBitmap &other );
+    void    intersect( const GlyphBitmap &other );
+    void    subtract( const GlyphBitmap &other );
+    void    invert();
+    void    merge( const GlyphBitmap &changed, const GlyphBitmap &mask );
+
+    quint32       *scanLine( int y );
+    const quint32 *constScanLine( int y ) const;
+
+    GlyphBitmap copy( const QRect &area ) const;
+    GlyphBitmap mirrored( bool horizontal, bool vertical ) const;
+    void        blit( const QPoint &pos, const GlyphBitmap &source, RasterOp op );
+    void        shiftColumns( int lo, int hi, int delta );
+    void        shiftRows( int lo, int hi, int delta );
+    QRect       inkBounds() const;
+
+    QImage      toImage( QRgb on = qRgb( 0, 0, 0 ), QRgb off = qRgb( 255, 255, 255 )) const;
+    static GlyphBitmap fromImage( const QImage &image );
+
+    // Column-major byte strips, as used in OS/2 and Windows font files
+    QByteArray  toByteColumns() const;
+    static GlyphBitmap fromByteColumns( const uchar *data, int width, int height );
+
+    // Compact run-length form, as kept by GlyphStore
+    QByteArray  toRuns() const;
+    static GlyphBitmap fromRuns( const uchar *data, int size );
+
+    bool operator==( const GlyphBitmap &other ) const;
+    bool operator!=( const GlyphBitmap &other ) const { return !( *this == other ); }
+
+    // Whether the pixel data is shared (copy-on-write) with the given bitmap
+    bool    isSharedWith( const GlyphBitmap &other ) const { return d == other.d; }
+
+private:
+    enum SetOp { Unite, Intersect, Subtract };
+    void combine( const GlyphBitmap &other, SetOp op );
+
+    QSharedDataPointer<GlyphBitmapData> d;
+};
+
+uint qHash( const GlyphBitmap &bitmap );
+
+QDataStream &operator<<( QDataStream &out, const GlyphBitmap &bitmap );
+QDataStream &operator>>( QDataStream &in, GlyphBitmap &bitmap );
+
+#endif  // GLYPHBITMAP_H
@@ -0,0 +1,132 @@
+/******************************************************************************
+** glyphclipboard.cpp
+**
+** Clipboard transfer and compositing of packed glyph bitmap blocks.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "glyphclipboard.h"
+
+// Identifies our clipboard data stream ("QBFB") and its layout version.
+#define CLIP_MAGIC      0x51424642
+#define CLIP_VERSION    1
+
+
+// ---------------------------------------------------------------------------
+// Place one or more bitmap blocks on the clipboard.  The blocks are stored
+// in packed form under our own MIME type; the first block is also offered
+// as an image so that it can be pasted into other applications.
+//
+void GlyphClipboard::setBitmaps( const QList<GlyphBitmap> &blocks )
+{
+    if ( blocks.isEmpty() )
+        return;
+
+    QByteArray  data;
+    QDataStream out( &data, QIODevice::WriteOnly );
+    out << (quint32) CLIP_MAGIC << (quint16) CLIP_VERSION << (quint32) blocks.size();
+    for ( int i = 0; i < blocks.size(); i++ )
+        out << blocks.at( i );
+
+    QMimeData *mime = new QMimeData();
+    mime->setData( GLYPH_MIME_TYPE, data );
+    mime->setImageData( blocks.first().toImage() );
+    QApplication::clipboard()->setMimeData( mime );
+}
+
+
+// ---------------------------------------------------------------------------
+// Retrieve the bitmap blocks from the clipboard.  If there is no packed data
+// but there is an image (e.g. copied from another program), it is converted
+// into a single block.
+//
+QList<GlyphBitmap> GlyphClipboard::bitmaps()
+{
+    QList<GlyphBitmap> blocks;
+    const QMimeData *mime = QApplication::clipboard()->mimeData();
+    if ( !mime )
+        return blocks;
+
+    if ( mime->hasFormat( GLYPH_MIME_TYPE )) {
+        QByteArray  data = mime->data( GLYPH_MIME_TYPE );
+        QDataStream in( data );
+        quint32 magic, count;
+        quint16 version;
+        in >> magic >> version >> count;
+        if ( magic == CLIP_MAGIC && version == CLIP_VERSION ) {
+            for ( quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++ ) {
+                GlyphBitmap block;
+                in >> block;
+                if ( in.status() == QDataStream::Ok )
+                    blocks.append( block );
+            }
+            return blocks;
+        }
+    }
+    if ( mime->hasImage() ) {
+        QImage image = qvariant_cast<QImage>( mime->imageData() );
+        if ( !image.isNull() )
+            blocks.append( GlyphBitmap::fromImage( image ));
+    }
+    return blocks;
+}
+
+
+bool GlyphClipboard::hasBitmaps()
+{
+    const QMimeData *mime = QApplication::clipboard()->mimeData();
+    return mime && ( mime->hasFormat( GLYPH_MIME_TYPE ) || mime->hasImage() );
+}
+
+
+// ---------------------------------------------------------------------------
+// Composite a block into the target bitmap at the given position.  A normal
+// paste clears the area covered by the block (AND-NOT) and then ORs in the
+// block's pixels; a mask paste only does the OR.
+//
+void GlyphClipboard::composite( GlyphBitmap &target, const GlyphBitmap &block, const QPoint &pos, PasteMode mode )
+{
+    target.blit( pos, block, ( mode == Mask )? GlyphBitmap::Or: GlyphBitmap::Copy );
+}
+
+
+// ---------------------------------------------------------------------------
+// Composite the clipboard blocks into a range of glyphs in one pass.  If
+// there is a single block, it is applied to every glyph in the range;
+// otherwise consecutive blocks go into consecutive glyphs, starting at
+// 'first', until either the blocks or the range run out.
+//
+void GlyphClipboard::compositeRange( QVector<GlyphBitmap> &targets, int first, int count,
+                                     const QList<GlyphBitmap> &blocks, const QPoint &pos,
+                                     PasteMode mode )
+{
+    if ( blocks.isEmpty() || first < 0 )
+        return;
+
+    int last = qMin( first + count, targets.size() );
+    if ( blocks.size() > 1 )
+        last = qMin( last, first + blocks.size() );
+
+    for ( int i = first; i < last; i++ ) {
+        const GlyphBitmap &block = ( blocks.size() == 1 )? blocks.first(): blocks.at( i - first );
+        composite( targets[ i ], block, pos, mode );
+    }
+}
@@ -0,0 +1,50 @@
+/******************************************************************************
+** glyphclipboard.h
+**
+** Clipboard transfer and compositing of packed glyph bitmap blocks.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHCLIPBOARD_H
+#define GLYPHCLIPBOARD_H
+
+#include <QList>
+#include <QPoint>
+#include <QVector>
+
+#include "glyphbitmap.h"
+
+#define GLYPH_MIME_TYPE     "application/x-qbfont-bitmaps"
+
+
+namespace GlyphClipboard {
+    enum PasteMode {
+        Replace,        // the block replaces everything under it
+        Mask            // only the set pixels of the block are applied
+    };
+
+    void               setBitmaps( const QList<GlyphBitmap> &blocks );
+    QList<GlyphBitmap> bitmaps();
+    bool               hasBitmaps();
+
+    void composite( GlyphBitmap &target, const GlyphBitmap &block, const QPoint &pos, PasteMode mode );
+    void compositeRange( QVector<GlyphBitmap> &targets, int first, int count, const QList<GlyphBitmap> &blocks, const QPoint &pos, PasteMode mode );
+};
+
+#endif  // GLYPHCLIPBOARD_H
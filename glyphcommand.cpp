@@ -0,0 +1,84 @@
+/******************************************************************************
+** glyphcommand.cpp
+**
+** Undoable changes to the glyphs of a font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include "glyphcommand.h"
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+GlyphBatchCommand::GlyphBatchCommand( FontDocument *document, const QList< QPair<int, GlyphBitmap> > &changes,
+                                      const QString &text, QUndoCommand *parent ):
+    QUndoCommand( text, parent ), doc( document ), after( changes ), iApplied( 0 )
+{
+    for ( int i = 0; i < after.size(); i++ )
+        before.append( qMakePair( after.at( i ).first, document->glyph( after.at( i ).first )));
+}
+
+
+GlyphBatchCommand::GlyphBatchCommand( FontDocument *document, int index, const GlyphBitmap &oldGlyph,
+                                      const GlyphBitmap &newGlyph, const QString &text, QUndoCommand *parent ):
+    QUndoCommand( text, parent ), doc( document ), iApplied( 0 )
+{
+    before.append( qMakePair( index, oldGlyph ));
+    after.append( qMakePair( index, newGlyph ));
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+void GlyphBatchCommand::undo()
+{
+    apply( after, before );
+}
+
+
+void GlyphBatchCommand::redo()
+{
+    apply( before, after );
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+void GlyphBatchCommand::apply( const QList< QPair<int, GlyphBitmap> > &from,
+                               const QList< QPair<int, GlyphBitmap> > &to )
+{
+    iApplied = 0;
+    if ( !doc )
+        return;
+
+    QList< QPair<int, GlyphBitmap> > batch;
+    for ( int i = 0; i < to.size(); i++ ) {
+        int index = to.at( i ).first;
+        if ( index < doc->glyphCount() && doc->glyph( index ) == from.at( i ).second )
+            batch.append( to.at( i ));
+    }
+    doc->setGlyphBatch( batch );
+    iApplied = batch.size();
+}
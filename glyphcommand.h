@@ -0,0 +1,68 @@
+/******************************************************************************
+** glyphcommand.h
+**
+** Undoable changes to the glyphs of a font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHCOMMAND_H
+#define GLYPHCOMMAND_H
+
+#include <QList>
+#include <QPair>
+#include <QPointer>
+#include <QUndoCommand>
+
+#include "fontdocument.h"
+
+
+/* Replaces a set of glyphs as one undo step, for operations on the whole
+ * font.  The old and new bitmaps share their data with the document, so a
+ * step costs little more than the list.  Glyphs edited since the step was
+ * done or undone are left alone, rather than losing those edits.
+ *
+ * The second constructor records an edit of one glyph whose old bitmap is
+ * already known, such as one made in the editor.  If the document already
+ * holds the new bitmap, the first redo() changes nothing.
+ */
+class GlyphBatchCommand : public QUndoCommand
+{
+public:
+    GlyphBatchCommand( FontDocument *document, const QList< QPair<int, GlyphBitmap> > &changes,
+                       const QString &text, QUndoCommand *parent = 0 );
+    GlyphBatchCommand( FontDocument *document, int index, const GlyphBitmap &oldGlyph,
+                       const GlyphBitmap &newGlyph, const QString &text, QUndoCommand *parent = 0 );
+
+    int     count() const { return after.size(); }
+    int     applied() const { return iApplied; }     // glyphs changed by the last undo or redo
+
+    void    undo();
+    void    redo();
+
+private:
+    void    apply( const QList< QPair<int, GlyphBitmap> > &from,
+                   const QList< QPair<int, GlyphBitmap> > &to );
+
+    QPointer<FontDocument>           doc;
+    QList< QPair<int, GlyphBitmap> > before;
+    QList< QPair<int, GlyphBitmap> > after;
+    int                              iApplied;
+};
+
+#endif  // GLYPHCOMMAND_H
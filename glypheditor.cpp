@@ -22,8 +22,10 @@
 ******************************************************************************/
 
 #include <QtGui>
+#include <qmath.h>
 
 #include "glypheditor.h"
+#include "glyphclipboard.h"
 
 // ---------------------------------------------------------------------------
 // PUBLIC CONSTRUCTOR
@@ -37,15 +39,27 @@ GlyphEditor::GlyphEditor( QWidget *parent ): QWidget( parent )
 
     curPosition = QPoint( 0, 0 );
     curSelection = QRect( 0, 0, 0, 0 );
+    selOp = SelectReplace;
+    strokeMode = NoStroke;
+    currentTool = PenTool;
+    bShapeInk = true;
+
+    // Coalesces mouse movements into one update per frame (about 60 Hz)
+    strokeTimer = new QTimer( this );
+    strokeTimer->setSingleShot( true );
+    strokeTimer->setInterval( 16 );
+    connect( strokeTimer, SIGNAL( timeout() ), this, SLOT( flushStroke() ));
     iBaseLine = 8;
     bChoiceOn = false;
     bSelectionOn = false;
 
-    image = QImage( 32, 32, QImage::Format_ARGB32_Premultiplied );
+    glyph = GlyphBitmap( 32, 32 );
+    selMask = GlyphBitmap( 32, 32 );
     clear();
 
-    iZoom = width() / image.width();
+    iZoom = width() / glyph.width();
     bChanged = false;
+    editBase = glyph;
 }
 
 
@@ -61,26 +75,25 @@ void GlyphEditor::paintEvent( QPaintEvent *event )
 
     if ( showGrid() ) {
         painter.setPen( Qt::lightGray );
-        for ( int i = 0; i <= image.width(); ++i )
+        for ( int i = 0; i <= glyph.width(); ++i )
             painter.drawLine( iZoom * i, 0,
-                              iZoom * i, iZoom * image.height() );
-        for ( int j = 0; j <= image.height(); ++j ) {
-            if ( j == ( image.height() - iBaseLine ))
+                              iZoom * i, iZoom * glyph.height() );
+        for ( int j = 0; j <= glyph.height(); ++j ) {
+            if ( j == ( glyph.height() - iBaseLine ))
                 painter.setPen( QColor("royalBlue"));
             else
                 painter.setPen( Qt::lightGray );
             painter.drawLine( 0, iZoom * j,
-                              iZoom * image.width(), iZoom * j );
+                              iZoom * glyph.width(), iZoom * j );
         }
     }
 
-    for ( int i = 0; i < image.width(); ++i ) {
-        for ( int j = 0; j < image.height(); ++j ) {
+    for ( int i = 0; i < glyph.width(); ++i ) {
+        for ( int j = 0; j < glyph.height(); ++j ) {
             QRect rect = pixelRect( i, j );
             if ( !event->region().intersect( rect ).isEmpty() ) {
-                QColor pixelColor = QColor::fromRgba( image.pixel( i, j ));
-                QColor paintColor = pixelColor.value()? Qt::white: Qt::black;
-                if ( curSelection.contains( i, j )) {
+                QColor paintColor = glyph.pixel( i, j )? Qt::black: Qt::white;
+                if ( bSelectionOn && selMask.pixel( i, j )) {
                     paintColor.setAlpha( 127 );
                     paintColor.setBlue( 127 );
                 }
@@ -93,60 +106,79 @@ void GlyphEditor::paintEvent( QPaintEvent *event )
 
 void GlyphEditor::mousePressEvent( QMouseEvent *event )
 {
-    if ( event->button() == Qt::LeftButton ) {
+    flushStroke();
+
+    bool left = ( event->button() == Qt::LeftButton );
+    if ( !left && event->button() != Qt::RightButton )
+        return;
+
+    if ( !bSelectionOn && currentTool == FillTool ) {
+        applyFill( event->pos(), left );
+        return;
+    }
+    if ( !bSelectionOn && currentTool != PenTool ) {
+        // Shapes are drawn from the press to the release, left to set pixels and right to clear
+        strokeMode  = ShapeStroke;
+        shapeBase   = glyph;
+        shapeAnchor = cellAt( event->pos() );
+        shapeCells  = QRect();
+        bShapeInk   = left;
+        drawShape( shapeAnchor );
+        return;
+    }
+
+    if ( left ) {
+        strokeMode = bSelectionOn? SelectStroke: DrawStroke;
         if ( bSelectionOn )
-            startSelection( event->pos() );
+            startSelection( event->pos(), event->modifiers() );
         else
             setImagePixel( event->pos(), true );
     }
-    else if ( event->button() == Qt::RightButton ) {
+    else {
+        strokeMode = bSelectionOn? SelectStroke: EraseStroke;
         if ( bSelectionOn )
             expandSelection( event->pos() );
         else
             setImagePixel( event->pos(), false );
     }
+    strokeCell = strokeCellAt( event->pos() );
 }
 
 
+/* Mouse movements are only queued here; they are processed together by
+ * flushStroke() once per frame, however many events arrive in between.
+ */
 void GlyphEditor::mouseMoveEvent( QMouseEvent *event )
 {
-    QPoint newPos;
-    int cellX,
-        cellY;
-
-    if ( event->buttons() & Qt::LeftButton ) {
-        if ( bSelectionOn ) {
-            expandSelection( event->pos() );
-        }
-        else
-            setImagePixel( event->pos(), true );
-    }
-    else if ( event->buttons() & Qt::RightButton )
-        setImagePixel( event->pos(), false );
+    if ( strokeMode != NoStroke )
+        pendingPoints.append( event->pos() );
+    lastPointerPos = event->pos();
+    if ( !strokeTimer->isActive() )
+        strokeTimer->start();
+}
 
-    // Translate mouse position into cell coordinates
-    if ( showGrid() ) {
-        cellX = ( 1 + event->pos().x() ) / iZoom;
-        cellY = ( 1 + event->pos().y() ) / iZoom;
-    }
-    else {
-        cellX = event->pos().x() / iZoom;
-        cellY = event->pos().y() / iZoom;
-    }
 
-    // Now convert the coordinates so that bottom left is (1, 1)
-    newPos.setX( cellX >= image.width() ? image.width() : 1 + cellX );
-    newPos.setY( cellY >= image.height() ? 1 : image.height() - cellY );
-    if ( newPos != curPosition ) {
-        curPosition = newPos;
-        emit positionChanged( curPosition );
+void GlyphEditor::mouseReleaseEvent( QMouseEvent *event )
+{
+    Q_UNUSED( event );
+    flushStroke();
+    if ( strokeMode == ShapeStroke ) {
+        bool changed = ( glyph != shapeBase );
+        shapeBase = GlyphBitmap();
+        if ( changed )
+            finishTool();
     }
+    else if ( strokeMode == DrawStroke )
+        commitEdit( tr("Draw") );
+    else if ( strokeMode == EraseStroke )
+        commitEdit( tr("Erase") );
+    strokeMode = NoStroke;
 }
 
 
 void GlyphEditor::resizeEvent( QResizeEvent *event )
 {
-    iZoom = std::min( width() / image.width(), height() / image.height() );
+    iZoom = std::min( width() / glyph.width(), height() / glyph.height() );
 }
 
 
@@ -156,7 +188,7 @@ void GlyphEditor::resizeEvent( QResizeEvent *event )
 
 QSize GlyphEditor::sizeHint() const
 {
-    QSize size = iZoom * image.size();
+    QSize size = iZoom * glyph.size();
     if ( showGrid() )
         size += QSize( 1, 1 );
     return size;
@@ -167,18 +199,42 @@ QSize GlyphEditor::sizeHint() const
 // OTHER PUBLIC METHODS
 //
 
+/* Most of the following operations act only on the selected pixels when
+ * there is a selection.  The operation is applied to a copy holding just
+ * the selected pixels, and the result is merged back through the selection
+ * mask; both steps work a row of words at a time, so a selection-scoped
+ * edit costs the same as a whole-glyph one.
+ */
+
 void GlyphEditor::clear()
 {
-    image.fill( rgbOff );
+    if ( hasSelection() )
+        glyph.subtract( selMask );
+    else
+        glyph.fill( false );
     setModified( true );
     update();
 }
 
 
+/* Mirror the glyph or, if there is a selection, mirror the selected pixels
+ * within the selection's bounding rectangle.
+ */
 void GlyphEditor::mirror( Qt::Orientation direction )
 {
-	setGlyphImage( image.mirrored( direction & Qt::Horizontal,
-	                               direction & Qt::Vertical   ));
+    bool horizontal = direction & Qt::Horizontal;
+    bool vertical   = direction & Qt::Vertical;
+
+    if ( hasSelection() ) {
+        QRect area = selMask.inkBounds();
+        GlyphBitmap moved( glyph.width(), glyph.height() );
+        moved.blit( area.topLeft(),
+                    selectedPixels().copy( area ).mirrored( horizontal, vertical ),
+                    GlyphBitmap::Copy );
+        glyph.merge( moved, selMask );
+    }
+    else
+        glyph = glyph.mirrored( horizontal, vertical );
     setModified( true );
     update();
 }
@@ -190,21 +246,16 @@ void GlyphEditor::mirror( Qt::Orientation direction )
 void GlyphEditor::insertColumnShiftLeft( int pos, bool widen )
 {
     if ( widen ) {
-        QImage newImage = image.copy( 0, 0, image.width()+1, image.height() );
-        image = newImage;
+        // Widening always applies to the whole glyph, selection included
+        glyph = glyph.copy( QRect( 0, 0, glyph.width()+1, glyph.height() ));
+        selMask = selMask.copy( glyph.rect() );
+        glyph.shiftColumns( 0, pos+1, 1 );
+        selMask.shiftColumns( 0, pos+1, 1 );
         updateGeometry();
     }
-
-    for ( int y = 0; y < image.height(); y++ ) {
-        QRgb *row = (QRgb *) image.scanLine( y );
-        for ( int x = 0; x < image.width(); x++ ) {
-            if ( x < pos )
-                row[ x ] = row[ x+1 ];
-            else if ( x == pos )
-                row[ x ] = rgbOff;
-            // else leave pixel unchanged
-        }
-    }
+    else
+        shiftScoped( Qt::Horizontal, 0, pos+1, 1 );
+    setModified( true );
     update();
 }
 
@@ -215,40 +266,28 @@ void GlyphEditor::insertColumnShiftLeft( int pos, bool widen )
 void GlyphEditor::insertColumnShiftRight( int pos, bool widen )
 {
     if ( widen ) {
-        QImage newImage = image.copy( 0, 0, image.width()+1, image.height() );
-        image = newImage;
+        glyph = glyph.copy( QRect( 0, 0, glyph.width()+1, glyph.height() ));
+        selMask = selMask.copy( glyph.rect() );
+        glyph.shiftColumns( pos, glyph.width(), -1 );
+        selMask.shiftColumns( pos, glyph.width(), -1 );
         updateGeometry();
     }
-
-    for ( int y = 0; y < image.height(); y++ ) {
-        QRgb *row = (QRgb *) image.scanLine( y );
-        for ( int x = image.width()-1; x >= 0; x-- ) {
-            if ( x > pos )
-                row[ x ] = row[ x-1 ];
-            else if ( x == pos )
-                row[ x ] = rgbOff;
-            // else leave pixel unchanged
-        }
-    }
+    else
+        shiftScoped( Qt::Horizontal, pos, glyph.width(), -1 );
+    setModified( true );
     update();
 }
 
 
 void GlyphEditor::widenLeftAndRight()
 {
-    // Add two columns
-    QImage newImage = image.copy( 0, 0, image.width()+2, image.height() );
-    image = newImage;
+    // Add two (blank) columns on the right, then shift everything right by 1
+    glyph = glyph.copy( QRect( 0, 0, glyph.width()+2, glyph.height() ));
+    selMask = selMask.copy( glyph.rect() );
     updateGeometry();
-
-    // Shift everything right by 1 and clear the left- and right-most columns
-    for ( int y = 0; y < image.height(); y++ ) {
-        QRgb *row = (QRgb *) image.scanLine( y );
-        for ( int x = image.width()-2; x > 0; x-- )
-            row[ x ] = row[ x-1 ];
-        row[ 0 ] = rgbOff;
-        row[ image.width()-1 ] = rgbOff;
-    }
+    glyph.shiftColumns( 0, glyph.width(), -1 );
+    selMask.shiftColumns( 0, glyph.width(), -1 );
+    setModified( true );
     update();
 }
 
@@ -258,37 +297,16 @@ void GlyphEditor::widenLeftAndRight()
  */
 void GlyphEditor::insertRowDown( int pos )
 {
-    for ( int y = image.height()-1; y >= 0; y-- ) {
-        QRgb *row = (QRgb *) image.scanLine( y );
-        QRgb *prevRow = NULL;
-        if (( y > pos ) && ( y > 0 ))
-            prevRow = (QRgb *) image.scanLine( y-1 );
-        for ( int x = 0; x < image.width(); x++ ) {
-            if ( prevRow )
-                row[ x ] = prevRow[ x ];
-            else if ( y >= pos )
-                row[ x ] = rgbOff;
-            // else leave pixel unchanged
-        }
-    }
+    shiftScoped( Qt::Vertical, pos, glyph.height(), -1 );
+    setModified( true );
     update();
 }
 
 
 void GlyphEditor::insertRowUp( int pos )
 {
-    for ( int y = 0; y < image.height(); y++ ) {
-        QRgb *row = (QRgb *) image.scanLine( y );
-        for ( int x = 0; x < image.width(); x++ ) {
-            if (( y < pos ) && (( y+1 ) < image.height() )) {
-                QRgb *nextRow = (QRgb *) image.scanLine( y+1 );
-                row[ x ] = nextRow[ x ];
-            }
-            else if ( y <= pos )
-                row[ x ] = rgbOff;
-            // else leave pixel unchanged
-        }
-    }
+    shiftScoped( Qt::Vertical, 0, pos+1, 1 );
+    setModified( true );
     update();
 }
 
@@ -296,7 +314,64 @@ void GlyphEditor::insertRowUp( int pos )
 void GlyphEditor::selectAll()
 {
     bSelectionOn = true;
-    curSelection.setCoords( 0, 0, image.width(), image.height() );
+    curSelection = glyph.rect();
+    selMask.fill( true );
+    setCursor( Qt::CrossCursor );
+    update();
+}
+
+
+void GlyphEditor::invertSelection()
+{
+    bSelectionOn = true;
+    selMask.invert();
+    setCursor( Qt::CrossCursor );
+    update();
+}
+
+
+bool GlyphEditor::hasSelection() const
+{
+    return bSelectionOn && !selMask.isBlank();
+}
+
+
+/* Return the bounding rectangle of the selection; if nothing is selected,
+ * this is the whole glyph.
+ */
+QRect GlyphEditor::selectionRect() const
+{
+    if ( !hasSelection() )
+        return glyph.rect();
+    return selMask.inkBounds();
+}
+
+
+/* Return the selected pixels, cropped to the selection's bounding rectangle;
+ * pixels which lie within that rectangle but outside the selection are blank.
+ */
+GlyphBitmap GlyphEditor::copySelection() const
+{
+    if ( !hasSelection() )
+        return glyph;
+    return selectedPixels().copy( selectionRect() );
+}
+
+
+void GlyphEditor::cutSelection()
+{
+    clear();
+}
+
+
+/* Paste a bitmap block at the top left of the selection (or of the glyph,
+ * if there is no selection).
+ */
+void GlyphEditor::pasteBlock( const GlyphBitmap &block, bool asMask )
+{
+    GlyphClipboard::composite( glyph, block, selectionRect().topLeft(),
+                               asMask? GlyphClipboard::Mask: GlyphClipboard::Replace );
+    setModified( true );
     update();
 }
 
@@ -307,11 +382,23 @@ void GlyphEditor::selectAll()
 
 void GlyphEditor::setGlyphImage( const QImage &newImage )
 {
-    if ( newImage != image ) {
-        image = newImage.convertToFormat( QImage::Format_ARGB32_Premultiplied );
-        update();
-        updateGeometry();
-    }
+    setGlyphBitmap( GlyphBitmap::fromImage( newImage ));
+}
+
+
+QImage GlyphEditor::glyphImage() const
+{
+    return glyph.toImage( rgbOn, rgbOff ).convertToFormat( QImage::Format_ARGB32_Premultiplied );
+}
+
+
+/* A glyph set from outside (another glyph being shown, or the current one
+ * changed by an undo) is where the next edit starts from.
+ */
+void GlyphEditor::setGlyphBitmap( const GlyphBitmap &newGlyph )
+{
+    replaceGlyph( newGlyph );
+    editBase = glyph;
 }
 
 
@@ -337,17 +424,33 @@ void GlyphEditor::setBaseLine( int offset )
 
 void GlyphEditor::setIncrement( int increment )
 {
-    QImage newImage = image.copy( 0, 0, increment, image.height() );
-    setGlyphImage( newImage );
+    replaceGlyph( glyph.copy( QRect( 0, 0, increment, glyph.height() )));
+    setModified( true );
     update();
     updateGeometry();
 }
 
 
+void GlyphEditor::setTool( Tool tool )
+{
+    // A shape still being dragged out is abandoned
+    flushStroke();
+    if ( strokeMode == ShapeStroke ) {
+        glyph = shapeBase;
+        update();
+    }
+    else if ( strokeMode == DrawStroke || strokeMode == EraseStroke )
+        commitEdit( tr("Draw") );
+    strokeMode  = NoStroke;
+    currentTool = tool;
+}
+
+
 void GlyphEditor::setSelectMode( bool on )
 {
     bSelectionOn = on;
     curSelection = QRect( 0, 0, 0, 0 );
+    selMask.fill( false );
     if ( on )
         setCursor( Qt::CrossCursor );
     else
@@ -361,9 +464,113 @@ void GlyphEditor::setSelectMode( bool on )
 // PRIVATE METHODS
 //
 
+/* Process the mouse movements queued since the last frame.  Consecutive
+ * samples are joined with Bresenham lines so that fast drags leave no gaps;
+ * the repaint, the modified signal and the position update are each issued
+ * once for the whole batch.
+ */
+void GlyphEditor::flushStroke()
+{
+    strokeTimer->stop();
+
+    if ( strokeMode == SelectStroke ) {
+        if ( !pendingPoints.isEmpty() )
+            expandSelection( pendingPoints.last() );
+    }
+    else if ( strokeMode == ShapeStroke ) {
+        if ( !pendingPoints.isEmpty() )
+            drawShape( cellAt( pendingPoints.last() ));
+    }
+    else if ( strokeMode != NoStroke && !pendingPoints.isEmpty() ) {
+        bool  on = ( strokeMode == DrawStroke );
+        QRect damage;
+        for ( int i = 0; i < pendingPoints.size(); i++ ) {
+            QPoint cell = strokeCellAt( pendingPoints.at( i ));
+            if ( cell == strokeCell )
+                continue;
+            glyph.drawLine( strokeCell, cell, on );
+            damage |= QRect( QPoint( qMin( strokeCell.x(), cell.x() ), qMin( strokeCell.y(), cell.y() )),
+                             QPoint( qMax( strokeCell.x(), cell.x() ), qMax( strokeCell.y(), cell.y() )));
+            strokeCell = cell;
+        }
+        damage &= glyph.rect();
+        if ( !damage.isEmpty() ) {
+            update( pixelRect( damage.left(), damage.top() ) |
+                    pixelRect( damage.right(), damage.bottom() ));
+            setModified( true );
+        }
+    }
+    pendingPoints.clear();
+    updatePosition( lastPointerPos );
+}
+
+
+/* Report the cell under the pointer, in font coordinates (the bottom left
+ * cell being (1, 1)), if it has changed.
+ */
+void GlyphEditor::updatePosition( const QPoint &pos )
+{
+    QPoint newPos;
+    int cellX,
+        cellY;
+
+    // Translate mouse position into cell coordinates
+    if ( showGrid() ) {
+        cellX = ( 1 + pos.x() ) / iZoom;
+        cellY = ( 1 + pos.y() ) / iZoom;
+    }
+    else {
+        cellX = pos.x() / iZoom;
+        cellY = pos.y() / iZoom;
+    }
+
+    // Now convert the coordinates so that bottom left is (1, 1)
+    newPos.setX( cellX >= glyph.width() ? glyph.width() : 1 + cellX );
+    newPos.setY( cellY >= glyph.height() ? 1 : glyph.height() - cellY );
+    if ( newPos != curPosition ) {
+        curPosition = newPos;
+        emit positionChanged( curPosition );
+    }
+}
+
+
+/* Each change other than a drag is signalled as an edit of its own; a pen
+ * stroke or shape is signalled once the mouse button is released.
+ */
 void GlyphEditor::setModified( bool modified )
 {
     bChanged = modified;
+    if ( !modified )
+        return;
+    if ( strokeMode == NoStroke || strokeMode == SelectStroke )
+        commitEdit( tr("Edit glyph") );
+    emit contentsChanged();
+}
+
+
+void GlyphEditor::replaceGlyph( const GlyphBitmap &newGlyph )
+{
+    if ( newGlyph != glyph ) {
+        if ( newGlyph.size() != glyph.size() )
+            selMask = selMask.copy( newGlyph.rect() );
+        glyph = newGlyph;
+        update();
+        updateGeometry();
+    }
+}
+
+
+/* Signal everything done to the glyph since the last edit as one change,
+ * with the glyph as it was before, for the caller to record as an undo
+ * step.
+ */
+void GlyphEditor::commitEdit( const QString &description )
+{
+    if ( glyph == editBase )
+        return;
+    GlyphBitmap before = editBase;
+    editBase = glyph;
+    emit editFinished( description, before );
 }
 
 
@@ -372,11 +579,8 @@ void GlyphEditor::setImagePixel( const QPoint &pos, bool opaque )
     int i = pos.x() / iZoom;
     int j = pos.y() / iZoom;
 
-    if ( image.rect().contains( i, j )) {
-        if ( opaque )
-            image.setPixel( i, j, rgbOn );
-        else
-            image.setPixel( i, j, rgbOff );
+    if ( glyph.rect().contains( i, j )) {
+        glyph.setPixel( i, j, opaque );
 
         update( pixelRect( i, j ));
         setModified( true );
@@ -384,23 +588,180 @@ void GlyphEditor::setImagePixel( const QPoint &pos, bool opaque )
 }
 
 
-void GlyphEditor::startSelection( const QPoint &pos )
+/* Fill the area around the cell under the pointer, repainting just the
+ * rectangle the fill changed.
+ */
+void GlyphEditor::applyFill( const QPoint &pos, bool on )
 {
-    int i = pos.x() / iZoom;
-    int j = pos.y() / iZoom;
+    QPoint cell( pos.x() / iZoom, pos.y() / iZoom );
+    if ( !glyph.rect().contains( cell ))
+        return;
+
+    QRect damage = glyph.floodFill( cell, on );
+    if ( damage.isEmpty() )
+        return;
+    updateCells( damage );
+    finishTool();
+}
 
-    curSelection = QRect( i, j, 1, 1 );
-    update();
+
+/* Redraw the shape being dragged out, from the anchor to the given cell,
+ * over the glyph as it was before the drag.  Only the cells covered by the
+ * old and new shapes are repainted.
+ */
+void GlyphEditor::drawShape( const QPoint &cell )
+{
+    QRect box = QRect( QPoint( qMin( shapeAnchor.x(), cell.x() ), qMin( shapeAnchor.y(), cell.y() )),
+                       QPoint( qMax( shapeAnchor.x(), cell.x() ), qMax( shapeAnchor.y(), cell.y() )));
+    if ( box == shapeCells )
+        return;
+
+    glyph = shapeBase;
+    switch ( currentTool ) {
+        case LineTool:            glyph.drawLine( shapeAnchor, cell, bShapeInk );  break;
+        case RectangleTool:       glyph.drawRect( box, bShapeInk );                break;
+        case FilledRectangleTool: glyph.fillRect( box, bShapeInk );                break;
+        case EllipseTool:         glyph.drawEllipse( box, bShapeInk, false );      break;
+        case FilledEllipseTool:   glyph.drawEllipse( box, bShapeInk, true );       break;
+        default: break;
+    }
+
+    updateCells( shapeCells.isValid()? box | shapeCells: box );
+    shapeCells = box;
+}
+
+
+/* A fill or shape is complete: signal it as one change, named after the
+ * tool, before the usual contentsChanged().
+ */
+void GlyphEditor::finishTool()
+{
+    static const char *names[] = {
+        QT_TR_NOOP("Draw"), QT_TR_NOOP("Fill"), QT_TR_NOOP("Line"), QT_TR_NOOP("Rectangle"),
+        QT_TR_NOOP("Filled rectangle"), QT_TR_NOOP("Ellipse"), QT_TR_NOOP("Filled ellipse")
+    };
+    commitEdit( tr( names[ currentTool ] ));
+    setModified( true );
+}
+
+
+/* Repaint a rectangle of cells as a single update.
+ */
+void GlyphEditor::updateCells( const QRect &cells )
+{
+    QRect area = cells & glyph.rect();
+    if ( !area.isEmpty() )
+        update( pixelRect( area.left(), area.top() ) | pixelRect( area.right(), area.bottom() ));
+}
+
+
+/* Begin a new selection rectangle.  With Ctrl it is added to the current
+ * selection, with Shift it is removed from it, and with both it is
+ * intersected with it; otherwise it replaces the current selection.
+ */
+void GlyphEditor::startSelection( const QPoint &pos, Qt::KeyboardModifiers modifiers )
+{
+    bool add      = modifiers & Qt::ControlModifier;
+    bool subtract = modifiers & Qt::ShiftModifier;
+
+    if ( add && subtract )
+        selOp = SelectIntersect;
+    else if ( add )
+        selOp = SelectAdd;
+    else if ( subtract )
+        selOp = SelectSubtract;
+    else
+        selOp = SelectReplace;
+
+    selBase = selMask;
+    selAnchor = cellAt( pos );
+    updateSelection( selAnchor );
 }
 
 
 void GlyphEditor::expandSelection( const QPoint &pos )
 {
-    curSelection.setBottomRight( pos / iZoom );
+    updateSelection( cellAt( pos ));
+}
+
+
+/* Rebuild the selection mask from the rectangle spanning the anchor cell and
+ * the given cell, combined with the selection which existed before the drag.
+ */
+void GlyphEditor::updateSelection( const QPoint &cell )
+{
+    curSelection = QRect( QPoint( qMin( selAnchor.x(), cell.x() ), qMin( selAnchor.y(), cell.y() )),
+                          QPoint( qMax( selAnchor.x(), cell.x() ), qMax( selAnchor.y(), cell.y() )))
+                   & glyph.rect();
+
+    GlyphBitmap box( glyph.width(), glyph.height() );
+    box.fillRect( curSelection, true );
+
+    if ( selOp == SelectReplace || selBase.size() != glyph.size() ) {
+        selMask = box;
+    }
+    else {
+        selMask = selBase;
+        switch ( selOp ) {
+            case SelectAdd:       selMask.unite( box );     break;
+            case SelectSubtract:  selMask.subtract( box );  break;
+            case SelectIntersect: selMask.intersect( box ); break;
+            default: break;
+        }
+    }
     update();
 }
 
 
+/* Shift columns (or rows) [lo, hi) by delta, confined to the selected pixels
+ * if there is a selection.  Pixels which are shifted out of the selection
+ * are dropped.
+ */
+void GlyphEditor::shiftScoped( Qt::Orientation direction, int lo, int hi, int delta )
+{
+    if ( !hasSelection() ) {
+        if ( direction == Qt::Horizontal )
+            glyph.shiftColumns( lo, hi, delta );
+        else
+            glyph.shiftRows( lo, hi, delta );
+        return;
+    }
+
+    GlyphBitmap moved = selectedPixels();
+    if ( direction == Qt::Horizontal )
+        moved.shiftColumns( lo, hi, delta );
+    else
+        moved.shiftRows( lo, hi, delta );
+    glyph.merge( moved, selMask );
+}
+
+
+GlyphBitmap GlyphEditor::selectedPixels() const
+{
+    GlyphBitmap pixels = glyph;
+    pixels.intersect( selMask );
+    return pixels;
+}
+
+
+QPoint GlyphEditor::cellAt( const QPoint &pos ) const
+{
+    return QPoint( qBound( 0, pos.x() / iZoom, glyph.width() - 1 ),
+                   qBound( 0, pos.y() / iZoom, glyph.height() - 1 ));
+}
+
+
+/* The cell a stroke passes through, which may lie outside the glyph (the
+ * part of the line drawn there is clipped).  Positions are rounded down, so
+ * that the pointer just above or left of the canvas is not taken for a cell
+ * in its first row or column.
+ */
+QPoint GlyphEditor::strokeCellAt( const QPoint &pos ) const
+{
+    return QPoint( qFloor( (qreal) pos.x() / iZoom ), qFloor( (qreal) pos.y() / iZoom ));
+}
+
+
 bool GlyphEditor::showGrid() const
 {
     return ( iZoom >= 3 );
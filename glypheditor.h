@@ -26,8 +26,13 @@
 
 #include <QColor>
 #include <QImage>
+#include <QVector>
 #include <QWidget>
 
+#include "glyphbitmap.h"
+
+class QTimer;
+
 class GlyphEditor : public QWidget
 {
     Q_OBJECT
@@ -39,6 +44,10 @@ class GlyphEditor : public QWidget
     Q_PROPERTY( bool changed READ isChanged )
 
 public:
+    // What a mouse press does outside selection mode
+    enum Tool { PenTool, FillTool, LineTool, RectangleTool, FilledRectangleTool,
+                EllipseTool, FilledEllipseTool };
+
     GlyphEditor( QWidget *parent = 0 );
 
     // Overridden methods
@@ -50,23 +59,36 @@ public:
     int     zoomFactor() const { return iZoom; }
 
     void    setGlyphImage( const QImage &newImage );
-    QImage  glyphImage() const { return image; }
+    QImage  glyphImage() const;
+
+    void        setGlyphBitmap( const GlyphBitmap &newGlyph );
+    GlyphBitmap glyphBitmap() const { return glyph; }
 
     void    setBaseLine( int offset );
     int     baseLine() const { return iBaseLine; }
 
     void    setIncrement( int increment );
-    int     increment() const { return image.width(); }
+    int     increment() const { return glyph.width(); }
 
     void    setSelectMode( bool on );
     bool    selectMode() const { return bSelectionOn; }
 
     bool    isChanged() const { return bChanged; }
 
+    void    setTool( Tool tool );
+    Tool    tool() const { return currentTool; }
+
 
     // Other public methods
     void    clear();
     void    selectAll();
+    void    invertSelection();
+    bool    hasSelection() const;
+
+    QRect       selectionRect() const;
+    GlyphBitmap copySelection() const;
+    void        cutSelection();
+    void        pasteBlock( const GlyphBitmap &block, bool asMask );
 
     void    insertColumnShiftLeft( int pos, bool widen=false );
     void    insertColumnShiftRight( int pos, bool widen=false );
@@ -87,25 +109,67 @@ public:
 
 signals:
     void positionChanged( const QPoint &newPosition );
+    void contentsChanged();
+    void editFinished( const QString &description, const GlyphBitmap &before );
+
+private slots:
+    void flushStroke();
 
 protected:
     void mousePressEvent( QMouseEvent *event );
     void mouseMoveEvent( QMouseEvent *event );
+    void mouseReleaseEvent( QMouseEvent *event );
     void paintEvent( QPaintEvent *event );
     void resizeEvent( QResizeEvent *event );
 
 private:
     void  setImagePixel( const QPoint &pos, bool opaque );
     void  setModified( bool modified );
-    void  startSelection( const QPoint &pos );
+    void  replaceGlyph( const GlyphBitmap &newGlyph );
+    void  commitEdit( const QString &description );
+    void  updatePosition( const QPoint &pos );
+    void  startSelection( const QPoint &pos, Qt::KeyboardModifiers modifiers );
     void  expandSelection( const QPoint &pos );
+    void  updateSelection( const QPoint &cell );
+    void  shiftScoped( Qt::Orientation direction, int lo, int hi, int delta );
+    void  applyFill( const QPoint &pos, bool on );
+    void  drawShape( const QPoint &cell );
+    void  finishTool();
+    void  updateCells( const QRect &cells );
+    QPoint      cellAt( const QPoint &pos ) const;
+    QPoint      strokeCellAt( const QPoint &pos ) const;
+    GlyphBitmap selectedPixels() const;
     QRect pixelRect( int i, int j ) const;
     bool  showGrid() const;
 
     const QRgb rgbOn  = qRgba( 0, 0, 0, 255 );
     const QRgb rgbOff = qRgba( 255, 255, 255, 0 );
 
-    QImage  image;
+    // How a new selection rectangle combines with the existing selection
+    enum SelectionOp { SelectReplace, SelectAdd, SelectSubtract, SelectIntersect };
+
+    // What the current mouse drag is doing
+    enum StrokeMode { NoStroke, DrawStroke, EraseStroke, SelectStroke, ShapeStroke };
+
+    GlyphBitmap glyph;
+    GlyphBitmap editBase;       // glyph as of the last editFinished()
+    GlyphBitmap selMask;        // selected pixels (same size as glyph)
+    GlyphBitmap selBase;        // selection as it was when the drag started
+    SelectionOp selOp;
+    QPoint  selAnchor;
+
+    StrokeMode      strokeMode;
+    QTimer         *strokeTimer;
+    QVector<QPoint> pendingPoints;  // pointer samples not yet drawn
+    QPoint          strokeCell;     // cell where the last segment ended
+    QPoint          lastPointerPos;
+
+    Tool        currentTool;
+    GlyphBitmap shapeBase;      // glyph as it was when the shape was started
+    QPoint      shapeAnchor;    // cell where the shape was started
+    QRect       shapeCells;     // cells covered by the shape as last drawn
+    bool        bShapeInk;
+
     QPoint  curPosition;
     QRect   curSelection;
 
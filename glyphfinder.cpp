@@ -0,0 +1,112 @@
+/******************************************************************************
+** glyphfinder.cpp
+**
+** "Go to glyph" entry field with incremental results.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "glyphfinder.h"
+#include "glyphnames.h"
+
+// Most results listed at once
+#define MAX_RESULTS         50
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+GlyphFinder::GlyphFinder( QWidget *parent ): QLineEdit( parent )
+{
+    model = new QStringListModel( this );
+
+    // The results are already filtered, so the completer just shows them
+    completer = new QCompleter( model, this );
+    completer->setCompletionMode( QCompleter::UnfilteredPopupCompletion );
+    completer->setMaxVisibleItems( 12 );
+    setCompleter( completer );
+
+    setToolTip( tr("Go to a glyph by code point (U+00E9), UGL value, character or name") );
+    connect( this, SIGNAL( textEdited( const QString & )), this, SLOT( updateResults( const QString & )));
+    connect( this, SIGNAL( returnPressed() ), this, SLOT( activateFirst() ));
+    connect( completer, SIGNAL( activated( const QModelIndex & )), this, SLOT( activateResult( const QModelIndex & )));
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+void GlyphFinder::setDocument( FontDocument *document )
+{
+    doc = document;
+    results.clear();
+    model->setStringList( QStringList() );
+    clear();
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void GlyphFinder::updateResults( const QString &text )
+{
+    if ( !doc )
+        return;
+    if ( !lookup.isBuiltFor( doc ))
+        lookup.build( doc );
+
+    results = lookup.search( text, MAX_RESULTS );
+
+    QStringList items;
+    for ( int i = 0; i < results.size(); i++ ) {
+        int  index = results.at( i );
+        uint value = lookup.codePoint( index );
+        if ( value == NO_CODE_POINT )
+            items << tr("UGL %1").arg( doc->firstChar() + index );
+        else
+            items << tr("UGL %1   U+%2   %3").arg( doc->firstChar() + index )
+                                             .arg( QString("%1").arg( value, 4, 16, QChar('0') ).toUpper() )
+                                             .arg( lookup.glyphName( index ));
+    }
+    model->setStringList( items );
+    if ( !items.isEmpty() )
+        completer->complete();
+}
+
+
+void GlyphFinder::activateResult( const QModelIndex &index )
+{
+    if ( index.row() >= 0 && index.row() < results.size() )
+        emit glyphSelected( results.at( index.row() ));
+}
+
+
+void GlyphFinder::activateFirst()
+{
+    if ( completer->popup()->isVisible() )
+        return;
+    if ( results.isEmpty() )
+        updateResults( text() );
+    if ( !results.isEmpty() )
+        emit glyphSelected( results.first() );
+}
@@ -0,0 +1,67 @@
+/******************************************************************************
+** glyphfinder.h
+**
+** "Go to glyph" entry field with incremental results.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHFINDER_H
+#define GLYPHFINDER_H
+
+#include <QLineEdit>
+#include <QPointer>
+
+#include "glyphlookup.h"
+
+class QCompleter;
+class QModelIndex;
+class QStringListModel;
+
+
+/* As the user types, the matching glyphs are listed in a popup; choosing
+ * one, or pressing Enter to take the first, emits glyphSelected().  The
+ * lookup indices are (re)built on the first search after the document's
+ * layout changes.
+ */
+class GlyphFinder : public QLineEdit
+{
+    Q_OBJECT
+
+public:
+    GlyphFinder( QWidget *parent = 0 );
+
+    void    setDocument( FontDocument *document );
+
+signals:
+    void glyphSelected( int index );
+
+private slots:
+    void updateResults( const QString &text );
+    void activateResult( const QModelIndex &index );
+    void activateFirst();
+
+private:
+    QPointer<FontDocument> doc;
+    GlyphLookup       lookup;
+    QCompleter       *completer;
+    QStringListModel *model;
+    QList<int>        results;
+};
+
+#endif  // GLYPHFINDER_H
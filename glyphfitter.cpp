@@ -0,0 +1,100 @@
+/******************************************************************************
+** glyphfitter.cpp
+**
+** Fitting glyph widths to their ink, for proportional fonts.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtConcurrentMap>
+
+#include "fontdocument.h"
+#include "glyphfitter.h"
+
+
+// ---------------------------------------------------------------------------
+// Fits one glyph of a font in place (for QtConcurrent).
+//
+struct GlyphFitJob
+{
+    typedef void result_type;
+
+    GlyphFitJob( const GlyphFitter::Options &o ): options( o ) {}
+    void operator()( GlyphBitmap &glyph ) const { glyph = GlyphFitter::fit( glyph, options ); }
+
+    GlyphFitter::Options options;
+};
+
+
+// ---------------------------------------------------------------------------
+// GlyphFitter::fit
+//
+// Return the glyph cropped to its ink with the given side bearings.  The
+// ink bounds come from inkBounds(), which ORs the rows together a word at
+// a time and finds the outermost columns by counting leading and trailing
+// zeros, so no pixel is looked at individually.  A glyph which already
+// fits is returned as it is, sharing its data.
+//
+GlyphBitmap GlyphFitter::fit( const GlyphBitmap &source, const Options &options )
+{
+    if ( source.isNull() )
+        return source;
+
+    QRect ink = source.inkBounds();
+    if ( ink.isNull() ) {
+        if ( options.spaceWidth <= 0 || options.spaceWidth == source.width() )
+            return source;
+        return GlyphBitmap( options.spaceWidth, source.height() );
+    }
+
+    int left  = qMax( options.leftBearing, 0 );
+    int width = left + ink.width() + qMax( options.rightBearing, 0 );
+    if ( left == ink.left() && width == source.width() )
+        return source;
+
+    QRect       columns( ink.left(), 0, ink.width(), source.height() );
+    GlyphBitmap result( width, source.height() );
+    result.blit( QPoint( left, 0 ), source.copy( columns ), GlyphBitmap::Copy );
+    return result;
+}
+
+
+// ---------------------------------------------------------------------------
+// GlyphFitter::fitFont
+//
+// Fit every glyph of a font, in parallel across all available cores, and
+// return those which changed, ready for FontDocument::setGlyphBatch().  The
+// glyphs are all decoded first with FontDocument::decodeGlyph(), which
+// bypasses the decode cache so that the pass doesn't push out the glyphs
+// being viewed; the fitting itself then needs nothing from the document.
+//
+QList< QPair<int, GlyphBitmap> > GlyphFitter::fitFont( const FontDocument *document, const Options &options )
+{
+    QVector<GlyphBitmap> originals( document->glyphCount() );
+    for ( int i = 0; i < originals.size(); i++ )
+        originals[ i ] = document->decodeGlyph( i );
+
+    QVector<GlyphBitmap> fitted( originals );
+    QtConcurrent::blockingMap( fitted, GlyphFitJob( options ));
+
+    QList< QPair<int, GlyphBitmap> > changed;
+    for ( int i = 0; i < fitted.size(); i++ )
+        if ( !fitted.at( i ).isSharedWith( originals.at( i )) && fitted.at( i ) != originals.at( i ))
+            changed.append( qMakePair( i, fitted.at( i )));
+    return changed;
+}
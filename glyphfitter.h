@@ -0,0 +1,53 @@
+/******************************************************************************
+** glyphfitter.h
+**
+** Fitting glyph widths to their ink, for proportional fonts.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHFITTER_H
+#define GLYPHFITTER_H
+
+#include <QList>
+#include <QPair>
+
+#include "glyphbitmap.h"
+
+class FontDocument;
+
+
+/* Fitting crops each glyph to the columns containing ink, then adds the
+ * given blank columns on either side, so that a monospaced font becomes a
+ * proportional one.  Blank glyphs have no ink to fit to; they are set to
+ * spaceWidth, or left alone if that is 0.
+ */
+namespace GlyphFitter {
+    struct Options {
+        Options(): leftBearing( 1 ), rightBearing( 1 ), spaceWidth( 0 ) {}
+
+        int leftBearing;
+        int rightBearing;
+        int spaceWidth;
+    };
+
+    GlyphBitmap fit( const GlyphBitmap &source, const Options &options );
+    QList< QPair<int, GlyphBitmap> > fitFont( const FontDocument *document, const Options &options );
+};
+
+#endif  // GLYPHFITTER_H
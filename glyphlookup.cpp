@@ -0,0 +1,222 @@
+/******************************************************************************
+** glyphlookup.cpp
+**
+** Indices for finding glyphs by code point, UGL value or name.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QRegExp>
+#include <QtAlgorithms>
+
+#include "glyphlookup.h"
+#include "glyphnames.h"
+
+// Number of 256-character pages needed to cover all of Unicode
+#define CODE_PAGES          0x1100
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static inline quint32 trigramAt( const QString &text, int pos )
+{
+    return (( text.at( pos ).unicode() & 0xFF ) << 16 ) |
+           (( text.at( pos + 1 ).unicode() & 0xFF ) << 8 ) |
+            ( text.at( pos + 2 ).unicode() & 0xFF );
+}
+
+
+static void addResult( QList<int> &results, int index )
+{
+    if ( index >= 0 && !results.contains( index ))
+        results.append( index );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+GlyphLookup::GlyphLookup()
+{
+    usCodePage  = 0;
+    iFirstChar  = 0;
+    iGlyphCount = -1;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+void GlyphLookup::build( const FontDocument *document )
+{
+    usCodePage  = document->codePage();
+    iFirstChar  = document->firstChar();
+    iGlyphCount = document->glyphCount();
+
+    codePoints.resize( iGlyphCount );
+    names.clear();
+    sortedNames.clear();
+    trigrams.clear();
+    pages.clear();
+    pages.resize( CODE_PAGES );
+
+    for ( int i = 0; i < iGlyphCount; i++ ) {
+        uint value = GlyphNames::codePoint( usCodePage, iFirstChar + i );
+        codePoints[ i ] = value;
+        if ( value < CODE_PAGES * 256 ) {
+            QVector<int> &page = pages[ value >> 8 ];
+            if ( page.isEmpty() )
+                page.fill( -1, 256 );
+            if ( page.at( value & 0xFF ) < 0 )
+                page[ value & 0xFF ] = i;
+        }
+
+        QString name  = GlyphNames::name( value );
+        QString lower = name.toLower();
+        names.append( name );
+        sortedNames.append( qMakePair( lower, i ));
+        for ( int k = 0; k + 3 <= lower.length(); k++ ) {
+            QVector<int> &posting = trigrams[ trigramAt( lower, k ) ];
+            if ( posting.isEmpty() || posting.last() != i )
+                posting.append( i );
+        }
+    }
+    qSort( sortedNames );
+}
+
+
+bool GlyphLookup::isBuiltFor( const FontDocument *document ) const
+{
+    return ( document &&
+             document->codePage() == usCodePage &&
+             document->firstChar() == iFirstChar &&
+             document->glyphCount() == iGlyphCount );
+}
+
+
+int GlyphLookup::glyphForCodePoint( uint codePoint ) const
+{
+    if ( codePoint >= CODE_PAGES * 256 )
+        return -1;
+    const QVector<int> &page = pages.at( codePoint >> 8 );
+    return page.isEmpty()? -1: page.at( codePoint & 0xFF );
+}
+
+
+int GlyphLookup::glyphForUgl( uint ugl ) const
+{
+    if ( ugl < (uint) iFirstChar || ugl - iFirstChar >= (uint) iGlyphCount )
+        return -1;
+    return ugl - iFirstChar;
+}
+
+
+uint GlyphLookup::codePoint( int index ) const
+{
+    return ( index >= 0 && index < codePoints.size() )? codePoints.at( index ): NO_CODE_POINT;
+}
+
+
+QString GlyphLookup::glyphName( int index ) const
+{
+    return ( index >= 0 && index < names.size() )? names.at( index ): QString();
+}
+
+
+/* Find the glyphs the user might mean by the given text, best matches first.
+ * The text may be a code point ("U+00E9", "0xE9", or four or more hex
+ * digits), a decimal UGL value, a literal character, or all or part of a
+ * glyph name; all the readings which make sense are tried.
+ */
+QList<int> GlyphLookup::search( const QString &text, int limit ) const
+{
+    QList<int> results;
+    QString query = text.trimmed();
+    if ( query.isEmpty() || limit < 1 )
+        return results;
+
+    QRegExp prefixedHex("(?:U\\+|0x|\\\\u)([0-9A-F]{1,6})", Qt::CaseInsensitive );
+    QRegExp plainHex("[0-9A-F]{4,6}", Qt::CaseInsensitive );
+    QRegExp decimal("[0-9]+");
+
+    if ( prefixedHex.exactMatch( query ))
+        addResult( results, glyphForCodePoint( prefixedHex.cap( 1 ).toUInt( 0, 16 )));
+    if ( decimal.exactMatch( query ))
+        addResult( results, glyphForUgl( query.toUInt() ));
+    if ( plainHex.exactMatch( query ))
+        addResult( results, glyphForCodePoint( query.toUInt( 0, 16 )));
+
+    if ( query.length() == 1 )
+        addResult( results, glyphForCodePoint( query.at( 0 ).unicode() ));
+    else if ( query.length() == 2 && query.at( 0 ).isHighSurrogate() && query.at( 1 ).isLowSurrogate() )
+        addResult( results, glyphForCodePoint( QChar::surrogateToUcs4( query.at( 0 ), query.at( 1 ))));
+
+    findNames( query.toLower(), limit, results );
+    while ( results.size() > limit )
+        results.removeLast();
+    return results;
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+/* Add the glyphs whose names start with the text, then those whose names
+ * contain it elsewhere.  For the latter, every glyph containing all the
+ * text's trigrams is a candidate, and is then checked properly.
+ */
+void GlyphLookup::findNames( const QString &text, int limit, QList<int> &results ) const
+{
+    QList< QPair<QString, int> >::const_iterator i;
+    i = qLowerBound( sortedNames.constBegin(), sortedNames.constEnd(), qMakePair( text, -1 ));
+    for ( ; i != sortedNames.constEnd() && results.size() < limit; ++i ) {
+        if ( !i->first.startsWith( text ))
+            break;
+        addResult( results, i->second );
+    }
+    if ( text.length() < 3 || results.size() >= limit )
+        return;
+
+    // Start from the shortest posting list and look the rest up in that
+    QList< const QVector<int> * > postings;
+    const QVector<int> *shortest = 0;
+    for ( int k = 0; k + 3 <= text.length(); k++ ) {
+        QHash< quint32, QVector<int> >::const_iterator found = trigrams.constFind( trigramAt( text, k ));
+        if ( found == trigrams.constEnd() )
+            return;
+        postings.append( &found.value() );
+        if ( !shortest || found.value().size() < shortest->size() )
+            shortest = &found.value();
+    }
+
+    for ( int c = 0; c < shortest->size() && results.size() < limit; c++ ) {
+        int  index = shortest->at( c );
+        bool all   = true;
+        for ( int p = 0; p < postings.size() && all; p++ ) {
+            if ( postings.at( p ) != shortest )
+                all = ( qBinaryFind( *postings.at( p ), index ) != postings.at( p )->constEnd() );
+        }
+        if ( all && names.at( index ).toLower().contains( text ))
+            addResult( results, index );
+    }
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+** glyphlookup.h
+**
+** Indices for finding glyphs by code point, UGL value or name.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHLOOKUP_H
+#define GLYPHLOOKUP_H
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QStringList>
+#include <QVector>
+
+#include "fontdocument.h"
+
+
+/* The lookup only depends on a font's code page, first character and glyph
+ * count, not on the glyph bitmaps, so it only needs rebuilding when one of
+ * those changes (see isBuiltFor()).
+ *
+ *  - Code points map to glyphs through a two-level page table: one entry
+ *    per 256 code points, each either empty or a page of glyph indices.
+ *  - UGL values are simply offsets from the font's first character.
+ *  - Names are found through a sorted list, for prefixes, and a trigram
+ *    index, for any other substring; neither ever scans the whole font.
+ */
+class GlyphLookup
+{
+public:
+    GlyphLookup();
+
+    void    build( const FontDocument *document );
+    bool    isBuiltFor( const FontDocument *document ) const;
+
+    int     glyphForCodePoint( uint codePoint ) const;
+    int     glyphForUgl( uint ugl ) const;
+    uint    codePoint( int index ) const;
+    QString glyphName( int index ) const;
+
+    QList<int> search( const QString &text, int limit ) const;
+
+private:
+    void    findNames( const QString &text, int limit, QList<int> &results ) const;
+
+    quint16 usCodePage;
+    int     iFirstChar;
+    int     iGlyphCount;
+
+    QVector<uint>           codePoints;     // of each glyph
+    QStringList             names;          // of each glyph
+    QVector< QVector<int> > pages;          // code point >> 8 -> page of glyphs
+    QList< QPair<QString, int> > sortedNames;   // lower-cased, for prefixes
+    QHash< quint32, QVector<int> > trigrams;    // trigram -> glyphs, ascending
+};
+
+#endif  // GLYPHLOOKUP_H
@@ -0,0 +1,185 @@
+/******************************************************************************
+** glyphnames.cpp
+**
+** Standard glyph names for Unicode code points.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QTextCodec>
+
+#include "glyphnames.h"
+
+
+// ---------------------------------------------------------------------------
+// LOCAL DATA
+//
+
+// Names of the printable ASCII and Latin-1 characters, from U+0020
+static const char * const latinNames[] = {
+    "space", "exclam", "quotedbl", "numbersign", "dollar", "percent",
+    "ampersand", "quotesingle", "parenleft", "parenright", "asterisk", "plus",
+    "comma", "hyphen", "period", "slash", "zero", "one", "two", "three",
+    "four", "five", "six", "seven", "eight", "nine", "colon", "semicolon",
+    "less", "equal", "greater", "question", "at", "A", "B", "C", "D", "E",
+    "F", "G", "H", "I", "J", "K", "L", "M", "N", "O", "P", "Q", "R", "S",
+    "T", "U", "V", "W", "X", "Y", "Z", "bracketleft", "backslash",
+    "bracketright", "asciicircum", "underscore", "grave", "a", "b", "c", "d",
+    "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r",
+    "s", "t", "u", "v", "w", "x", "y", "z", "braceleft", "bar", "braceright",
+    "asciitilde", 0,
+    // U+0080 to U+009F are control characters
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    "nbspace", "exclamdown", "cent", "sterling", "currency", "yen",
+    "brokenbar", "section", "dieresis", "copyright", "ordfeminine",
+    "guillemotleft", "logicalnot", "sfthyphen", "registered", "macron",
+    "degree", "plusminus", "twosuperior", "threesuperior", "acute", "mu",
+    "paragraph", "periodcentered", "cedilla", "onesuperior", "ordmasculine",
+    "guillemotright", "onequarter", "onehalf", "threequarters",
+    "questiondown", "Agrave", "Aacute", "Acircumflex", "Atilde", "Adieresis",
+    "Aring", "AE", "Ccedilla", "Egrave", "Eacute", "Ecircumflex",
+    "Edieresis", "Igrave", "Iacute", "Icircumflex", "Idieresis", "Eth",
+    "Ntilde", "Ograve", "Oacute", "Ocircumflex", "Otilde", "Odieresis",
+    "multiply", "Oslash", "Ugrave", "Uacute", "Ucircumflex", "Udieresis",
+    "Yacute", "Thorn", "germandbls", "agrave", "aacute", "acircumflex",
+    "atilde", "adieresis", "aring", "ae", "ccedilla", "egrave", "eacute",
+    "ecircumflex", "edieresis", "igrave", "iacute", "icircumflex",
+    "idieresis", "eth", "ntilde", "ograve", "oacute", "ocircumflex",
+    "otilde", "odieresis", "divide", "oslash", "ugrave", "uacute",
+    "ucircumflex", "udieresis", "yacute", "thorn", "ydieresis"
+};
+
+// The PC graphics characters shown for bytes 0x01-0x1F (and 0x7F, below)
+// in the PC code pages, from U+0000
+static const quint16 pcGraphics[ 32 ] = {
+    0x0000, 0x263A, 0x263B, 0x2665, 0x2666, 0x2663, 0x2660, 0x2022,
+    0x25D8, 0x25CB, 0x25D9, 0x2642, 0x2640, 0x266A, 0x266B, 0x263C,
+    0x25BA, 0x25C4, 0x2195, 0x203C, 0x00B6, 0x00A7, 0x25AC, 0x21A8,
+    0x2191, 0x2193, 0x2192, 0x2190, 0x221F, 0x2194, 0x25B2, 0x25BC
+};
+#define PC_GRAPHIC_7F       0x2302
+
+// Other characters found in the PC code pages, in code point order
+static const struct {
+    uint        codePoint;
+    const char *name;
+} otherNames[] = {
+    { 0x0131, "dotlessi" },     { 0x0192, "florin" },
+    { 0x2017, "underscoredbl" }, { 0x2022, "bullet" },      { 0x203C, "exclamdbl" },
+    { 0x2190, "arrowleft" },    { 0x2191, "arrowup" },      { 0x2192, "arrowright" },
+    { 0x2193, "arrowdown" },    { 0x2194, "arrowboth" },    { 0x2195, "arrowupdn" },
+    { 0x21A8, "arrowupdnbse" }, { 0x221F, "orthogonal" },   { 0x2302, "house" },
+    { 0x2500, "SF100000" },     { 0x2502, "SF110000" },     { 0x250C, "SF010000" },
+    { 0x2510, "SF030000" },     { 0x2514, "SF020000" },     { 0x2518, "SF040000" },
+    { 0x251C, "SF080000" },     { 0x2524, "SF090000" },     { 0x252C, "SF060000" },
+    { 0x2534, "SF070000" },     { 0x253C, "SF050000" },     { 0x2550, "SF430000" },
+    { 0x2551, "SF240000" },     { 0x2552, "SF510000" },     { 0x2553, "SF520000" },
+    { 0x2554, "SF390000" },     { 0x2555, "SF220000" },     { 0x2556, "SF210000" },
+    { 0x2557, "SF250000" },     { 0x2558, "SF500000" },     { 0x2559, "SF490000" },
+    { 0x255A, "SF380000" },     { 0x255B, "SF280000" },     { 0x255C, "SF270000" },
+    { 0x255D, "SF260000" },     { 0x255E, "SF360000" },     { 0x255F, "SF370000" },
+    { 0x2560, "SF420000" },     { 0x2561, "SF190000" },     { 0x2562, "SF200000" },
+    { 0x2563, "SF230000" },     { 0x2564, "SF470000" },     { 0x2565, "SF480000" },
+    { 0x2566, "SF410000" },     { 0x2567, "SF450000" },     { 0x2568, "SF460000" },
+    { 0x2569, "SF400000" },     { 0x256A, "SF540000" },     { 0x256B, "SF530000" },
+    { 0x256C, "SF440000" },     { 0x2580, "upblock" },      { 0x2584, "dnblock" },
+    { 0x2588, "block" },        { 0x258C, "lfblock" },      { 0x2590, "rtblock" },
+    { 0x2591, "ltshade" },      { 0x2592, "shade" },        { 0x2593, "dkshade" },
+    { 0x25A0, "filledbox" },    { 0x25AC, "filledrect" },   { 0x25B2, "triagup" },
+    { 0x25BA, "triagrt" },      { 0x25BC, "triagdn" },      { 0x25C4, "triaglf" },
+    { 0x25CB, "circle" },       { 0x25D8, "invbullet" },    { 0x25D9, "invcircle" },
+    { 0x263A, "smileface" },    { 0x263B, "invsmileface" }, { 0x263C, "sun" },
+    { 0x2640, "female" },       { 0x2642, "male" },         { 0x2660, "spade" },
+    { 0x2663, "club" },         { 0x2665, "heart" },        { 0x2666, "diamond" },
+    { 0x266A, "musicalnote" },  { 0x266B, "musicalnotedbl" }
+};
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC FUNCTIONS
+//
+
+QString GlyphNames::name( uint codePoint )
+{
+    if ( codePoint == NO_CODE_POINT )
+        return QString();
+
+    if ( codePoint >= 0x20 && codePoint <= 0xFF ) {
+        const char *latin = latinNames[ codePoint - 0x20 ];
+        if ( latin )
+            return QString::fromLatin1( latin );
+    }
+
+    int lo = 0;
+    int hi = sizeof( otherNames ) / sizeof( otherNames[ 0 ] );
+    while ( lo < hi ) {
+        int mid = ( lo + hi ) / 2;
+        if ( otherNames[ mid ].codePoint < codePoint )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if ( lo < (int)( sizeof( otherNames ) / sizeof( otherNames[ 0 ] )) && otherNames[ lo ].codePoint == codePoint )
+        return QString::fromLatin1( otherNames[ lo ].name );
+
+    QString hex = QString("%1").arg( codePoint, 4, 16, QChar('0') ).toUpper();
+    return ( codePoint > 0xFFFF )? "u" + hex: "uni" + hex;
+}
+
+
+/* Find the Unicode value of a character in the given code page.  Fonts in a
+ * single-byte code page are decoded using the matching codec, if Qt has
+ * one; otherwise the characters are taken to be Latin-1.  Control codes
+ * are passed through unchanged, except in the PC code pages, where they
+ * stand for the PC graphics characters.
+ */
+uint GlyphNames::codePoint( quint16 codePage, uint character )
+{
+    if ( codePage == UCS2_CODEPAGE )
+        return character;
+    if ( character > 0xFF )
+        return NO_CODE_POINT;
+    if ( character < 0x20 || character == 0x7F ) {
+        if ( character == 0 || !hasPcGraphics( codePage ))
+            return character;
+        return ( character == 0x7F )? PC_GRAPHIC_7F: pcGraphics[ character ];
+    }
+
+    QTextCodec *codec = QTextCodec::codecForName( QString("IBM %1").arg( codePage ).toLatin1() );
+    if ( !codec )
+        codec = QTextCodec::codecForName( QString("CP%1").arg( codePage ).toLatin1() );
+    if ( !codec )
+        codec = QTextCodec::codecForName( QString("windows-%1").arg( codePage ).toLatin1() );
+    if ( !codec )
+        return character;
+
+    QString text = codec->toUnicode( QByteArray( 1, (char) character ));
+    if ( text.isEmpty() || text.at( 0 ) == QChar( QChar::ReplacementCharacter ))
+        return NO_CODE_POINT;
+    return text.at( 0 ).unicode();
+}
+
+
+/* The PC (OEM) code pages, 437 to 869, show graphics characters for the
+ * control codes.  (Thai, 874, follows TIS-620 and does not.)
+ */
+bool GlyphNames::hasPcGraphics( quint16 codePage )
+{
+    return codePage >= 437 && codePage <= 869;
+}
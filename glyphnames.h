@@ -0,0 +1,46 @@
+/******************************************************************************
+** glyphnames.h
+**
+** Standard glyph names for Unicode code points.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHNAMES_H
+#define GLYPHNAMES_H
+
+#include <QString>
+
+// Code page of fonts whose glyphs are indexed by Unicode value
+#define UCS2_CODEPAGE       1200
+
+// Glyphs which don't correspond to any Unicode character
+#define NO_CODE_POINT       0xFFFFFFFFu
+
+
+/* Glyph names follow the PostScript (and OS/2 UGL) conventions: the usual
+ * names for the Latin-1 characters and the box drawing and block elements
+ * found in the PC code pages, and "uniXXXX" for everything else.
+ */
+namespace GlyphNames {
+    QString name( uint codePoint );
+    uint    codePoint( quint16 codePage, uint character );
+    bool    hasPcGraphics( quint16 codePage );
+};
+
+#endif  // GLYPHNAMES_H
@@ -0,0 +1,247 @@
+/******************************************************************************
+** glyphoverview.cpp
+**
+** A scrolling grid showing every glyph in the font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "glyphoverview.h"
+
+// Space around each glyph within its cell, and the limits on the cell size
+#define CELL_MARGIN         3
+#define MIN_CELL_SIZE       16
+#define MAX_CELL_SIZE       64
+#define DEFAULT_COLUMNS     8
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+GlyphOverview::GlyphOverview( QWidget *parent ): QAbstractScrollArea( parent )
+{
+    iCurrent    = 0;
+    iCellWidth  = MIN_CELL_SIZE;
+    iCellHeight = MIN_CELL_SIZE;
+
+    setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOn );
+    viewport()->setBackgroundRole( QPalette::Base );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+QSize GlyphOverview::sizeHint() const
+{
+    return QSize( DEFAULT_COLUMNS * iCellWidth + verticalScrollBar()->sizeHint().width() + 2 * frameWidth(),
+                  QAbstractScrollArea::sizeHint().height() );
+}
+
+
+void GlyphOverview::setDocument( FontDocument *document )
+{
+    if ( doc )
+        disconnect( doc, 0, this, 0 );
+    doc = document;
+    loadingGlyphs.clear();
+    iCurrent = 0;
+
+    if ( doc ) {
+        int size = qBound( MIN_CELL_SIZE, doc->cellHeight() + 2 * CELL_MARGIN, MAX_CELL_SIZE );
+        iCellWidth  = size;
+        iCellHeight = size;
+        connect( doc, SIGNAL( glyphChanged( int )), this, SLOT( updateGlyph( int )));
+    }
+    verticalScrollBar()->setValue( 0 );
+    updateLayout();
+    updateGeometry();
+}
+
+
+/* Flag the glyphs which have not been loaded yet.  The bits correspond to
+ * glyph indices; an empty array means every glyph is present.
+ */
+void GlyphOverview::setLoadingGlyphs( const QBitArray &loading )
+{
+    loadingGlyphs = loading;
+    viewport()->update();
+}
+
+
+int GlyphOverview::firstVisibleGlyph() const
+{
+    if ( !doc )
+        return 0;
+    return qMax( 0, qMin( verticalScrollBar()->value() / iCellHeight * columnCount(), doc->glyphCount() - 1 ));
+}
+
+
+int GlyphOverview::lastVisibleGlyph() const
+{
+    if ( !doc )
+        return -1;
+    int row = ( verticalScrollBar()->value() + viewport()->height() - 1 ) / iCellHeight;
+    return qMin(( row + 1 ) * columnCount() - 1, doc->glyphCount() - 1 );
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void GlyphOverview::setCurrentGlyph( int index )
+{
+    if ( !doc || index == iCurrent || index < 0 || index >= doc->glyphCount() )
+        return;
+
+    viewport()->update( cellRect( iCurrent ));
+    iCurrent = index;
+    viewport()->update( cellRect( iCurrent ));
+
+    // Scroll just far enough to bring the new glyph into view
+    int top = ( index / columnCount() ) * iCellHeight;
+    QScrollBar *bar = verticalScrollBar();
+    if ( top < bar->value() )
+        bar->setValue( top );
+    else if ( top + iCellHeight > bar->value() + viewport()->height() )
+        bar->setValue( top + iCellHeight - viewport()->height() );
+}
+
+
+void GlyphOverview::updateGlyph( int index )
+{
+    viewport()->update( cellRect( index ));
+}
+
+
+void GlyphOverview::updateLayout()
+{
+    int count = doc? doc->glyphCount(): 0;
+    int rows  = ( count + columnCount() - 1 ) / columnCount();
+
+    QScrollBar *bar = verticalScrollBar();
+    bar->setRange( 0, qMax( 0, rows * iCellHeight - viewport()->height() ));
+    bar->setPageStep( viewport()->height() );
+    bar->setSingleStep( iCellHeight );
+
+    viewport()->update();
+    emit visibleRangeChanged( firstVisibleGlyph(), lastVisibleGlyph() );
+}
+
+
+// ---------------------------------------------------------------------------
+// OVERRIDDEN EVENTS
+//
+
+void GlyphOverview::mousePressEvent( QMouseEvent *event )
+{
+    int index = glyphAt( event->pos() );
+    if ( event->button() == Qt::LeftButton && index >= 0 ) {
+        setCurrentGlyph( index );
+        emit glyphSelected( index );
+    }
+}
+
+
+void GlyphOverview::paintEvent( QPaintEvent *event )
+{
+    if ( !doc )
+        return;
+
+    QPainter painter( viewport() );
+    QRect    dirty = event->rect();
+    int      first = firstVisibleGlyph();
+    int      last  = lastVisibleGlyph();
+
+    for ( int i = first; i <= last; i++ ) {
+        QRect cell = cellRect( i );
+        if ( !cell.intersects( dirty ))
+            continue;
+
+        bool loading = ( i < loadingGlyphs.size() && loadingGlyphs.testBit( i ));
+        if ( i == iCurrent )
+            painter.fillRect( cell, palette().highlight() );
+        else if ( loading )
+            painter.fillRect( cell, palette().window() );
+
+        if ( !loading ) {
+            // Glyphs which don't fit are shrunk, keeping their proportions
+            QImage image = doc->glyph( i ).toImage( palette().text().color().rgb(),
+                                                    qRgba( 0, 0, 0, 0 ));
+            QRect  inner = cell.adjusted( CELL_MARGIN, CELL_MARGIN, -CELL_MARGIN, -CELL_MARGIN );
+            QSize  size  = image.size();
+            if ( size.width() > inner.width() || size.height() > inner.height() )
+                size.scale( inner.size(), Qt::KeepAspectRatio );
+            QRect target( QPoint( 0, 0 ), size );
+            target.moveCenter( inner.center() );
+            painter.drawImage( target, image );
+        }
+        painter.setPen( palette().mid().color() );
+        painter.drawRect( cell.adjusted( 0, 0, -1, -1 ));
+    }
+}
+
+
+void GlyphOverview::resizeEvent( QResizeEvent *event )
+{
+    QAbstractScrollArea::resizeEvent( event );
+    updateLayout();
+}
+
+
+void GlyphOverview::scrollContentsBy( int dx, int dy )
+{
+    Q_UNUSED( dx );
+    viewport()->scroll( 0, dy );
+    emit visibleRangeChanged( firstVisibleGlyph(), lastVisibleGlyph() );
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+int GlyphOverview::columnCount() const
+{
+    return qMax( 1, viewport()->width() / iCellWidth );
+}
+
+
+QRect GlyphOverview::cellRect( int index ) const
+{
+    int columns = columnCount();
+    return QRect(( index % columns ) * iCellWidth,
+                 ( index / columns ) * iCellHeight - verticalScrollBar()->value(),
+                 iCellWidth, iCellHeight );
+}
+
+
+int GlyphOverview::glyphAt( const QPoint &pos ) const
+{
+    if ( !doc || pos.x() >= columnCount() * iCellWidth )
+        return -1;
+    int row   = ( pos.y() + verticalScrollBar()->value() ) / iCellHeight;
+    int index = row * columnCount() + pos.x() / iCellWidth;
+    return ( index < doc->glyphCount() )? index: -1;
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+** glyphoverview.h
+**
+** A scrolling grid showing every glyph in the font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHOVERVIEW_H
+#define GLYPHOVERVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QBitArray>
+#include <QPointer>
+
+#include "fontdocument.h"
+
+
+/* The overview only ever paints the cells that are on screen, so it stays
+ * cheap however many glyphs the font has.  Glyphs flagged as still loading
+ * are drawn greyed out until they arrive.
+ */
+class GlyphOverview : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    GlyphOverview( QWidget *parent = 0 );
+
+    QSize   sizeHint() const;
+
+    void    setDocument( FontDocument *document );
+    void    setLoadingGlyphs( const QBitArray &loading );
+
+    int     currentGlyph() const { return iCurrent; }
+    int     firstVisibleGlyph() const;
+    int     lastVisibleGlyph() const;
+
+public slots:
+    void    setCurrentGlyph( int index );
+
+signals:
+    void glyphSelected( int index );
+    void visibleRangeChanged( int first, int last );
+
+protected:
+    void mousePressEvent( QMouseEvent *event );
+    void paintEvent( QPaintEvent *event );
+    void resizeEvent( QResizeEvent *event );
+    void scrollContentsBy( int dx, int dy );
+
+private slots:
+    void updateGlyph( int index );
+    void updateLayout();
+
+private:
+    int   columnCount() const;
+    QRect cellRect( int index ) const;
+    int   glyphAt( const QPoint &pos ) const;
+
+    QPointer<FontDocument> doc;
+    QBitArray loadingGlyphs;
+    int       iCurrent;
+    int       iCellWidth;
+    int       iCellHeight;
+};
+
+#endif  // GLYPHOVERVIEW_H
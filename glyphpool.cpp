@@ -0,0 +1,121 @@
+/******************************************************************************
+** glyphpool.cpp
+**
+** Process-wide sharing of identical glyph bitmaps between font documents.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+#include "glyphpool.h"
+
+// Glyphs added before the pool is purged by itself, at the least
+#define MIN_PURGE_COUNT     1024
+
+typedef QSet<QByteArray> GlyphPoolSet;
+
+Q_GLOBAL_STATIC( GlyphPoolSet, poolSet )
+Q_GLOBAL_STATIC( QMutex, poolMutex )
+
+// Glyphs added since the last purge, and how many were left by it
+static int addedSincePurge = 0;
+static int keptByPurge     = 0;
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static void purgeLocked( GlyphPoolSet *pool )
+{
+    GlyphPoolSet::iterator i = pool->begin();
+    while ( i != pool->end() ) {
+        if ( i->isDetached() )
+            i = pool->erase( i );
+        else
+            ++i;
+    }
+    addedSincePurge = 0;
+    keptByPurge     = pool->size();
+}
+
+
+/* Every edit adds a glyph, and the one it replaces is often no longer used
+ * anywhere, so the pool purges itself once it has grown by as much as it
+ * held after the last purge.  This keeps the unused glyphs to at most about
+ * the number in use, at a constant cost per glyph added.
+ */
+static QByteArray internLocked( GlyphPoolSet *pool, const QByteArray &runs )
+{
+    GlyphPoolSet::const_iterator found = pool->constFind( runs );
+    if ( found != pool->constEnd() )
+        return *found;
+    pool->insert( runs );
+    if ( ++addedSincePurge > qMax( keptByPurge, MIN_PURGE_COUNT ))
+        purgeLocked( pool );
+    return runs;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC FUNCTIONS
+//
+
+QByteArray GlyphPool::intern( const QByteArray &runs )
+{
+    QMutexLocker lock( poolMutex() );
+    return internLocked( poolSet(), runs );
+}
+
+
+/* Intern a whole font's glyphs under one lock.  Glyphs which are already
+ * shared with the one before, like the blank cells of a new font, are only
+ * looked up once.
+ */
+void GlyphPool::intern( QVector<QByteArray> &runs )
+{
+    QMutexLocker lock( poolMutex() );
+    GlyphPoolSet *pool = poolSet();
+
+    for ( int i = 0; i < runs.size(); i++ ) {
+        if ( i > 0 && runs.at( i ).constData() == runs.at( i - 1 ).constData() )
+            runs[ i ] = runs.at( i - 1 );
+        else
+            runs[ i ] = internLocked( pool, runs.at( i ));
+    }
+}
+
+
+/* Drop every glyph that is no longer used outside the pool.  This is done
+ * whenever a document is closed or has its glyphs replaced wholesale.
+ */
+void GlyphPool::purge()
+{
+    QMutexLocker lock( poolMutex() );
+    purgeLocked( poolSet() );
+}
+
+
+int GlyphPool::count()
+{
+    QMutexLocker lock( poolMutex() );
+    return poolSet()->size();
+}
@@ -0,0 +1,45 @@
+/******************************************************************************
+** glyphpool.h
+**
+** Process-wide sharing of identical glyphs between font documents.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHPOOL_H
+#define GLYPHPOOL_H
+
+#include <QByteArray>
+#include <QVector>
+
+
+/* Every glyph stored by a GlyphStore, in its run-length form, is passed
+ * through the pool, and comes back sharing its data with any identical glyph
+ * already stored in this or any other open document.  Since QByteArray is
+ * implicitly shared, each distinct glyph is held in memory once however
+ * many fonts use it.  Glyphs which only the pool still references are
+ * dropped by purge().
+ */
+namespace GlyphPool {
+    QByteArray  intern( const QByteArray &runs );
+    void        intern( QVector<QByteArray> &runs );
+    void        purge();
+    int         count();
+};
+
+#endif  // GLYPHPOOL_H
@@ -0,0 +1,284 @@
+/******************************************************************************
+** glyphscaler.cpp
+**
+** Pixel-art upscaling of glyph bitmaps and whole fonts.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtConcurrentMap>
+
+#include "fontdocument.h"
+#include "glyphscaler.h"
+
+/* The Scale2x and Scale3x rules decide each output pixel by comparing the
+ * source pixel E with its neighbours:
+ *
+ *      A B C
+ *      D E F
+ *      G H I
+ *
+ * With a 1bpp bitmap, each comparison is an XOR (or XNOR) of two whole rows
+ * of neighbours, so every rule is evaluated for 32 pixels at a time.  The
+ * resulting sub-pixel planes are then interleaved into the output rows.
+ * (EPX produces the same result as Scale2x, so it has no separate method.)
+ */
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* Table mapping each byte to its bits spread out 'factor' positions apart,
+ * the first (leftmost) pixel ending up in the highest position.
+ */
+static QVector<quint64> spreadTable( int factor )
+{
+    QVector<quint64> table( 256 );
+    for ( int v = 0; v < 256; v++ ) {
+        quint64 spread = 0;
+        for ( int i = 0; i < 8; i++ )
+            if ( v & ( 0x80 >> i ))
+                spread |= (quint64) 1 << (( 7 - i ) * factor );
+        table[ v ] = spread;
+    }
+    return table;
+}
+
+
+/* OR the low 'count' bits of value into the row, MSB first, starting at
+ * pixel position pos.
+ */
+static void putBits( quint32 *row, int words, int pos, quint64 value, int count )
+{
+    while ( count > 0 ) {
+        int w    = pos >> 5;
+        int s    = pos & 31;
+        int take = qMin( 32 - s, count );
+        quint32 chunk = (quint32)(( value >> ( count - take )) & ((( quint64 ) 1 << take ) - 1 ));
+        if ( w < words )
+            row[ w ] |= chunk << ( 32 - s - take );
+        pos   += take;
+        count -= take;
+    }
+}
+
+
+/* Interleave 'factor' planes of source pixels into one output row, so that
+ * output pixel (x * factor + j) comes from pixel x of plane j.
+ */
+static void interleave( const quint32 * const *planes, int factor, int width,
+                        const QVector<quint64> &table, quint32 *out, int outWords )
+{
+    int bytes = ( width + 7 ) / 8;
+    for ( int b = 0; b < bytes; b++ ) {
+        quint64 chunk = 0;
+        for ( int j = 0; j < factor; j++ ) {
+            uchar v = (uchar)( planes[ j ][ b >> 2 ] >> ( 24 - 8 * ( b & 3 )));
+            chunk |= table.at( v ) << ( factor - 1 - j );
+        }
+        putBits( out, outWords, b * 8 * factor, chunk, 8 * factor );
+    }
+    out[ outWords - 1 ] &= qbfSpanMask( outWords - 1, 0, width * factor );
+}
+
+
+/* Fill in the left (D) and right (F) neighbour rows of a source row.  At the
+ * edges the pixel is its own neighbour, as the algorithms specify.
+ */
+static void neighbourRows( const quint32 *row, int words, int width, quint32 *left, quint32 *right )
+{
+    for ( int k = 0; k < words; k++ ) {
+        left[ k ]  = qbfFetchBits( row, words, ( k << 5 ) - 1 );
+        right[ k ] = qbfFetchBits( row, words, ( k << 5 ) + 1 );
+    }
+    if ( row[ 0 ] & 0x80000000u )
+        left[ 0 ] |= 0x80000000u;
+    if ( row[ ( width - 1 ) >> 5 ] & qbfPixelBit( width - 1 ))
+        right[ ( width - 1 ) >> 5 ] |= qbfPixelBit( width - 1 );
+    right[ words - 1 ] &= qbfSpanMask( words - 1, 0, width );
+}
+
+
+static inline quint32 pick( quint32 cond, quint32 neighbour, quint32 centre )
+{
+    return ( cond & neighbour ) | ( ~cond & centre );
+}
+
+
+static GlyphBitmap scaleNearest( const GlyphBitmap &source, int factor )
+{
+    GlyphBitmap result( source.width() * factor, source.height() * factor );
+    if ( result.isNull() )
+        return result;
+
+    QVector<quint64> table = spreadTable( factor );
+    QVector<const quint32 *> planes( factor );
+    int outWords = result.wordsPerLine();
+
+    for ( int y = 0; y < source.height(); y++ ) {
+        for ( int j = 0; j < factor; j++ )
+            planes[ j ] = source.constScanLine( y );
+        quint32 *out = result.scanLine( y * factor );
+        interleave( planes.constData(), factor, source.width(), table, out, outWords );
+        for ( int j = 1; j < factor; j++ )
+            memcpy( result.scanLine( y * factor + j ), out, outWords * sizeof( quint32 ));
+    }
+    return result;
+}
+
+
+static GlyphBitmap scaleEdges( const GlyphBitmap &source, int factor )
+{
+    GlyphBitmap result( source.width() * factor, source.height() * factor );
+    if ( result.isNull() )
+        return result;
+
+    int width    = source.width();
+    int height   = source.height();
+    int words    = source.wordsPerLine();
+    int outWords = result.wordsPerLine();
+    QVector<quint64> table = spreadTable( factor );
+
+    // Neighbour rows: A B C / D E F / G H I, then nine output planes
+    QVector<quint32> buffer( words * 18 );
+    quint32 *n[ 9 ];
+    quint32 *e[ 9 ];
+    for ( int i = 0; i < 9; i++ ) {
+        n[ i ] = buffer.data() + words * i;
+        e[ i ] = buffer.data() + words * ( 9 + i );
+    }
+
+    for ( int y = 0; y < height; y++ ) {
+        const quint32 *up   = source.constScanLine( qMax( y - 1, 0 ));
+        const quint32 *mid  = source.constScanLine( y );
+        const quint32 *down = source.constScanLine( qMin( y + 1, height - 1 ));
+
+        memcpy( n[ 1 ], up,   words * sizeof( quint32 ));
+        memcpy( n[ 4 ], mid,  words * sizeof( quint32 ));
+        memcpy( n[ 7 ], down, words * sizeof( quint32 ));
+        neighbourRows( up,   words, width, n[ 0 ], n[ 2 ] );
+        neighbourRows( mid,  words, width, n[ 3 ], n[ 5 ] );
+        neighbourRows( down, words, width, n[ 6 ], n[ 8 ] );
+
+        for ( int k = 0; k < words; k++ ) {
+            quint32 A = n[0][k], B = n[1][k], C = n[2][k],
+                    D = n[3][k], E = n[4][k], F = n[5][k],
+                    G = n[6][k], H = n[7][k], I = n[8][k];
+
+            quint32 cDB = ~( D ^ B ) & ( B ^ F ) & ( D ^ H );
+            quint32 cBF = ~( B ^ F ) & ( B ^ D ) & ( F ^ H );
+            quint32 cDH = ~( D ^ H ) & ( D ^ B ) & ( H ^ F );
+            quint32 cHF = ~( H ^ F ) & ( D ^ H ) & ( B ^ F );
+
+            if ( factor == 2 ) {
+                e[0][k] = pick( cDB, D, E );
+                e[1][k] = pick( cBF, F, E );
+                e[2][k] = pick( cDH, D, E );
+                e[3][k] = pick( cHF, F, E );
+            }
+            else {
+                e[0][k] = pick( cDB, D, E );
+                e[1][k] = pick(( cDB & ( E ^ C )) | ( cBF & ( E ^ A )), B, E );
+                e[2][k] = pick( cBF, F, E );
+                e[3][k] = pick(( cDB & ( E ^ G )) | ( cDH & ( E ^ A )), D, E );
+                e[4][k] = E;
+                e[5][k] = pick(( cBF & ( E ^ I )) | ( cHF & ( E ^ C )), F, E );
+                e[6][k] = pick( cDH, D, E );
+                e[7][k] = pick(( cDH & ( E ^ I )) | ( cHF & ( E ^ G )), H, E );
+                e[8][k] = pick( cHF, F, E );
+            }
+        }
+
+        for ( int j = 0; j < factor; j++ )
+            interleave( e + j * factor, factor, width, table,
+                        result.scanLine( y * factor + j ), outWords );
+    }
+    return result;
+}
+
+
+// ---------------------------------------------------------------------------
+// Applies the scaler to one glyph of a font in place (for QtConcurrent).
+//
+struct GlyphScaleJob
+{
+    typedef void result_type;
+
+    GlyphScaleJob( GlyphScaler::Method m, int f ): method( m ), factor( f ) {}
+    void operator()( GlyphBitmap &glyph ) const { glyph = GlyphScaler::scale( glyph, method, factor ); }
+
+    GlyphScaler::Method method;
+    int                 factor;
+};
+
+
+// ---------------------------------------------------------------------------
+// GlyphScaler::scale
+//
+// Scale a glyph bitmap by the given factor.  Scale2x accepts a factor of 2
+// or 4 (applying itself twice); Scale3x only a factor of 3.  Any other
+// combination falls back to pixel replication.
+//
+GlyphBitmap GlyphScaler::scale( const GlyphBitmap &source, Method method, int factor )
+{
+    if ( source.isNull() || factor < 1 )
+        return source;
+    if ( factor == 1 )
+        return source;
+
+    if ( method == Scale2x && factor == 2 )
+        return scaleEdges( source, 2 );
+    if ( method == Scale2x && factor == 4 )
+        return scaleEdges( scaleEdges( source, 2 ), 2 );
+    if ( method == Scale3x && factor == 3 )
+        return scaleEdges( source, 3 );
+    return scaleNearest( source, factor );
+}
+
+
+// ---------------------------------------------------------------------------
+// GlyphScaler::scaleFont
+//
+// Create a new font document with every glyph of the source font scaled.
+// The glyphs are scaled in parallel across all available cores; the
+// source document is only read.  Kerning amounts are scaled to match.
+//
+FontDocument *GlyphScaler::scaleFont( const FontDocument *source, Method method, int factor, QObject *parent )
+{
+    QVector<GlyphBitmap> glyphs( source->glyphCount() );
+    for ( int i = 0; i < glyphs.size(); i++ )
+        glyphs[ i ] = source->decodeGlyph( i );
+
+    QtConcurrent::blockingMap( glyphs, GlyphScaleJob( method, factor ));
+
+    FontDocument *result = new FontDocument( parent );
+    result->setFamilyName( source->familyName() );
+    result->setFaceName( source->faceName() );
+    result->setCodePage( source->codePage() );
+    result->setFirstChar( source->firstChar() );
+    result->setPointSize( source->pointSize() * factor );
+    result->setBaseLine( source->baseLine() * factor );
+    result->setGlyphs( glyphs );
+
+    QVector<KerningPair> pairs = source->kerning().sorted();
+    for ( int i = 0; i < pairs.size(); i++ )
+        pairs[ i ].amount = qBound( -32768, pairs.at( i ).amount * factor, 32767 );
+    result->setKerningPairs( pairs );
+    return result;
+}
@@ -0,0 +1,44 @@
+/******************************************************************************
+** glyphscaler.h
+**
+** Pixel-art upscaling of glyph bitmaps and whole fonts.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHSCALER_H
+#define GLYPHSCALER_H
+
+#include "glyphbitmap.h"
+
+class QObject;
+class FontDocument;
+
+
+namespace GlyphScaler {
+    enum Method {
+        Nearest,        // plain pixel replication, any factor
+        Scale2x,        // Scale2x/EPX edge rules (2x, or 4x when applied twice)
+        Scale3x         // Scale3x edge rules (3x)
+    };
+
+    GlyphBitmap   scale( const GlyphBitmap &source, Method method, int factor );
+    FontDocument *scaleFont( const FontDocument *source, Method method, int factor, QObject *parent = 0 );
+};
+
+#endif  // GLYPHSCALER_H
@@ -0,0 +1,224 @@
+/******************************************************************************
+** glyphsimilarity.cpp
+**
+** An index for finding glyphs which look like a given glyph.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QStack>
+
+#include "glyphsimilarity.h"
+
+
+// ---------------------------------------------------------------------------
+// FINGERPRINTS
+//
+
+/* Glyphs which fit are copied as they are.  Larger ones are reduced by a
+ * whole factor, a fingerprint pixel being set if any pixel in its block is,
+ * so that thin strokes survive.
+ */
+GlyphFingerprint GlyphFingerprint::fromGlyph( const GlyphBitmap &glyph )
+{
+    GlyphFingerprint print;
+    qFill( print.rows, print.rows + FINGERPRINT_SIZE, 0u );
+    if ( glyph.isNull() )
+        return print;
+
+    int width  = glyph.width();
+    int height = glyph.height();
+    if ( width <= FINGERPRINT_SIZE && height <= FINGERPRINT_SIZE ) {
+        for ( int y = 0; y < height; y++ )
+            print.rows[ y ] = glyph.constScanLine( y )[ 0 ];
+        return print;
+    }
+
+    int     step  = qMin(( qMax( width, height ) + FINGERPRINT_SIZE - 1 ) / FINGERPRINT_SIZE, 32 );
+    quint32 block = ( step < 32 )? ~( 0xFFFFFFFFu >> step ): 0xFFFFFFFFu;
+    int     words = glyph.wordsPerLine();
+    for ( int y = 0; y < height && y / step < FINGERPRINT_SIZE; y++ ) {
+        const quint32 *row = glyph.constScanLine( y );
+        quint32 &out = print.rows[ y / step ];
+        for ( int x = 0; x < FINGERPRINT_SIZE && x * step < width; x++ ) {
+            if ( qbfFetchBits( row, words, x * step ) & block )
+                out |= qbfPixelBit( x );
+        }
+    }
+    return print;
+}
+
+
+int GlyphFingerprint::distance( const GlyphFingerprint &other ) const
+{
+    int count = 0;
+    for ( int i = 0; i < FINGERPRINT_SIZE; i++ )
+        count += qbfPopCount( rows[ i ] ^ other.rows[ i ] );
+    return count;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+GlyphSimilarityIndex::GlyphSimilarityIndex( FontDocument *document, QObject *parent ): QObject( parent )
+{
+    doc = document;
+    iMoved = 0;
+    bBuilt = false;
+    if ( doc )
+        connect( doc, SIGNAL( glyphChanged( int )), this, SLOT( updateGlyph( int )));
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* Return up to 'count' glyphs no more than 'maxDistance' pixels different
+ * from the given one, nearest first.  The glyph at index 'exclude' (usually
+ * the one being searched for) is left out.
+ *
+ * The search walks the tree keeping a radius which starts at maxDistance
+ * and shrinks to the distance of the furthest match once 'count' have been
+ * found; by the triangle inequality, only children whose distance from
+ * their parent is within that radius of the query's can hold a match.
+ */
+QList<GlyphSimilarityIndex::Match> GlyphSimilarityIndex::nearest( const GlyphBitmap &glyph, int count, int maxDistance, int exclude )
+{
+    QList<Match> matches;
+    if ( !doc || count < 1 )
+        return matches;
+    if ( !bBuilt || glyphNodes.size() != doc->glyphCount() )
+        rebuild();
+    if ( nodes.isEmpty() )
+        return matches;
+
+    GlyphFingerprint query = GlyphFingerprint::fromGlyph( glyph );
+    int radius = maxDistance;
+
+    QStack<int> pending;
+    pending.push( 0 );
+    while ( !pending.isEmpty() ) {
+        const Node &node = nodes.at( pending.pop() );
+        int d = query.distance( node.print );
+
+        if ( d <= radius ) {
+            for ( int i = 0; i < node.glyphs.size(); i++ ) {
+                if ( node.glyphs.at( i ) == exclude )
+                    continue;
+                int pos = matches.size();
+                while ( pos > 0 && matches.at( pos - 1 ).distance > d )
+                    pos--;
+                if ( pos >= count )
+                    break;
+                Match match = { node.glyphs.at( i ), d };
+                matches.insert( pos, match );
+                if ( matches.size() > count )
+                    matches.removeLast();
+            }
+            if ( matches.size() == count )
+                radius = qMin( radius, matches.last().distance );
+        }
+
+        for ( int child = node.firstChild; child >= 0; child = nodes.at( child ).nextSibling ) {
+            if ( qAbs( nodes.at( child ).distance - d ) <= radius )
+                pending.push( child );
+        }
+    }
+    return matches;
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void GlyphSimilarityIndex::updateGlyph( int index )
+{
+    if ( !bBuilt )
+        return;
+    if ( index < 0 || index >= glyphNodes.size() ) {
+        bBuilt = false;
+        return;
+    }
+
+    QVector<int> &members = nodes[ glyphNodes.at( index ) ].glyphs;
+    members.remove( members.indexOf( index ));
+    insert( index, GlyphFingerprint::fromGlyph( doc->glyph( index )));
+    if ( ++iMoved > glyphNodes.size() )
+        bBuilt = false;
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+void GlyphSimilarityIndex::rebuild()
+{
+    int count = doc->glyphCount();
+    nodes.clear();
+    nodes.reserve( count );
+    glyphNodes.fill( -1, count );
+    for ( int i = 0; i < count; i++ )
+        insert( i, GlyphFingerprint::fromGlyph( doc->decodeGlyph( i )));
+    iMoved = 0;
+    bBuilt = true;
+}
+
+
+void GlyphSimilarityIndex::insert( int glyph, const GlyphFingerprint &print )
+{
+    Node node;
+    node.print       = print;
+    node.distance    = 0;
+    node.firstChild  = -1;
+    node.nextSibling = -1;
+    node.glyphs.append( glyph );
+
+    if ( nodes.isEmpty() ) {
+        nodes.append( node );
+        glyphNodes[ glyph ] = 0;
+        return;
+    }
+
+    int current = 0;
+    forever {
+        int d = print.distance( nodes.at( current ).print );
+        if ( d == 0 ) {
+            nodes[ current ].glyphs.append( glyph );
+            glyphNodes[ glyph ] = current;
+            return;
+        }
+
+        int child = nodes.at( current ).firstChild;
+        while ( child >= 0 && nodes.at( child ).distance != d )
+            child = nodes.at( child ).nextSibling;
+        if ( child < 0 ) {
+            node.distance    = d;
+            node.nextSibling = nodes.at( current ).firstChild;
+            nodes.append( node );
+            nodes[ current ].firstChild = nodes.size() - 1;
+            glyphNodes[ glyph ] = nodes.size() - 1;
+            return;
+        }
+        current = child;
+    }
+}
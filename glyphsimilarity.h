@@ -0,0 +1,96 @@
+/******************************************************************************
+** glyphsimilarity.h
+**
+** An index for finding glyphs which look like a given glyph.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHSIMILARITY_H
+#define GLYPHSIMILARITY_H
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+
+#include "fontdocument.h"
+
+// Size of a glyph fingerprint, in pixels each way
+#define FINGERPRINT_SIZE    32
+
+
+/* Each glyph is reduced to a 32x32 pixel fingerprint: the top left of the
+ * glyph as it is, or the whole glyph sampled down if it is larger than
+ * that.  Two glyphs are as similar as the number of fingerprint pixels in
+ * which they differ is small.
+ */
+struct GlyphFingerprint
+{
+    quint32 rows[ FINGERPRINT_SIZE ];
+
+    static GlyphFingerprint fromGlyph( const GlyphBitmap &glyph );
+    int distance( const GlyphFingerprint &other ) const;
+};
+
+
+/* The fingerprints of every glyph in a document, held in a BK-tree so that
+ * a search only has to look at the part of the font within reach of the
+ * distance limit.  Glyphs with identical fingerprints (blank ones, for a
+ * start) share a node.  The tree is built on the first search, and kept up
+ * to date from then on as glyphs change: a changed glyph is dropped from
+ * its old node and inserted afresh, and the tree is rebuilt once the number
+ * of such moves exceeds the number of glyphs.
+ */
+class GlyphSimilarityIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Match {
+        int index;
+        int distance;
+    };
+
+    GlyphSimilarityIndex( FontDocument *document, QObject *parent = 0 );
+
+    QList<Match> nearest( const GlyphBitmap &glyph, int count, int maxDistance, int exclude = -1 );
+
+private slots:
+    void updateGlyph( int index );
+
+private:
+    struct Node {
+        GlyphFingerprint print;
+        QVector<int> glyphs;    // every glyph with this fingerprint (may be none)
+        int  distance;          // from the parent node
+        int  firstChild;
+        int  nextSibling;
+    };
+
+    void rebuild();
+    void insert( int glyph, const GlyphFingerprint &print );
+
+    QPointer<FontDocument> doc;
+    QVector<Node> nodes;
+    QVector<int>  glyphNodes;   // the node holding each glyph
+    int           iMoved;
+    bool          bBuilt;
+};
+
+#endif  // GLYPHSIMILARITY_H
@@ -0,0 +1,197 @@
+/******************************************************************************
+** glyphstore.cpp
+**
+** Compressed storage for the glyphs of a font, with a shared decode cache.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "glyphpool.h"
+#include "glyphstore.h"
+
+// Default size of the decode cache, in kilobytes
+#define DEFAULT_CACHE_KB    8192
+
+// Overhead counted for each cached glyph on top of its pixels
+#define CACHE_ENTRY_COST    64
+
+/* A decoded glyph keeps a reference to the runs it came from.  The cache is
+ * keyed on the address of those runs, which therefore can't be freed and
+ * reused for a different glyph while the entry exists, so entries never go
+ * stale.  Entries are only removed so that the runs can be purged from the
+ * pool: that of a glyph being replaced, and all of a store being cleared.
+ */
+struct CachedGlyph
+{
+    CachedGlyph( const QByteArray &r, const GlyphBitmap &b ): runs( r ), bitmap( b ) {}
+
+    QByteArray  runs;
+    GlyphBitmap bitmap;
+};
+
+class GlyphCache : public QCache<quintptr, CachedGlyph>
+{
+public:
+    GlyphCache(): QCache<quintptr, CachedGlyph>( DEFAULT_CACHE_KB * 1024 ) {}
+};
+
+Q_GLOBAL_STATIC( GlyphCache, glyphCache )
+Q_GLOBAL_STATIC( QMutex, cacheMutex )
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static inline quintptr cacheKey( const QByteArray &runs )
+{
+    return (quintptr) runs.constData();
+}
+
+
+static void cacheGlyph( const QByteArray &runs, const GlyphBitmap &bitmap )
+{
+    int cost = bitmap.wordsPerLine() * bitmap.height() * sizeof( quint32 ) + CACHE_ENTRY_COST;
+    QMutexLocker lock( cacheMutex() );
+    glyphCache()->insert( cacheKey( runs ), new CachedGlyph( runs, bitmap ), cost );
+}
+
+
+static inline GlyphBitmap decodeRuns( const QByteArray &runs )
+{
+    return GlyphBitmap::fromRuns( (const uchar *) runs.constData(), runs.size() );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* Return a glyph, from the cache if it is there.  This may be called from
+ * several threads at once, as long as the store isn't being changed.
+ */
+GlyphBitmap GlyphStore::at( int index ) const
+{
+    if ( index < 0 || index >= runs.size() )
+        return GlyphBitmap();
+
+    const QByteArray &glyphRuns = runs.at( index );
+    {
+        QMutexLocker lock( cacheMutex() );
+        CachedGlyph *cached = glyphCache()->object( cacheKey( glyphRuns ));
+        if ( cached )
+            return cached->bitmap;
+    }
+
+    // Decode without holding the lock; two threads may both do so, harmlessly
+    GlyphBitmap bitmap = decodeRuns( glyphRuns );
+    cacheGlyph( glyphRuns, bitmap );
+    return bitmap;
+}
+
+
+/* Return a glyph without going through the cache, for passes over the whole
+ * font which would otherwise push out the glyphs actually being viewed.
+ * Like at(), this may be called from several threads at once.
+ */
+GlyphBitmap GlyphStore::decode( int index ) const
+{
+    if ( index < 0 || index >= runs.size() )
+        return GlyphBitmap();
+    return decodeRuns( runs.at( index ));
+}
+
+
+/* Replace a glyph.  The new bitmap goes straight into the cache, since a
+ * glyph which has just been edited is likely to be looked at again, while
+ * the one it replaces is dropped from the cache; otherwise the cache would
+ * keep every intermediate state of an edited glyph from being purged.
+ */
+void GlyphStore::set( int index, const GlyphBitmap &bitmap )
+{
+    if ( index < 0 || index >= runs.size() )
+        return;
+    QByteArray replaced = runs.at( index );
+    runs[ index ] = GlyphPool::intern( bitmap.toRuns() );
+    {
+        QMutexLocker lock( cacheMutex() );
+        glyphCache()->remove( cacheKey( replaced ));
+    }
+    cacheGlyph( runs.at( index ), bitmap );
+}
+
+
+/* Replace all the glyphs.  Bitmaps which are shared with the one before
+ * (e.g. the blank cells of a new font) are only encoded once.
+ */
+void GlyphStore::assign( const QVector<GlyphBitmap> &bitmaps )
+{
+    QVector<QByteArray> encoded( bitmaps.size() );
+    for ( int i = 0; i < bitmaps.size(); i++ ) {
+        if ( i > 0 && bitmaps.at( i ).isSharedWith( bitmaps.at( i - 1 )))
+            encoded[ i ] = encoded.at( i - 1 );
+        else
+            encoded[ i ] = bitmaps.at( i ).toRuns();
+    }
+    GlyphPool::intern( encoded );
+    runs = encoded;
+}
+
+
+/* Make every glyph the same bitmap, e.g. the blank cells of a new font.
+ */
+void GlyphStore::fill( const GlyphBitmap &bitmap, int count )
+{
+    runs.fill( GlyphPool::intern( bitmap.toRuns() ), qMax( count, 0 ));
+}
+
+
+/* Drop every glyph, along with its decoded bitmap, since the cache would
+ * otherwise keep the glyph's runs from being purged from the pool.
+ */
+void GlyphStore::clear()
+{
+    {
+        QMutexLocker lock( cacheMutex() );
+        for ( int i = 0; i < runs.size(); i++ )
+            glyphCache()->remove( cacheKey( runs.at( i )));
+    }
+    runs.clear();
+}
+
+
+/* Set the amount of memory, in kilobytes, which may be used by decoded
+ * glyphs across all open fonts.
+ */
+void GlyphStore::setCacheLimit( int kilobytes )
+{
+    QMutexLocker lock( cacheMutex() );
+    glyphCache()->setMaxCost( qMax( kilobytes, 64 ) * 1024 );
+}
+
+
+int GlyphStore::cacheLimit()
+{
+    QMutexLocker lock( cacheMutex() );
+    return glyphCache()->maxCost() / 1024;
+}
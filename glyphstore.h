@@ -0,0 +1,62 @@
+/******************************************************************************
+** glyphstore.h
+**
+** Compressed storage for the glyphs of a font, with a shared decode cache.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#ifndef GLYPHSTORE_H
+#define GLYPHSTORE_H
+
+#include <QByteArray>
+#include <QVector>
+
+#include "glyphbitmap.h"
+
+
+/* Holds a font's glyphs in their run-length form (see GlyphBitmap::toRuns).
+ * Each glyph's runs are interned through GlyphPool, so identical glyphs, in
+ * this font or any other, share one copy.  Glyphs are decoded on demand
+ * through a cache shared by every store, which keeps the most recently used
+ * bitmaps up to a configurable amount of memory; since the cache is keyed
+ * on the shared runs, identical glyphs share their decoded bitmap as well.
+ *
+ * Copies of a store share its glyphs until either is changed.
+ */
+class GlyphStore
+{
+public:
+    int         size() const { return runs.size(); }
+    GlyphBitmap at( int index ) const;
+    GlyphBitmap decode( int index ) const;
+
+    void        set( int index, const GlyphBitmap &bitmap );
+    void        assign( const QVector<GlyphBitmap> &bitmaps );
+    void        fill( const GlyphBitmap &bitmap, int count );
+    void        clear();
+
+    static void setCacheLimit( int kilobytes );
+    static int  cacheLimit();
+
+private:
+    QVector<QByteArray> runs;       // interned run-length form of each glyph
+};
+
+#endif  // GLYPHSTORE_H
@@ -0,0 +1,171 @@
+/******************************************************************************
+** glyphstyler.cpp
+**
+** Synthesised bold and oblique styles of glyph bitmaps and whole fonts.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QtConcurrentMap>
+
+#include "fontdocument.h"
+#include "glyphstyler.h"
+
+
+// ---------------------------------------------------------------------------
+// Applies the styles to one glyph of a font in place (for QtConcurrent).
+//
+struct GlyphStyleJob
+{
+    typedef void result_type;
+
+    GlyphStyleJob( const GlyphStyler::Options &o, int b ): options( o ), baseLine( b ) {}
+    void operator()( GlyphBitmap &glyph ) const { glyph = GlyphStyler::style( glyph, options, baseLine ); }
+
+    GlyphStyler::Options options;
+    int                  baseLine;
+};
+
+
+// ---------------------------------------------------------------------------
+// GlyphStyler::embolden
+//
+// Thicken every vertical stroke by the given number of pixels.  Each output
+// word is the OR of the source row fetched at each shift, so the cost is
+// one pass per pixel of weight over the packed words rather than per pixel.
+//
+GlyphBitmap GlyphStyler::embolden( const GlyphBitmap &source, int weight, bool widen )
+{
+    if ( source.isNull() || weight < 1 )
+        return source;
+
+    int width    = source.width() + ( widen ? weight : 0 );
+    int inWords  = source.wordsPerLine();
+    GlyphBitmap result( width, source.height() );
+    int outWords = result.wordsPerLine();
+
+    for ( int y = 0; y < source.height(); y++ ) {
+        const quint32 *in  = source.constScanLine( y );
+        quint32       *out = result.scanLine( y );
+        for ( int k = 0; k < outWords; k++ ) {
+            quint32 bits = 0;
+            for ( int s = 0; s <= weight; s++ )
+                bits |= qbfFetchBits( in, inWords, ( k << 5 ) - s );
+            out[ k ] = bits & qbfSpanMask( k, 0, width );
+        }
+    }
+    return result;
+}
+
+
+// ---------------------------------------------------------------------------
+// GlyphStyler::slant
+//
+// Shear the glyph to the right by one pixel for every slantRows rows above
+// the baseline (given, as in FontDocument, as the number of rows below it).
+// The shift is measured from the middle of each row, so the rows either
+// side of the baseline stay put.
+//
+GlyphBitmap GlyphStyler::slant( const GlyphBitmap &source, int slantRows, int baseLine )
+{
+    if ( source.isNull() || slantRows < 1 )
+        return source;
+
+    int width   = source.width();
+    int words   = source.wordsPerLine();
+    int baseRow = source.height() - baseLine;       // first row below the baseline
+    GlyphBitmap result( width, source.height() );
+
+    for ( int y = 0; y < source.height(); y++ ) {
+        // Rounded (baseRow - y - 0.5) / slantRows, in integers
+        int twice = 2 * ( baseRow - y ) - 1;
+        int shift = ( twice >= 0 ) ? ( twice + slantRows ) / ( 2 * slantRows )
+                                   : -(( -twice + slantRows ) / ( 2 * slantRows ));
+        const quint32 *in  = source.constScanLine( y );
+        quint32       *out = result.scanLine( y );
+        for ( int k = 0; k < words; k++ )
+            out[ k ] = qbfFetchBits( in, words, ( k << 5 ) - shift ) & qbfSpanMask( k, 0, width );
+    }
+    return result;
+}
+
+
+// ---------------------------------------------------------------------------
+// GlyphStyler::style
+//
+// Embolden and then slant a glyph, as the options ask.
+//
+GlyphBitmap GlyphStyler::style( const GlyphBitmap &source, const Options &options, int baseLine )
+{
+    return slant( embolden( source, options.weight, options.widen ), options.slantRows, baseLine );
+}
+
+
+// ---------------------------------------------------------------------------
+// GlyphStyler::styleName
+//
+// The face name of a styled font, e.g. "Bold Italic" from "Regular".  The
+// face name may already have the style, either in English (as most fonts
+// are named) or as translated, which is the word that would be added.
+//
+QString GlyphStyler::styleName( const QString &faceName, const Options &options )
+{
+    QString bold   = QCoreApplication::translate("GlyphStyler", "Bold");
+    QString italic = QCoreApplication::translate("GlyphStyler", "Italic");
+
+    QStringList words = faceName.split(' ', QString::SkipEmptyParts );
+    words.removeAll("Regular");
+    words.removeAll("Normal");
+    words.removeAll("Roman");
+    if ( options.weight > 0 && !words.contains("Bold") && !words.contains( bold ))
+        words << bold;
+    if ( options.slantRows > 0 && !words.contains("Italic") && !words.contains("Oblique") && !words.contains( italic ))
+        words << italic;
+    return words.join(" ");
+}
+
+
+// ---------------------------------------------------------------------------
+// GlyphStyler::styleFont
+//
+// Create a new font document with every glyph of the source font styled.
+// As with GlyphScaler::scaleFont(), the glyphs are read from the source
+// first and then styled in parallel across all available cores.  Kerning
+// pairs are copied unchanged.
+//
+FontDocument *GlyphStyler::styleFont( const FontDocument *source, const Options &options, QObject *parent )
+{
+    QVector<GlyphBitmap> glyphs( source->glyphCount() );
+    for ( int i = 0; i < glyphs.size(); i++ )
+        glyphs[ i ] = source->decodeGlyph( i );
+
+    QtConcurrent::blockingMap( glyphs, GlyphStyleJob( options, source->baseLine() ));
+
+    FontDocument *result = new FontDocument( parent );
+    result->setFamilyName( source->familyName() );
+    result->setFaceName( styleName( source->faceName(), options ));
+    result->setCodePage( source->codePage() );
+    result->setFirstChar( source->firstChar() );
+    result->setPointSize( source->pointSize() );
+    result->setBaseLine( source->baseLine() );
+    result->setGlyphs( glyphs );
+    result->setKerningPairs( source->kerning().sorted() );
+    return result;
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+** glyphstyler.h
+**
+** Synthesised bold and oblique styles of glyph bitmaps and whole fonts.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef GLYPHSTYLER_H
+#define GLYPHSTYLER_H
+
+#include "glyphbitmap.h"
+
+class QObject;
+class FontDocument;
+
+
+/* Emboldening ORs each row with copies of itself shifted 1..weight pixels
+ * to the right, optionally widening the glyph (and so its increment) by
+ * the same amount so that nothing is lost at the right edge.  Slanting
+ * shifts each row by the slope times its height above the baseline: right
+ * above it, left below it.  The increment is kept, so ink slanted past
+ * either edge of the cell is clipped.  Both work a whole packed word at a
+ * time.
+ */
+namespace GlyphStyler {
+    struct Options {
+        Options(): weight( 0 ), widen( true ), slantRows( 0 ) {}
+
+        int  weight;        // extra pixels of stroke width, 0 for none
+        bool widen;         // grow the increment by the weight
+        int  slantRows;     // rows per pixel of slant (e.g. 4 for 1:4), 0 for none
+    };
+
+    GlyphBitmap   embolden( const GlyphBitmap &source, int weight, bool widen );
+    GlyphBitmap   slant( const GlyphBitmap &source, int slantRows, int baseLine );
+    GlyphBitmap   style( const GlyphBitmap &source, const Options &options, int baseLine );
+    QString       styleName( const QString &faceName, const Options &options );
+    FontDocument *styleFont( const FontDocument *source, const Options &options, QObject *parent = 0 );
+};
+
+#endif  // GLYPHSTYLER_H
@@ -0,0 +1,94 @@
+/******************************************************************************
+** headerdialog.cpp
+**
+** Options for exporting a font as a C/C++ header.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "headerdialog.h"
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+HeaderDialog::HeaderDialog( const QString &name, QWidget *parent ): QDialog( parent )
+{
+    nameEdit = new QLineEdit( name );
+    nameEdit->setValidator( new QRegExpValidator( QRegExp("[A-Za-z_][A-Za-z0-9_]*"), this ));
+
+    layoutCombo = new QComboBox();
+    layoutCombo->addItem( tr("Rows, top to bottom") );
+    layoutCombo->addItem( tr("Columns, left to right") );
+
+    bitOrderCombo = new QComboBox();
+    bitOrderCombo->addItem( tr("Most significant bit first") );
+    bitOrderCombo->addItem( tr("Least significant bit first") );
+
+    QLabel *nameLabel = new QLabel( tr("&Name prefix:") );
+    nameLabel->setBuddy( nameEdit );
+    QLabel *layoutLabel = new QLabel( tr("&Pixel order:") );
+    layoutLabel->setBuddy( layoutCombo );
+    QLabel *bitOrderLabel = new QLabel( tr("&Bit order:") );
+    bitOrderLabel->setBuddy( bitOrderCombo );
+
+    QDialogButtonBox *buttons = new QDialogButtonBox( QDialogButtonBox::Ok | QDialogButtonBox::Cancel );
+    connect( buttons, SIGNAL( accepted() ), this, SLOT( accept() ));
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( reject() ));
+    connect( nameEdit, SIGNAL( textChanged( const QString & )), this, SLOT( updateButtons() ));
+    okButton = buttons->button( QDialogButtonBox::Ok );
+
+    QGridLayout *layout = new QGridLayout();
+    layout->addWidget( nameLabel, 0, 0 );
+    layout->addWidget( nameEdit, 0, 1 );
+    layout->addWidget( layoutLabel, 1, 0 );
+    layout->addWidget( layoutCombo, 1, 1 );
+    layout->addWidget( bitOrderLabel, 2, 0 );
+    layout->addWidget( bitOrderCombo, 2, 1 );
+    layout->addWidget( buttons, 3, 0, 1, 2 );
+    setLayout( layout );
+
+    setWindowTitle( tr("Export C Header") );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+FontHeader::Options HeaderDialog::options() const
+{
+    FontHeader::Options options;
+    options.name        = nameEdit->text();
+    options.columnMajor = ( layoutCombo->currentIndex() == 1 );
+    options.lsbFirst    = ( bitOrderCombo->currentIndex() == 1 );
+    return options;
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void HeaderDialog::updateButtons()
+{
+    okButton->setEnabled( !nameEdit->text().isEmpty() );
+}
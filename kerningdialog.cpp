@@ -0,0 +1,317 @@
+/******************************************************************************
+** kerningdialog.cpp
+**
+** Editing the kerning pairs of a font, with a kerned sample.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "glyphnames.h"
+#include "kerningdialog.h"
+#include "kerningpreview.h"
+
+// Largest kerning adjustment offered, in pixels either way
+#define MAX_KERNING_AMOUNT  255
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static inline uint pairKey( int first, int second )
+{
+    return ( (uint) first << 16 ) | (uint) second;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+KerningDialog::KerningDialog( QWidget *parent ): QDialog( parent )
+{
+    bEditing = false;
+
+    sampleEdit = new QLineEdit( tr("AVATAR To Yo WAVE Ty LT") );
+    kerningCheck = new QCheckBox( tr("&Apply kerning") );
+    kerningCheck->setChecked( true );
+    preview = new KerningPreview();
+    preview->setText( sampleEdit->text() );
+    connect( sampleEdit, SIGNAL( textChanged( const QString & )), this, SLOT( updateButtons() ));
+    connect( kerningCheck, SIGNAL( toggled( bool )), this, SLOT( updateButtons() ));
+
+    QLabel *sampleLabel = new QLabel( tr("Sa&mple:") );
+    sampleLabel->setBuddy( sampleEdit );
+
+    pairTree = new QTreeWidget();
+    pairTree->setRootIsDecorated( false );
+    pairTree->setUniformRowHeights( true );
+    pairTree->setHeaderLabels( QStringList() << tr("First") << tr("Second") << tr("Amount") );
+    connect( pairTree, SIGNAL( itemSelectionChanged() ), this, SLOT( selectPair() ));
+
+    firstEdit  = new QLineEdit();
+    secondEdit = new QLineEdit();
+    firstEdit->setToolTip( tr("A character, or its number in the font's code page") );
+    secondEdit->setToolTip( firstEdit->toolTip() );
+    amountSpin = new QSpinBox();
+    amountSpin->setRange( -MAX_KERNING_AMOUNT, MAX_KERNING_AMOUNT );
+    connect( firstEdit, SIGNAL( textChanged( const QString & )), this, SLOT( updateButtons() ));
+    connect( secondEdit, SIGNAL( textChanged( const QString & )), this, SLOT( updateButtons() ));
+
+    QLabel *firstLabel = new QLabel( tr("&First:") );
+    firstLabel->setBuddy( firstEdit );
+    QLabel *secondLabel = new QLabel( tr("S&econd:") );
+    secondLabel->setBuddy( secondEdit );
+    QLabel *amountLabel = new QLabel( tr("Am&ount:") );
+    amountLabel->setBuddy( amountSpin );
+
+    setButton    = new QPushButton( tr("&Set") );
+    removeButton = new QPushButton( tr("&Remove") );
+    connect( setButton, SIGNAL( clicked() ), this, SLOT( setPair() ));
+    connect( removeButton, SIGNAL( clicked() ), this, SLOT( removePair() ));
+
+    QDialogButtonBox *buttons = new QDialogButtonBox( QDialogButtonBox::Close );
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( close() ));
+
+    QHBoxLayout *sampleLayout = new QHBoxLayout();
+    sampleLayout->addWidget( sampleLabel );
+    sampleLayout->addWidget( sampleEdit, 1 );
+    sampleLayout->addWidget( kerningCheck );
+
+    QHBoxLayout *editLayout = new QHBoxLayout();
+    editLayout->addWidget( firstLabel );
+    editLayout->addWidget( firstEdit );
+    editLayout->addWidget( secondLabel );
+    editLayout->addWidget( secondEdit );
+    editLayout->addWidget( amountLabel );
+    editLayout->addWidget( amountSpin );
+    editLayout->addWidget( setButton );
+    editLayout->addWidget( removeButton );
+
+    QVBoxLayout *layout = new QVBoxLayout();
+    layout->addLayout( sampleLayout );
+    layout->addWidget( preview );
+    layout->addWidget( pairTree, 1 );
+    layout->addLayout( editLayout );
+    layout->addWidget( buttons );
+    setLayout( layout );
+
+    setWindowTitle( tr("Kerning Pairs") );
+    updateButtons();
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+void KerningDialog::setDocument( FontDocument *document )
+{
+    if ( doc )
+        disconnect( doc, 0, this, 0 );
+    doc = document;
+    if ( doc )
+        connect( doc, SIGNAL( kerningChanged() ), this, SLOT( refresh() ));
+    preview->setDocument( doc );
+    refresh();
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+/* Refill the list from the document, unless the change is one of our own
+ * edits, which applyPair() has already made to the list.
+ */
+void KerningDialog::refresh()
+{
+    if ( bEditing )
+        return;
+
+    pairTree->clear();
+    if ( doc ) {
+        if ( !lookup.isBuiltFor( doc ))
+            lookup.build( doc );
+
+        QVector<KerningPair> pairs = doc->kerning().sorted();
+        QList<QTreeWidgetItem *> items;
+        for ( int i = 0; i < pairs.size(); i++ ) {
+            const KerningPair &pair = pairs.at( i );
+            QTreeWidgetItem *item = new QTreeWidgetItem();
+            item->setData( 0, Qt::UserRole, pairKey( pair.first, pair.second ));
+            item->setText( 0, describeCharacter( pair.first ));
+            item->setText( 1, describeCharacter( pair.second ));
+            item->setText( 2, QString::number( pair.amount ));
+            items.append( item );
+        }
+        pairTree->addTopLevelItems( items );
+    }
+    updateButtons();
+}
+
+
+/* The characters are written in hex with a 0x prefix, so that those from 0
+ * to 9 are not read back by parseCharacter() as the digit glyphs.
+ */
+void KerningDialog::selectPair()
+{
+    QTreeWidgetItem *item = pairTree->currentItem();
+    if ( !item || !item->isSelected() )
+        return;
+    uint key = item->data( 0, Qt::UserRole ).toUInt();
+    firstEdit->setText( QString("0x%1").arg( key >> 16, 2, 16, QChar('0') ));
+    secondEdit->setText( QString("0x%1").arg( key & 0xFFFF, 2, 16, QChar('0') ));
+    amountSpin->setValue( item->text( 2 ).toInt() );
+}
+
+
+void KerningDialog::setPair()
+{
+    int first  = parseCharacter( firstEdit->text() );
+    int second = parseCharacter( secondEdit->text() );
+    if ( first >= 0 && second >= 0 )
+        applyPair( first, second, amountSpin->value() );
+}
+
+
+void KerningDialog::removePair()
+{
+    int first  = parseCharacter( firstEdit->text() );
+    int second = parseCharacter( secondEdit->text() );
+    if ( first >= 0 && second >= 0 )
+        applyPair( first, second, 0 );
+}
+
+
+void KerningDialog::updateButtons()
+{
+    preview->setText( sampleEdit->text() );
+    preview->setKerningEnabled( kerningCheck->isChecked() );
+
+    bool valid = doc && parseCharacter( firstEdit->text() ) >= 0
+                     && parseCharacter( secondEdit->text() ) >= 0;
+    setButton->setEnabled( valid );
+    removeButton->setEnabled( valid && findItem( parseCharacter( firstEdit->text() ),
+                                                 parseCharacter( secondEdit->text() )));
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+/* A single character is looked up in the font; anything else is read as a
+ * number (decimal, or hex with 0x) in the font's code page.  Returns -1
+ * unless the font has a glyph for the character.
+ */
+int KerningDialog::parseCharacter( const QString &text )
+{
+    if ( !doc || text.isEmpty() )
+        return -1;
+
+    if ( text.length() == 1 ) {
+        if ( !lookup.isBuiltFor( doc ))
+            lookup.build( doc );
+        int index = lookup.glyphForCodePoint( text.at( 0 ).unicode() );
+        return ( index < 0 )? -1: doc->firstChar() + index;
+    }
+
+    bool ok;
+    int  character = text.trimmed().toInt( &ok, 0 );
+    if ( !ok || character < doc->firstChar() || character >= doc->firstChar() + doc->glyphCount() )
+        return -1;
+    return character;
+}
+
+
+QString KerningDialog::describeCharacter( int character ) const
+{
+    uint value = lookup.codePoint( character - doc->firstChar() );
+    if ( value == NO_CODE_POINT || value > 0xFFFF || !QChar( value ).isPrint() || QChar( value ).isSpace() )
+        return QString::number( character );
+    return tr("%1  (%2)").arg( QChar( value )).arg( character );
+}
+
+
+/* The list is kept in pair order, so a pair can be found by bisection.
+ */
+QTreeWidgetItem *KerningDialog::findItem( int first, int second ) const
+{
+    if ( first < 0 || second < 0 )
+        return 0;
+
+    uint key  = pairKey( first, second );
+    int low  = 0;
+    int high = pairTree->topLevelItemCount();
+    while ( low < high ) {
+        int middle = ( low + high ) / 2;
+        uint found = pairTree->topLevelItem( middle )->data( 0, Qt::UserRole ).toUInt();
+        if ( found == key )
+            return pairTree->topLevelItem( middle );
+        if ( found < key )
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return 0;
+}
+
+
+/* Change one pair in the document and the list together; an amount of 0
+ * removes the pair.
+ */
+void KerningDialog::applyPair( int first, int second, int amount )
+{
+    if ( !doc )
+        return;
+
+    bEditing = true;
+    doc->setKerningPair( first, second, amount );
+    bEditing = false;
+
+    QTreeWidgetItem *item = findItem( first, second );
+    if ( amount == 0 ) {
+        delete item;
+    }
+    else {
+        if ( !item ) {
+            uint key  = pairKey( first, second );
+            int low  = 0;
+            int high = pairTree->topLevelItemCount();
+            while ( low < high ) {
+                int middle = ( low + high ) / 2;
+                if ( pairTree->topLevelItem( middle )->data( 0, Qt::UserRole ).toUInt() < key )
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            item = new QTreeWidgetItem();
+            item->setData( 0, Qt::UserRole, key );
+            item->setText( 0, describeCharacter( first ));
+            item->setText( 1, describeCharacter( second ));
+            pairTree->insertTopLevelItem( low, item );
+        }
+        item->setText( 2, QString::number( amount ));
+        pairTree->scrollToItem( item );
+    }
+    updateButtons();
+    emit kerningEdited();
+}
@@ -0,0 +1,87 @@
+/******************************************************************************
+** kerningdialog.h
+**
+** Editing the kerning pairs of a font, with a kerned sample.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef KERNINGDIALOG_H
+#define KERNINGDIALOG_H
+
+#include <QDialog>
+#include <QPointer>
+
+#include "glyphlookup.h"
+
+class QCheckBox;
+class QLineEdit;
+class QPushButton;
+class QSpinBox;
+class QTreeWidget;
+class QTreeWidgetItem;
+class KerningPreview;
+
+
+/* A non-modal dialog listing the document's kerning pairs.  Characters are
+ * entered either as themselves or as a number in the font's code page.
+ * Edits made here update the list in place rather than refilling it, so
+ * that a font with thousands of pairs stays quick to edit; the list is
+ * only rebuilt when the pairs are replaced from elsewhere.
+ */
+class KerningDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    KerningDialog( QWidget *parent = 0 );
+
+    void    setDocument( FontDocument *document );
+
+signals:
+    void kerningEdited();
+
+private slots:
+    void refresh();
+    void selectPair();
+    void setPair();
+    void removePair();
+    void updateButtons();
+
+private:
+    int     parseCharacter( const QString &text );
+    QString describeCharacter( int character ) const;
+    QTreeWidgetItem *findItem( int first, int second ) const;
+    void    applyPair( int first, int second, int amount );
+
+    QPointer<FontDocument> doc;
+    GlyphLookup      lookup;
+    bool             bEditing;
+
+    KerningPreview  *preview;
+    QLineEdit       *sampleEdit;
+    QCheckBox       *kerningCheck;
+    QTreeWidget     *pairTree;
+    QLineEdit       *firstEdit;
+    QLineEdit       *secondEdit;
+    QSpinBox        *amountSpin;
+    QPushButton     *setButton;
+    QPushButton     *removeButton;
+};
+
+#endif  // KERNINGDIALOG_H
@@ -0,0 +1,180 @@
+/******************************************************************************
+** kerningpreview.cpp
+**
+** Sample text drawn in the font being edited, with kerning applied.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "kerningpreview.h"
+
+#define PREVIEW_MARGIN  4
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+KerningPreview::KerningPreview( QWidget *parent ): QWidget( parent ),
+    bKerning( true ), bDirty( true ), iScale( 2 ), iTextWidth( 0 )
+{
+    setBackgroundRole( QPalette::Base );
+    setAutoFillBackground( true );
+    setSizePolicy( QSizePolicy::Expanding, QSizePolicy::Fixed );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+void KerningPreview::setDocument( FontDocument *document )
+{
+    if ( doc )
+        disconnect( doc, 0, this, 0 );
+    doc = document;
+    if ( doc ) {
+        connect( doc, SIGNAL( glyphChanged( int )), this, SLOT( invalidate() ));
+        connect( doc, SIGNAL( metricsChanged() ), this, SLOT( invalidate() ));
+        connect( doc, SIGNAL( kerningChanged() ), this, SLOT( invalidate() ));
+    }
+    updateGeometry();
+    invalidate();
+}
+
+
+void KerningPreview::setText( const QString &text )
+{
+    if ( text == strText )
+        return;
+    strText = text;
+    invalidate();
+}
+
+
+void KerningPreview::setKerningEnabled( bool enable )
+{
+    if ( enable == bKerning )
+        return;
+    bKerning = enable;
+    invalidate();
+}
+
+
+void KerningPreview::setScale( int scale )
+{
+    iScale = qMax( 1, scale );
+    updateGeometry();
+    invalidate();
+}
+
+
+QSize KerningPreview::sizeHint() const
+{
+    int height = doc ? doc->cellHeight() : 16;
+    return QSize( 320, height * iScale + 2 * PREVIEW_MARGIN );
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void KerningPreview::invalidate()
+{
+    bDirty = true;
+    update();
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+/* Work out where each character goes.  The arrays only ever grow, so once
+ * they are as long as the longest text seen no layout allocates at all.
+ */
+void KerningPreview::layoutText()
+{
+    bDirty = false;
+    int length = strText.length();
+    if ( glyphIndices.size() < length ) {
+        glyphIndices.resize( length );
+        positions.resize( length );
+    }
+    iTextWidth = 0;
+    if ( !doc )
+        return;
+
+    if ( !lookup.isBuiltFor( doc ))
+        lookup.build( doc );
+
+    const FontMetricsIndex &metrics = doc->metrics();
+    const KerningTable     &kerning = doc->kerning();
+    bool kern  = bKerning && !kerning.isEmpty();
+    int  gap   = metrics.averageIncrement();
+    int  first = doc->firstChar();
+    int  x     = 0;
+    int  previous = -1;
+
+    for ( int i = 0; i < length; i++ ) {
+        int index = lookup.glyphForCodePoint( strText.at( i ).unicode() );
+        if ( kern && previous >= 0 && index >= 0 )
+            x += kerning.amount( first + previous, first + index );
+        glyphIndices[ i ] = index;
+        positions[ i ]    = x;
+        x += ( index >= 0 ) ? metrics.glyph( index ).increment : gap;
+        previous = index;
+    }
+    iTextWidth = x;
+}
+
+
+void KerningPreview::paintEvent( QPaintEvent *event )
+{
+    Q_UNUSED( event );
+    if ( !doc )
+        return;
+    if ( bDirty )
+        layoutText();
+
+    QPainter painter( this );
+    QRgb     ink    = palette().text().color().rgb();
+    int      height = doc->cellHeight() * iScale;
+    int      top    = ( this->height() - height ) / 2;
+    int      length = strText.length();
+    int      right  = width() - PREVIEW_MARGIN;
+
+    // The baseline helps to judge the spacing of characters that dip below it
+    painter.setPen( palette().mid().color() );
+    int baseLine = top + ( doc->cellHeight() - doc->baseLine() ) * iScale;
+    painter.drawLine( PREVIEW_MARGIN, baseLine, qMin( right, PREVIEW_MARGIN + iTextWidth * iScale ), baseLine );
+
+    for ( int i = 0; i < length; i++ ) {
+        int left = PREVIEW_MARGIN + positions.at( i ) * iScale;
+        if ( left >= right )
+            break;
+        int index = glyphIndices.at( i );
+        if ( index < 0 || doc->metrics().glyph( index ).blank )
+            continue;
+        QImage image = doc->glyph( index ).toImage( ink, qRgba( 0, 0, 0, 0 ));
+        painter.drawImage( QRect( left, top, image.width() * iScale, height ), image );
+    }
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+** kerningpreview.h
+**
+** Sample text drawn in the font being edited, with kerning applied.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef KERNINGPREVIEW_H
+#define KERNINGPREVIEW_H
+
+#include <QPointer>
+#include <QVector>
+#include <QWidget>
+
+#include "glyphlookup.h"
+
+
+/* The text is laid out once, whenever it, the kerning or the metrics
+ * change, into position and glyph arrays which are kept between layouts;
+ * painting then just draws the glyphs at the stored positions.  Widths
+ * come from the metrics index and amounts from the kerning table, so a
+ * layout neither decodes a glyph nor allocates per character.
+ * Characters missing from the font leave an average-width gap.
+ */
+class KerningPreview : public QWidget
+{
+    Q_OBJECT
+
+public:
+    KerningPreview( QWidget *parent = 0 );
+
+    void    setDocument( FontDocument *document );
+    QString text() const { return strText; }
+    void    setText( const QString &text );
+    bool    isKerningEnabled() const { return bKerning; }
+    void    setKerningEnabled( bool enable );
+    int     scale() const { return iScale; }
+    void    setScale( int scale );
+
+    QSize   sizeHint() const;
+
+public slots:
+    void    invalidate();
+
+protected:
+    void    paintEvent( QPaintEvent *event );
+
+private:
+    void    layoutText();
+
+    QPointer<FontDocument> doc;
+    GlyphLookup  lookup;
+    QString      strText;
+    bool         bKerning;
+    bool         bDirty;
+    int          iScale;
+    int          iTextWidth;
+
+    QVector<int> glyphIndices;      // of each character, or -1 if missing
+    QVector<int> positions;         // left edge of each character, in font pixels
+};
+
+#endif  // KERNINGPREVIEW_H
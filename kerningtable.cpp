@@ -0,0 +1,197 @@
+/******************************************************************************
+** kerningtable.cpp
+**
+** Kerning pairs, held in a flat hash table keyed on the character pair.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#include <QtAlgorithms>
+
+#include "kerningtable.h"
+
+// Key of an unused slot; the pair (0xFFFF, 0xFFFF) can't be stored
+#define EMPTY_KEY           0xFFFFFFFFu
+
+// Smallest table allocated, in slots (must be a power of two)
+#define MIN_SLOTS           64
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static inline quint32 pairKey( quint16 first, quint16 second )
+{
+    return ((quint32) first << 16 ) | second;
+}
+
+
+/* Fibonacci hashing, so that runs of similar pairs (the usual case) are
+ * spread across the table rather than filling neighbouring slots.
+ */
+static inline int slotFor( quint32 key, int mask )
+{
+    return (int)(( key * 0x9E3779B1u ) >> 8 ) & mask;
+}
+
+
+static bool pairLessThan( const KerningPair &a, const KerningPair &b )
+{
+    return pairKey( a.first, a.second ) < pairKey( b.first, b.second );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+KerningTable::KerningTable()
+{
+    iCount = 0;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+int KerningTable::amount( quint16 first, quint16 second ) const
+{
+    if ( !iCount )
+        return 0;
+    int slot = findSlot( pairKey( first, second ));
+    return ( keys.at( slot ) == EMPTY_KEY )? 0: amounts.at( slot );
+}
+
+
+/* Add, change or (with an amount of 0) remove a pair.
+ */
+void KerningTable::setAmount( quint16 first, quint16 second, int amount )
+{
+    quint32 key = pairKey( first, second );
+    if ( key == EMPTY_KEY )
+        return;
+    amount = qBound( -32768, amount, 32767 );
+
+    if ( amount == 0 ) {
+        if ( !iCount )
+            return;
+        int slot = findSlot( key );
+        if ( keys.at( slot ) == EMPTY_KEY )
+            return;
+
+        // Move back any later entry of the run which could then be missed
+        int mask = keys.size() - 1;
+        int hole = slot;
+        for ( int next = ( hole + 1 ) & mask; keys.at( next ) != EMPTY_KEY; next = ( next + 1 ) & mask ) {
+            int home = slotFor( keys.at( next ), mask );
+            if ((( next - home ) & mask ) >= (( next - hole ) & mask )) {
+                keys[ hole ]    = keys.at( next );
+                amounts[ hole ] = amounts.at( next );
+                hole = next;
+            }
+        }
+        keys[ hole ] = EMPTY_KEY;
+        iCount--;
+        return;
+    }
+
+    // Keep the table no more than 70% full
+    if (( iCount + 1 ) * 10 > keys.size() * 7 )
+        grow();
+    int slot = findSlot( key );
+    if ( keys.at( slot ) == EMPTY_KEY ) {
+        keys[ slot ] = key;
+        iCount++;
+    }
+    amounts[ slot ] = amount;
+}
+
+
+void KerningTable::clear()
+{
+    keys.clear();
+    amounts.clear();
+    iCount = 0;
+}
+
+
+/* All the pairs, in order of first and then second character, as they are
+ * stored in a font file.
+ */
+QVector<KerningPair> KerningTable::sorted() const
+{
+    QVector<KerningPair> pairs;
+    pairs.reserve( iCount );
+    for ( int i = 0; i < keys.size(); i++ ) {
+        if ( keys.at( i ) == EMPTY_KEY )
+            continue;
+        KerningPair pair;
+        pair.first  = keys.at( i ) >> 16;
+        pair.second = keys.at( i ) & 0xFFFF;
+        pair.amount = amounts.at( i );
+        pairs.append( pair );
+    }
+    qSort( pairs.begin(), pairs.end(), pairLessThan );
+    return pairs;
+}
+
+
+void KerningTable::assign( const QVector<KerningPair> &pairs )
+{
+    clear();
+    for ( int i = 0; i < pairs.size(); i++ )
+        setAmount( pairs.at( i ).first, pairs.at( i ).second, pairs.at( i ).amount );
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+/* The slot holding the key, or else the empty slot where it would go.  The
+ * table always has at least one empty slot, so this terminates.
+ */
+int KerningTable::findSlot( quint32 key ) const
+{
+    int mask = keys.size() - 1;
+    int slot = slotFor( key, mask );
+    while ( keys.at( slot ) != key && keys.at( slot ) != EMPTY_KEY )
+        slot = ( slot + 1 ) & mask;
+    return slot;
+}
+
+
+void KerningTable::grow()
+{
+    QVector<quint32> oldKeys    = keys;
+    QVector<qint16>  oldAmounts = amounts;
+
+    int size = qMax( MIN_SLOTS, keys.size() * 2 );
+    keys.fill( EMPTY_KEY, size );
+    amounts.fill( 0, size );
+    for ( int i = 0; i < oldKeys.size(); i++ ) {
+        if ( oldKeys.at( i ) == EMPTY_KEY )
+            continue;
+        int slot = findSlot( oldKeys.at( i ));
+        keys[ slot ]    = oldKeys.at( i );
+        amounts[ slot ] = oldAmounts.at( i );
+    }
+}
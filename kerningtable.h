@@ -0,0 +1,75 @@
+/******************************************************************************
+** kerningtable.h
+**
+** Kerning pairs, held in a flat hash table keyed on the character pair.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#ifndef KERNINGTABLE_H
+#define KERNINGTABLE_H
+
+#include <QVector>
+
+
+/* One kerning pair: the adjustment, in pixels, to the space between the
+ * two characters (negative to move them closer).  The characters are code
+ * points in the font's code page, i.e. firstChar plus the glyph index, as
+ * in the OS/2 font format.
+ */
+struct KerningPair
+{
+    quint16 first;
+    quint16 second;
+    qint16  amount;
+};
+
+
+/* The pairs are kept in a single open-addressed table, each slot holding
+ * the two characters packed into one 32-bit key with its amount alongside.
+ * Lookups probe linearly from the key's hash and never allocate, so the
+ * preview can kern every character pair it draws.  Removal shifts the
+ * following entries back rather than leaving tombstones, so the table
+ * never needs cleaning up however many times pairs are edited.
+ */
+class KerningTable
+{
+public:
+    KerningTable();
+
+    int     count() const { return iCount; }
+    bool    isEmpty() const { return iCount == 0; }
+
+    int     amount( quint16 first, quint16 second ) const;
+    void    setAmount( quint16 first, quint16 second, int amount );
+    void    clear();
+
+    QVector<KerningPair> sorted() const;
+    void    assign( const QVector<KerningPair> &pairs );
+
+private:
+    int     findSlot( quint32 key ) const;
+    void    grow();
+
+    QVector<quint32> keys;      // empty slots hold EMPTY_KEY
+    QVector<qint16>  amounts;
+    int              iCount;
+};
+
+#endif  // KERNINGTABLE_H
@@ -1,14 +1,110 @@
-#include <QApplication>
-
-#include "mainwindow.h"
-
-int main( int argc, char *argv[] )
-{
-    int rc;
-    QApplication app( argc, argv );
-    FontEditor *qfe = new FontEditor;
-    qfe->show();
-    rc = app.exec();
-    delete qfe;
-    return rc;
-}
+#include <QApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include "codepagecoverage.h"
+#include "codepageremap.h"
+#include "fontloader.h"
+#include "mainwindow.h"
+
+/* Load a whole font for one of the batch modes, reporting any error.  With
+ * no event loop the loader's signals go nowhere; it is just left to finish.
+ */
+static FontDocument *loadDocument( const QString &fileName )
+{
+    FontLoader loader( fileName, -1 );
+    loader.start();
+    loader.wait();
+    FontDocument *document = loader.createDocument();
+    if ( !document ) {
+        QTextStream err( stderr );
+        err << QCoreApplication::translate("FontEditor", "Unable to open %1: %2")
+                   .arg( fileName ).arg( loader.errorString() ) << endl;
+        return 0;
+    }
+    document->setGlyphBatch( loader.takeGlyphs() );
+    return document;
+}
+
+
+/* Batch mode: write the code page coverage of a font file to standard
+ * output, with the characters missing from each code page.
+ */
+static int reportCoverage( const QString &fileName )
+{
+    FontDocument *document = loadDocument( fileName );
+    if ( !document )
+        return 1;
+
+    QTextStream out( stdout );
+    CodePageCoverage coverage;
+    coverage.setDoubleByte( true );
+    coverage.setDocument( document );
+    out << fileName << ": " << document->familyName() << " " << document->faceName()
+        << ", code page " << document->codePage() << endl;
+    out << coverage.report( true );
+    delete document;
+    return 0;
+}
+
+
+/* Batch mode: write a variant of the master font for each code page in a
+ * comma-separated list, named after the master file.
+ */
+static int writeVariants( const QString &codePages, const QString &fileName, const QString &directory )
+{
+    QList<quint16> pages;
+    QStringList items = codePages.split(',', QString::SkipEmptyParts );
+    for ( int i = 0; i < items.size(); i++ )
+        pages.append( items.at( i ).trimmed().toUShort() );
+
+    FontDocument *document = loadDocument( fileName );
+    if ( !document )
+        return 1;
+
+    QTextStream out( stdout );
+    int rc = 0;
+    QList<CodePageRemap::Variant> variants = CodePageRemap::generate( document, pages, directory,
+                                                                      QFileInfo( fileName ).completeBaseName() );
+    for ( int i = 0; i < variants.size(); i++ ) {
+        const CodePageRemap::Variant &variant = variants.at( i );
+        out << QDir::toNativeSeparators( variant.fileName ) << ": ";
+        if ( !variant.error.isEmpty() ) {
+            out << variant.error << endl;
+            rc = 1;
+        }
+        else
+            out << QCoreApplication::translate("FontEditor", "%n character(s) missing", "",
+                                               QCoreApplication::CodecForTr, variant.missing ) << endl;
+    }
+    delete document;
+    return rc;
+}
+
+
+int main( int argc, char *argv[] )
+{
+    int rc;
+    if ( argc > 2 && qstrcmp( argv[ 1 ], "-coverage") == 0 ) {
+        QApplication app( argc, argv, false );
+        rc = 0;
+        for ( int i = 2; i < argc; i++ )
+            rc |= reportCoverage( QString::fromLocal8Bit( argv[ i ] ));
+        return rc;
+    }
+    if ( argc == 5 && qstrcmp( argv[ 1 ], "-variants") == 0 ) {
+        QApplication app( argc, argv, false );
+        return writeVariants( QString::fromLocal8Bit( argv[ 2 ] ), QString::fromLocal8Bit( argv[ 3 ] ),
+                              QString::fromLocal8Bit( argv[ 4 ] ));
+    }
+
+    QApplication app( argc, argv );
+    FontEditor *qfe = new FontEditor;
+    qfe->show();
+    if ( argc > 1 )
+        qfe->loadFile( QString::fromLocal8Bit( argv[ 1 ] ), true );
+    rc = app.exec();
+    delete qfe;
+    return rc;
+}
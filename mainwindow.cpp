@@ -22,6 +22,31 @@
 #include <QtGui>
 
 #include "os2native.h"
+#include "atlasdialog.h"
+#include "changescheduler.h"
+#include "codepageremap.h"
+#include "coveragedialog.h"
+#include "familyview.h"
+#include "fitdialog.h"
+#include "glyphclipboard.h"
+#include "glyphcommand.h"
+#include "glyphfinder.h"
+#include "glyphscaler.h"
+#include "glyphstore.h"
+#include "glyphstyler.h"
+#include "headerdialog.h"
+#include "kerningdialog.h"
+#include "glyphsimilarity.h"
+#include "fontloader.h"
+#include "fontmodule.h"
+#include "fontrasterizer.h"
+#include "glyphoverview.h"
+#include "os2fontfile.h"
+#include "outlinedialog.h"
+#include "similardialog.h"
+#include "styledialog.h"
+#include "variantsdialog.h"
+#include "winfontfile.h"
 #include "mainwindow.h"
 
 
@@ -47,19 +72,51 @@ FontEditor::FontEditor()
     vLayout->setContentsMargins( 1, 1, 1, 1 );
     vLayout->setSpacing( 3 );
 
+    QVBoxLayout *leftLayout = new QVBoxLayout();
+
+    leftPanel = new QFrame();
+    leftPanel->setLayout( leftLayout );
+
+    finder = new GlyphFinder();
+    leftLayout->addWidget( finder );
+
+    overview = new GlyphOverview();
+    leftLayout->addWidget( overview );
+
+    leftLayout->setStretchFactor( overview, 1 );
+    leftLayout->setContentsMargins( 1, 1, 1, 1 );
+    leftLayout->setSpacing( 3 );
+
     splitter = new QSplitter( Qt::Horizontal );
+    splitter->addWidget( leftPanel );
     splitter->addWidget( rightPanel );
+    splitter->setStretchFactor( 1, 1 );
 
     setCentralWidget( splitter );
 
+    recentFiles = new RecentFiles( MaxRecentFiles, this );
+    connect( recentFiles, SIGNAL( changed() ), this, SLOT( updateRecentFileActions() ));
+
+    undoStack = new QUndoStack( this );
+    iUndoIndex = 0;
+    connect( undoStack, SIGNAL( indexChanged( int )), this, SLOT( refreshGlyph( int )));
+
+    scheduler = new ChangeScheduler( this );
+    connect( scheduler, SIGNAL( dispatch( int )), this, SLOT( dispatchChanges( int )));
+
     createActions();
     createMenus();
     createStatusBar();
 
 //    setAcceptDrops( true );
     connect( editor, SIGNAL( positionChanged( const QPoint & )),
-             this, SLOT( updatePosition( const QPoint & )));
-//    connect( editor, SIGNAL( contentsChanged() ), this, SLOT( updateModified() ));
+             scheduler, SLOT( postPosition( const QPoint & )));
+    connect( editor, SIGNAL( editFinished( const QString &, const GlyphBitmap & )),
+             this, SLOT( recordEdit( const QString &, const GlyphBitmap & )));
+    connect( editor, SIGNAL( contentsChanged() ), this, SLOT( updateGlyph() ));
+    connect( overview, SIGNAL( glyphSelected( int )), this, SLOT( showGlyph( int )));
+    connect( finder, SIGNAL( glyphSelected( int )), this, SLOT( showGlyph( int )));
+    connect( overview, SIGNAL( visibleRangeChanged( int, int )), this, SLOT( updateLoadPriority() ));
 
 //    setMinimumWidth( statusBar()->minimumWidth() + 20 );
     setWindowTitle( tr("Font Editor") );
@@ -80,7 +137,29 @@ FontEditor::FontEditor()
     helpInstance = NULL;
     createHelp();
 
+    document = NULL;
+    currentGlyph = 0;
+    bStoringGlyph = false;
+    loader = NULL;
+    rasterizer = NULL;
+    rasterWatcher = NULL;
+    rasterProgress = NULL;
+    similarIndex = NULL;
+    similarDialog = NULL;
+    coverageDialog = NULL;
+    kerningDialog = NULL;
+    familyView = NULL;
+
+    // Loading or editing can change many glyphs in a row; recount once they stop
+    coverageTimer = new QTimer( this );
+    coverageTimer->setSingleShot( true );
+    coverageTimer->setInterval( 100 );
+    connect( coverageTimer, SIGNAL( timeout() ), this, SLOT( updateCoverage() ));
+
+    setDocument( new FontDocument( 256, 32, 32, 8, this ));
+
     currentDir = QDir::currentPath();
+    readSettings();
     setCurrentFile("");
 }
 
@@ -91,6 +170,7 @@ FontEditor::FontEditor()
 //
 FontEditor::~FontEditor()
 {
+    delete rasterizer;
 #ifdef __OS2__
     if ( helpInstance ) OS2Native::destroyNativeHelp( helpInstance );
 #endif
@@ -119,11 +199,97 @@ void FontEditor::closeEvent( QCloseEvent *event )
 
 void FontEditor::newFile()
 {
+    if ( okToContinue() ) {
+        stopLoading();
+        setDocument( new FontDocument( 256, 32, 32, 8, this ));
+        setCurrentFile("");
+    }
+}
+
+
+void FontEditor::newFromOutline()
+{
+    if ( rasterizer || !okToContinue() )
+        return;
+
+    OutlineFontDialog dialog( currentDir, this );
+    if ( dialog.exec() != QDialog::Accepted )
+        return;
+
+    FontRasterizer *outline = new FontRasterizer;
+    if ( !outline->open( dialog.fileName() ) ||
+         !outline->start( dialog.firstChar(), dialog.lastChar(), dialog.pixelSize() ))
+    {
+        QMessageBox::warning( this, tr("New from Outline Font"),
+                              tr("The font could not be rendered.\n%1").arg( outline->errorString() ));
+        delete outline;
+        return;
+    }
+
+    // Large ranges can take a minute or more, so they render in the background
+    rasterizer = outline;
+    rasterProgress = new QProgressDialog( tr("Rendering glyphs..."), tr("Cancel"), 0, 0, this );
+    rasterProgress->setWindowTitle( tr("New from Outline Font") );
+    rasterProgress->setWindowModality( Qt::WindowModal );
+    rasterWatcher = new QFutureWatcher<void>( this );
+    connect( rasterWatcher, SIGNAL( progressRangeChanged( int, int )), rasterProgress, SLOT( setRange( int, int )));
+    connect( rasterWatcher, SIGNAL( progressValueChanged( int )), rasterProgress, SLOT( setValue( int )));
+    connect( rasterWatcher, SIGNAL( finished() ), this, SLOT( outlineRendered() ));
+    connect( rasterProgress, SIGNAL( canceled() ), rasterWatcher, SLOT( cancel() ));
+    rasterWatcher->setFuture( rasterizer->future() );
+    rasterProgress->show();
+}
+
+
+/* Install the font rendered by newFromOutline(), unless it was cancelled.
+ */
+void FontEditor::outlineRendered()
+{
+    if ( !rasterizer )
+        return;
+
+    FontDocument *outline = rasterizer->takeDocument( this );
+    QString error = rasterizer->errorString();
+    bool cancelled = rasterWatcher->isCanceled();
+    delete rasterizer;
+    rasterizer = NULL;
+    rasterWatcher->deleteLater();
+    rasterWatcher = NULL;
+    rasterProgress->deleteLater();
+    rasterProgress = NULL;
+
+    if ( !outline ) {
+        if ( !cancelled )
+            QMessageBox::warning( this, tr("New from Outline Font"),
+                                  tr("The font could not be rendered.\n%1").arg( error ));
+        return;
+    }
+
+    stopLoading();
+    setDocument( outline );
+    setCurrentFile("");
+    updateModified( true );
 }
 
 
 void FontEditor::open()
 {
+    if ( !okToContinue() )
+        return;
+
+#ifndef __OS2__
+    QString fileName = QFileDialog::getOpenFileName( this,
+                                                     tr("Open File"),
+                                                     currentDir,
+                                                     tr("Font files (*.fnt *.fon *.dll);;OS/2 bitmap fonts (*.fnt);;Font modules (*.dll *.fon);;All files (*)"));
+#else
+    QString fileName = OS2Native::getOpenFileName( this,
+                                                   tr("Open File"),
+                                                   currentDir,
+                                                   tr("Font files (*.fnt *.fon *.dll);;OS/2 bitmap fonts (*.fnt);;Font modules (*.dll *.fon);;All files (*)"));
+#endif
+    if ( !fileName.isEmpty() )
+        loadFile( fileName, false );
 }
 
 
@@ -133,6 +299,78 @@ void FontEditor::clearGlyph()
 }
 
 
+void FontEditor::cutGlyph()
+{
+    GlyphClipboard::setBitmaps( QList<GlyphBitmap>() << editor->copySelection() );
+    editor->cutSelection();
+}
+
+
+void FontEditor::copyGlyph()
+{
+    GlyphClipboard::setBitmaps( QList<GlyphBitmap>() << editor->copySelection() );
+}
+
+
+void FontEditor::pasteGlyph()
+{
+    QList<GlyphBitmap> blocks = GlyphClipboard::bitmaps();
+    if ( blocks.isEmpty() )
+        return;
+    editor->pasteBlock( blocks.first(), false );
+}
+
+
+void FontEditor::pasteGlyphMask()
+{
+    QList<GlyphBitmap> blocks = GlyphClipboard::bitmaps();
+    if ( blocks.isEmpty() )
+        return;
+    editor->pasteBlock( blocks.first(), true );
+}
+
+
+void FontEditor::copyGlyphRange()
+{
+    bool ok;
+    int count = QInputDialog::getInt( this, tr("Copy Glyphs"),
+                                      tr("Number of glyphs to copy, starting with the current glyph:"),
+                                      1, 1, document->glyphCount() - currentGlyph, 1, &ok );
+    if ( !ok )
+        return;
+
+    QList<GlyphBitmap> blocks;
+    for ( int i = 0; i < count; i++ )
+        blocks << document->glyph( currentGlyph + i );
+    GlyphClipboard::setBitmaps( blocks );
+    showMessage( tr("%n glyph(s) copied", "", count ));
+}
+
+
+void FontEditor::pasteGlyphRange()
+{
+    pasteRange( false );
+}
+
+
+void FontEditor::pasteGlyphRangeMask()
+{
+    pasteRange( true );
+}
+
+
+void FontEditor::nextGlyph()
+{
+    showGlyph( currentGlyph + 1 );
+}
+
+
+void FontEditor::previousGlyph()
+{
+    showGlyph( currentGlyph - 1 );
+}
+
+
 void FontEditor::flipGlyphX()
 {
     editor->mirror( Qt::Horizontal );
@@ -171,7 +409,7 @@ void FontEditor::shiftRight()
 
 void FontEditor::shiftUp()
 {
-    editor->insertRowUp( editor->glyphImage().height()-1 );
+    editor->insertRowUp( editor->glyphBitmap().height()-1 );
 }
 
 
@@ -206,6 +444,303 @@ void FontEditor::widenBoth()
 }
 
 
+void FontEditor::goToGlyph()
+{
+    finder->setFocus();
+    finder->selectAll();
+}
+
+
+void FontEditor::findSimilarGlyphs()
+{
+    if ( !similarDialog ) {
+        similarDialog = new SimilarGlyphsDialog( this );
+        connect( similarDialog, SIGNAL( searchRequested() ), this, SLOT( searchSimilarGlyphs() ));
+        connect( similarDialog, SIGNAL( glyphActivated( int )), this, SLOT( showGlyph( int )));
+    }
+    similarDialog->show();
+    similarDialog->raise();
+    similarDialog->activateWindow();
+    searchSimilarGlyphs();
+}
+
+
+void FontEditor::searchSimilarGlyphs()
+{
+    QApplication::setOverrideCursor( Qt::WaitCursor );
+    QList<GlyphSimilarityIndex::Match> matches = similarIndex->nearest( document->glyph( currentGlyph ),
+                                                                        similarDialog->maxResults(),
+                                                                        similarDialog->maxDistance(),
+                                                                        currentGlyph );
+    QApplication::restoreOverrideCursor();
+    similarDialog->setResults( document, currentGlyph, matches );
+}
+
+
+void FontEditor::scaleFont()
+{
+    static const struct {
+        const char          *name;
+        GlyphScaler::Method  method;
+        int                  factor;
+    } choices[] = {
+        { QT_TRANSLATE_NOOP("FontEditor", "Scale2x (2x, smoothed edges)"),   GlyphScaler::Scale2x, 2 },
+        { QT_TRANSLATE_NOOP("FontEditor", "Scale3x (3x, smoothed edges)"),   GlyphScaler::Scale3x, 3 },
+        { QT_TRANSLATE_NOOP("FontEditor", "Scale2x twice (4x, smoothed edges)"), GlyphScaler::Scale2x, 4 },
+        { QT_TRANSLATE_NOOP("FontEditor", "Pixel replication 2x"),           GlyphScaler::Nearest, 2 },
+        { QT_TRANSLATE_NOOP("FontEditor", "Pixel replication 3x"),           GlyphScaler::Nearest, 3 },
+        { QT_TRANSLATE_NOOP("FontEditor", "Pixel replication 4x"),           GlyphScaler::Nearest, 4 }
+    };
+    const int count = sizeof( choices ) / sizeof( choices[ 0 ] );
+
+    QStringList items;
+    for ( int i = 0; i < count; i++ )
+        items << tr( choices[ i ].name );
+
+    bool ok;
+    QString item = QInputDialog::getItem( this, tr("Derive Scaled Font"),
+                                          tr("Create a new font by scaling every glyph using:"),
+                                          items, 0, false, &ok );
+    int choice = items.indexOf( item );
+    if ( !ok || choice < 0 )
+        return;
+
+    QApplication::setOverrideCursor( Qt::WaitCursor );
+    FontDocument *scaled = GlyphScaler::scaleFont( document,
+                                                   choices[ choice ].method,
+                                                   choices[ choice ].factor );
+    QApplication::restoreOverrideCursor();
+
+    openWindow( scaled );
+}
+
+
+void FontEditor::deriveStyle()
+{
+    StyleDialog dialog( this );
+    if ( dialog.exec() != QDialog::Accepted )
+        return;
+
+    QApplication::setOverrideCursor( Qt::WaitCursor );
+    FontDocument *styled = GlyphStyler::styleFont( document, dialog.options() );
+    QApplication::restoreOverrideCursor();
+
+    openWindow( styled );
+}
+
+
+/* Crop every glyph to its ink, as a single undo step.
+ */
+void FontEditor::fitWidths()
+{
+    FitDialog dialog( this );
+    if ( dialog.exec() != QDialog::Accepted )
+        return;
+
+    QApplication::setOverrideCursor( Qt::WaitCursor );
+    QList< QPair<int, GlyphBitmap> > changed = GlyphFitter::fitFont( document, dialog.options() );
+    if ( !changed.isEmpty() )
+        undoStack->push( new GlyphBatchCommand( document, changed, tr("Fit widths to ink") ));
+    QApplication::restoreOverrideCursor();
+    showMessage( tr("%n glyph(s) changed", "", changed.size() ));
+}
+
+
+void FontEditor::showCoverage()
+{
+    if ( !coverageDialog ) {
+        coverageDialog = new CoverageDialog( this );
+        connect( coverageDialog, SIGNAL( glyphActivated( int )), this, SLOT( showGlyph( int )));
+    }
+    // The double-byte code pages are only worked out once they are wanted
+    QApplication::setOverrideCursor( Qt::WaitCursor );
+    coverage.setDoubleByte( true );
+    QApplication::restoreOverrideCursor();
+    coverageDialog->setCoverage( &coverage );
+    coverageDialog->show();
+    coverageDialog->raise();
+    coverageDialog->activateWindow();
+}
+
+
+/* Write a font for each chosen code page, taking the glyphs from this one.
+ */
+void FontEditor::generateVariants()
+{
+    QString baseName = currentFile.isEmpty()? document->familyName(): QFileInfo( currentFile ).completeBaseName();
+    baseName.remove(' ');
+
+    VariantsDialog dialog( &coverage, currentDir, baseName, this );
+    if ( dialog.exec() != QDialog::Accepted )
+        return;
+
+    QApplication::setOverrideCursor( Qt::WaitCursor );
+    QList<CodePageRemap::Variant> variants = CodePageRemap::generate( document, dialog.codePages(),
+                                                                      dialog.directory(), dialog.baseName() );
+    QApplication::restoreOverrideCursor();
+
+    QStringList errors;
+    int written = 0;
+    for ( int i = 0; i < variants.size(); i++ ) {
+        if ( variants.at( i ).error.isEmpty() )
+            written++;
+        else
+            errors << tr("%1: %2").arg( QDir::toNativeSeparators( variants.at( i ).fileName ))
+                                  .arg( variants.at( i ).error );
+    }
+    if ( !errors.isEmpty() )
+        QMessageBox::critical( this, tr("Error"), tr("Some variants could not be written:\n\n%1").arg( errors.join("\n")));
+    showMessage( tr("Wrote %n code page variant(s) to %1", "", written ).arg( QDir::toNativeSeparators( dialog.directory() )));
+}
+
+
+/* Only the one glyph's character is updated here; the code pages are
+ * recounted by updateCoverage() once the changes stop coming.
+ */
+void FontEditor::updateGlyphCoverage( int index )
+{
+    coverage.updateGlyph( document, index );
+    if ( !coverageTimer->isActive() )
+        coverageTimer->start();
+}
+
+
+/* Show the code pages which the font fully covers in the status bar.
+ */
+void FontEditor::updateCoverage()
+{
+    QList<CodePageCoverage::Result> results = coverage.results();
+    QStringList complete;
+    QStringList partial;
+    for ( int i = 0; i < results.size(); i++ ) {
+        const CodePageCoverage::Result &result = results.at( i );
+        if ( result.covered == result.total )
+            complete << QString::number( result.codePage );
+        else if ( result.covered > 0 )
+            partial << tr("%1 (%2 missing)").arg( result.codePage ).arg( result.total - result.covered );
+    }
+    coverageLabel->setText( complete.isEmpty()? tr("No complete code pages"):
+                                                tr("Code pages: %1").arg( complete.join(" ")));
+    coverageLabel->setToolTip( partial.isEmpty()? QString():
+                                                  tr("Partly covered: %1").arg( partial.join(", ")));
+
+    if ( coverageDialog && coverageDialog->isVisible() )
+        coverageDialog->setCoverage( &coverage );
+}
+
+
+void FontEditor::showKerning()
+{
+    if ( !kerningDialog ) {
+        kerningDialog = new KerningDialog( this );
+        connect( kerningDialog, SIGNAL( kerningEdited() ), this, SLOT( updateKerning() ));
+        kerningDialog->setDocument( document );
+    }
+    kerningDialog->show();
+    kerningDialog->raise();
+    kerningDialog->activateWindow();
+}
+
+
+void FontEditor::updateKerning()
+{
+    updateModified( true );
+}
+
+
+void FontEditor::showFamily()
+{
+    if ( !familyView ) {
+        familyView = new FamilyView( this );
+        connect( familyView, SIGNAL( characterSelected( int )), this, SLOT( showCharacter( int )));
+        connect( familyView, SIGNAL( glyphEdited( FontDocument *, int, const GlyphBitmap & )),
+                 this, SLOT( updateFamilyGlyph( FontDocument *, int, const GlyphBitmap & )));
+        connect( familyView, SIGNAL( rescanRequested() ), this, SLOT( rescanFamily() ));
+    }
+    rescanFamily();
+    familyView->show();
+    familyView->raise();
+    familyView->activateWindow();
+}
+
+
+/* The family is every open font with the same name and code page as this
+ * one, whichever window it is in.
+ */
+void FontEditor::rescanFamily()
+{
+    QList<FontDocument *> sizes;
+    foreach ( QWidget *widget, QApplication::topLevelWidgets() ) {
+        FontEditor *window = qobject_cast<FontEditor *>( widget );
+        if ( window && window->isVisible() && window->document &&
+             FontFamily::isSameFamily( window->document, document ))
+            sizes.append( window->document );
+    }
+    if ( !sizes.contains( document ))
+        sizes.append( document );
+    familyView->setSizes( sizes );
+    familyView->setCharacterRange( document->firstChar(), document->firstChar() + document->glyphCount() - 1 );
+    familyView->setCharacter( document->firstChar() + currentGlyph );
+}
+
+
+void FontEditor::showCharacter( int character )
+{
+    showGlyph( character - document->firstChar() );
+}
+
+
+/* A glyph has been drawn on in the family view; store it as an undo step
+ * of whichever window owns the document, which then refreshes its editor
+ * and modified state as it does for its own undo steps.
+ */
+void FontEditor::updateFamilyGlyph( FontDocument *edited, int index, const GlyphBitmap &glyph )
+{
+    FontEditor *window = qobject_cast<FontEditor *>( edited->parent() );
+    if ( window )
+        window->undoStack->push( new GlyphBatchCommand( edited, index, edited->glyph( index ), glyph,
+                                                        tr("Draw in family view") ));
+    else
+        edited->setGlyph( index, glyph );
+}
+
+
+void FontEditor::duplicateFont()
+{
+    openWindow( document->duplicate() );
+}
+
+
+/* List all open font windows, so the user can switch between them.
+ */
+void FontEditor::updateWindowMenu()
+{
+    windowMenu->clear();
+    windowMenu->addAction( duplicateAction );
+    windowMenu->addSeparator();
+
+    int number = 0;
+    foreach ( QWidget *widget, QApplication::topLevelWidgets() ) {
+        FontEditor *window = qobject_cast<FontEditor *>( widget );
+        if ( !window || !window->isVisible() )
+            continue;
+        QString title = window->windowTitle().replace("[*]", window->isWindowModified()? "*": "");
+        QAction *action = windowMenu->addAction( tr("&%1 %2").arg( ++number ).arg( title.trimmed() ));
+        action->setCheckable( true );
+        action->setChecked( window == this );
+        connect( action, SIGNAL( triggered() ), window, SLOT( raiseWindow() ));
+    }
+}
+
+
+void FontEditor::raiseWindow()
+{
+    showNormal();
+    raise();
+    activateWindow();
+}
+
+
 void FontEditor::about()
 {
     QMessageBox::about( this,
@@ -243,14 +778,12 @@ void FontEditor::showKeysHelp()
 
 void FontEditor::openRecentFile()
 {
-/*
     if ( okToContinue() ) {
         QAction *action = qobject_cast<QAction *>( sender() );
         if ( action ) {
             loadFile( action->data().toString(), false );
         }
     }
-*/
 }
 
 
@@ -261,10 +794,8 @@ void FontEditor::clearRecentFiles()
                                    tr("Clear the list of recent files?"),
                                    QMessageBox::Yes | QMessageBox::No
                                  );
-    if ( r == QMessageBox::Yes ) {
-        recentFiles.clear();
-        updateRecentFileActions();
-    }
+    if ( r == QMessageBox::Yes )
+        recentFiles->clear();
 }
 
 
@@ -281,6 +812,10 @@ void FontEditor::createActions()
     newAction->setStatusTip( tr("Create a new file") );
     connect( newAction, SIGNAL( triggered() ), this, SLOT( newFile() ));
 
+    newOutlineAction = new QAction( tr("New from o&utline font..."), this );
+    newOutlineAction->setStatusTip( tr("Create a new font by rendering an outline (TrueType, OpenType or Type 1) font") );
+    connect( newOutlineAction, SIGNAL( triggered() ), this, SLOT( newFromOutline() ));
+
     openAction = new QAction( tr("&Open..."), this );
     openAction->setShortcut( QKeySequence::Open );
     openAction->setStatusTip( tr("Open a file") );
@@ -300,6 +835,18 @@ void FontEditor::createActions()
     saveAsAction->setStatusTip( tr("Save the current file under a new name") );
     connect( saveAsAction, SIGNAL( triggered() ), this, SLOT( saveAs() ));
 
+    exportWindowsAction = new QAction( tr("&Export as Windows font..."), this );
+    exportWindowsAction->setStatusTip( tr("Save a copy of the current font as a Windows font file") );
+    connect( exportWindowsAction, SIGNAL( triggered() ), this, SLOT( exportWindowsFont() ));
+
+    exportAtlasAction = new QAction( tr("Export glyph a&tlas..."), this );
+    exportAtlasAction->setStatusTip( tr("Save the glyphs packed into one image, with an index of their metrics") );
+    connect( exportAtlasAction, SIGNAL( triggered() ), this, SLOT( exportAtlas() ));
+
+    exportHeaderAction = new QAction( tr("Export C &header..."), this );
+    exportHeaderAction->setStatusTip( tr("Save the font as tables in a C/C++ header file") );
+    connect( exportHeaderAction, SIGNAL( triggered() ), this, SLOT( exportHeader() ));
+
     for ( int i = 0; i < MaxRecentFiles; i++ )
     {
         recentFileActions[ i ] = new QAction( this );
@@ -321,24 +868,90 @@ void FontEditor::createActions()
     // Edit menu actions
 
     undoAction = new QAction( tr("&Undo"), this );
+    undoAction->setShortcut( QKeySequence::Undo );
+    undoAction->setStatusTip( tr("Undo the last change") );
+    undoAction->setEnabled( false );
+    connect( undoAction, SIGNAL( triggered() ), undoStack, SLOT( undo() ));
+    connect( undoStack, SIGNAL( canUndoChanged( bool )), undoAction, SLOT( setEnabled( bool )));
+
     redoAction = new QAction( tr("&Redo"), this );
+    redoAction->setShortcut( QKeySequence::Redo );
+    redoAction->setStatusTip( tr("Redo the last change undone") );
+    redoAction->setEnabled( false );
+    connect( redoAction, SIGNAL( triggered() ), undoStack, SLOT( redo() ));
+    connect( undoStack, SIGNAL( canRedoChanged( bool )), redoAction, SLOT( setEnabled( bool )));
+
     revertAction = new QAction( tr("Re&vert"), this );
 
     selectAction = new QAction( tr("&Select..."), this );
-    selectAction->setStatusTip( tr("Activate selection mode") );
+    selectAction->setStatusTip( tr("Activate selection mode (Ctrl adds to the selection, Shift removes from it)") );
     selectAction->setCheckable( true );
     connect( selectAction, SIGNAL( triggered() ), this, SLOT( setSelect() ));
 
+    // Drawing tools, one of which is always chosen
+    static const struct {
+        const char       *name;
+        const char       *tip;
+        GlyphEditor::Tool tool;
+    } tools[] = {
+        { QT_TRANSLATE_NOOP("FontEditor", "&Pen"),              QT_TRANSLATE_NOOP("FontEditor", "Set (left button) or clear (right button) pixels by dragging"), GlyphEditor::PenTool },
+        { QT_TRANSLATE_NOOP("FontEditor", "&Fill"),             QT_TRANSLATE_NOOP("FontEditor", "Set or clear the whole area around the clicked pixel"),         GlyphEditor::FillTool },
+        { QT_TRANSLATE_NOOP("FontEditor", "&Line"),             QT_TRANSLATE_NOOP("FontEditor", "Drag out a straight line"),                                     GlyphEditor::LineTool },
+        { QT_TRANSLATE_NOOP("FontEditor", "&Rectangle"),        QT_TRANSLATE_NOOP("FontEditor", "Drag out the outline of a rectangle"),                          GlyphEditor::RectangleTool },
+        { QT_TRANSLATE_NOOP("FontEditor", "Fille&d rectangle"), QT_TRANSLATE_NOOP("FontEditor", "Drag out a solid rectangle"),                                   GlyphEditor::FilledRectangleTool },
+        { QT_TRANSLATE_NOOP("FontEditor", "&Ellipse"),          QT_TRANSLATE_NOOP("FontEditor", "Drag out the outline of an ellipse"),                           GlyphEditor::EllipseTool },
+        { QT_TRANSLATE_NOOP("FontEditor", "Filled ellip&se"),   QT_TRANSLATE_NOOP("FontEditor", "Drag out a solid ellipse"),                                     GlyphEditor::FilledEllipseTool }
+    };
+    toolGroup = new QActionGroup( this );
+    for ( unsigned i = 0; i < sizeof( tools ) / sizeof( tools[ 0 ] ); i++ ) {
+        QAction *action = toolGroup->addAction( tr( tools[ i ].name ));
+        action->setStatusTip( tr( tools[ i ].tip ));
+        action->setData( (int) tools[ i ].tool );
+        action->setCheckable( true );
+        action->setChecked( tools[ i ].tool == GlyphEditor::PenTool );
+        connect( action, SIGNAL( triggered() ), this, SLOT( setTool() ));
+    }
+
     selectAllAction = new QAction( tr("Select &all"), this );
     connect( selectAllAction, SIGNAL( triggered() ), this, SLOT( setSelectAll() ));
 
     deselectAction = new QAction( tr("&Deselect"), this );
     connect( deselectAction, SIGNAL( triggered() ), this, SLOT( setDeselect() ));
 
+    invertSelectAction = new QAction( tr("&Invert selection"), this );
+    invertSelectAction->setStatusTip( tr("Select all unselected pixels and deselect the rest") );
+    connect( invertSelectAction, SIGNAL( triggered() ), this, SLOT( setInvertSelection() ));
+
     cutAction = new QAction( tr("&Cut"), this );
+    cutAction->setShortcut( QKeySequence::Cut );
+    cutAction->setStatusTip( tr("Copy the selected pixels to the clipboard and clear them") );
+    connect( cutAction, SIGNAL( triggered() ), this, SLOT( cutGlyph() ));
+
     copyAction = new QAction( tr("C&opy"), this );
+    copyAction->setShortcut( QKeySequence::Copy );
+    copyAction->setStatusTip( tr("Copy the selected pixels to the clipboard") );
+    connect( copyAction, SIGNAL( triggered() ), this, SLOT( copyGlyph() ));
+
     pasteAction = new QAction( tr("&Paste"), this );
+    pasteAction->setShortcut( QKeySequence::Paste );
+    pasteAction->setStatusTip( tr("Paste the clipboard contents over the selection") );
+    connect( pasteAction, SIGNAL( triggered() ), this, SLOT( pasteGlyph() ));
+
     pasteMaskAction = new QAction( tr("Paste as &mask"), this );
+    pasteMaskAction->setStatusTip( tr("Paste only the set pixels of the clipboard contents") );
+    connect( pasteMaskAction, SIGNAL( triggered() ), this, SLOT( pasteGlyphMask() ));
+
+    copyRangeAction = new QAction( tr("Copy &glyphs..."), this );
+    copyRangeAction->setStatusTip( tr("Copy whole glyphs, starting with the current one, to the clipboard") );
+    connect( copyRangeAction, SIGNAL( triggered() ), this, SLOT( copyGlyphRange() ));
+
+    pasteRangeAction = new QAction( tr("Paste g&lyphs"), this );
+    pasteRangeAction->setStatusTip( tr("Replace glyphs, starting with the current one, with those on the clipboard") );
+    connect( pasteRangeAction, SIGNAL( triggered() ), this, SLOT( pasteGlyphRange() ));
+
+    pasteRangeMaskAction = new QAction( tr("Paste glyphs as mas&k"), this );
+    pasteRangeMaskAction->setStatusTip( tr("Add the set pixels on the clipboard to glyphs, starting with the current one") );
+    connect( pasteRangeMaskAction, SIGNAL( triggered() ), this, SLOT( pasteGlyphRangeMask() ));
 
     clearAction = new QAction( tr("&Clear"), this );
     clearAction->setStatusTip( tr("Clear the current glyph") );
@@ -413,6 +1026,57 @@ void FontEditor::createActions()
     connect( aboutAction, SIGNAL( triggered() ), this, SLOT( about() ));
 
     compareAction = new QAction( tr("&Compare..."), this );
+
+    goToGlyphAction = new QAction( tr("&Go to glyph..."), this );
+    goToGlyphAction->setShortcut( QKeySequence( tr("Ctrl+G") ));
+    goToGlyphAction->setStatusTip( tr("Jump to a glyph by code point, UGL value, character or name") );
+    connect( goToGlyphAction, SIGNAL( triggered() ), this, SLOT( goToGlyph() ));
+
+    findSimilarAction = new QAction( tr("Find &similar glyphs..."), this );
+    findSimilarAction->setStatusTip( tr("List the glyphs which look most like the current glyph") );
+    connect( findSimilarAction, SIGNAL( triggered() ), this, SLOT( findSimilarGlyphs() ));
+
+    nextGlyphAction = new QAction( tr("&Next glyph"), this );
+    nextGlyphAction->setShortcut( QKeySequence::MoveToNextPage );
+    nextGlyphAction->setStatusTip( tr("Edit the next glyph in the font") );
+    connect( nextGlyphAction, SIGNAL( triggered() ), this, SLOT( nextGlyph() ));
+
+    prevGlyphAction = new QAction( tr("&Previous glyph"), this );
+    prevGlyphAction->setShortcut( QKeySequence::MoveToPreviousPage );
+    prevGlyphAction->setStatusTip( tr("Edit the previous glyph in the font") );
+    connect( prevGlyphAction, SIGNAL( triggered() ), this, SLOT( previousGlyph() ));
+
+    scaleFontAction = new QAction( tr("Derive &scaled font..."), this );
+    scaleFontAction->setStatusTip( tr("Create a new font at a larger size by scaling every glyph") );
+    connect( scaleFontAction, SIGNAL( triggered() ), this, SLOT( scaleFont() ));
+
+    deriveStyleAction = new QAction( tr("Derive &bold/italic font..."), this );
+    deriveStyleAction->setStatusTip( tr("Create a new font by emboldening and/or slanting every glyph") );
+    connect( deriveStyleAction, SIGNAL( triggered() ), this, SLOT( deriveStyle() ));
+
+    fitWidthsAction = new QAction( tr("&Fit widths to ink..."), this );
+    fitWidthsAction->setStatusTip( tr("Make the font proportional by cropping every glyph to its ink, with the given side bearings") );
+    connect( fitWidthsAction, SIGNAL( triggered() ), this, SLOT( fitWidths() ));
+
+    coverageAction = new QAction( tr("Code page &coverage..."), this );
+    coverageAction->setStatusTip( tr("Show which code pages the font covers, and the characters missing from each") );
+    connect( coverageAction, SIGNAL( triggered() ), this, SLOT( showCoverage() ));
+
+    variantsAction = new QAction( tr("Generate code page &variants..."), this );
+    variantsAction->setStatusTip( tr("Write a copy of the font for each of several code pages, with the glyphs rearranged to suit") );
+    connect( variantsAction, SIGNAL( triggered() ), this, SLOT( generateVariants() ));
+
+    kerningAction = new QAction( tr("&Kerning pairs..."), this );
+    kerningAction->setStatusTip( tr("Edit the adjustments to the spacing of particular pairs of characters") );
+    connect( kerningAction, SIGNAL( triggered() ), this, SLOT( showKerning() ));
+
+    familyAction = new QAction( tr("&Family view..."), this );
+    familyAction->setStatusTip( tr("Show the current character in every open size of this font family") );
+    connect( familyAction, SIGNAL( triggered() ), this, SLOT( showFamily() ));
+
+    duplicateAction = new QAction( tr("&Duplicate font"), this );
+    duplicateAction->setStatusTip( tr("Open a copy of this font in a new window") );
+    connect( duplicateAction, SIGNAL( triggered() ), this, SLOT( duplicateFont() ));
 }
 
 
@@ -420,15 +1084,20 @@ void FontEditor::createMenus()
 {
     fileMenu = menuBar()->addMenu( tr("&File"));
     fileMenu->addAction( newAction );
+    fileMenu->addAction( newOutlineAction );
     fileMenu->addAction( openAction );
     fileMenu->addAction( saveAction );
     fileMenu->addAction( saveAsAction );
-    fileMenu->addSeparator();
+    fileMenu->addAction( exportWindowsAction );
+    fileMenu->addAction( exportAtlasAction );
+    fileMenu->addAction( exportHeaderAction );
+    separatorAction = fileMenu->addSeparator();
     for ( int i = 0; i < MaxRecentFiles; i++ )
         fileMenu->addAction( recentFileActions[ i ] );
     fileMenu->addAction( clearRecentAction );
     fileMenu->addSeparator();
     fileMenu->addAction( exitAction );
+    connect( fileMenu, SIGNAL( aboutToShow() ), recentFiles, SLOT( refresh() ));
 
     editMenu = menuBar()->addMenu( tr("&Edit"));
     editMenu->addAction( undoAction );
@@ -438,15 +1107,27 @@ void FontEditor::createMenus()
     editMenu->addAction( selectAction );
     editMenu->addAction( selectAllAction );
     editMenu->addAction( deselectAction );
+    editMenu->addAction( invertSelectAction );
     editMenu->addSeparator();
     editMenu->addAction( cutAction );
     editMenu->addAction( copyAction );
     editMenu->addAction( pasteAction );
     editMenu->addAction( pasteMaskAction );
     editMenu->addSeparator();
+    editMenu->addAction( copyRangeAction );
+    editMenu->addAction( pasteRangeAction );
+    editMenu->addAction( pasteRangeMaskAction );
+    editMenu->addSeparator();
     editMenu->addAction( clearAction );
 
     glyphMenu = menuBar()->addMenu( tr("&Glyph"));
+    glyphMenu->addAction( nextGlyphAction );
+    glyphMenu->addAction( prevGlyphAction );
+    glyphMenu->addAction( goToGlyphAction );
+    glyphMenu->addSeparator();
+    toolMenu = glyphMenu->addMenu( tr("&Tools"));
+    toolMenu->addActions( toolGroup->actions() );
+    glyphMenu->addSeparator();
     columnMenu = glyphMenu->addMenu( tr("&Column"));
     columnMenu->addAction( insertColumnAction );
     columnMenu->addAction( addColumnAction );
@@ -476,6 +1157,21 @@ void FontEditor::createMenus()
     glyphMenu->addAction( flipYAction );
     glyphMenu->addSeparator();
     glyphMenu->addAction( compareAction );
+    glyphMenu->addAction( findSimilarAction );
+
+    fontMenu = menuBar()->addMenu( tr("F&ont"));
+    fontMenu->addAction( scaleFontAction );
+    fontMenu->addAction( deriveStyleAction );
+    fontMenu->addAction( fitWidthsAction );
+    fontMenu->addAction( coverageAction );
+    fontMenu->addAction( variantsAction );
+    fontMenu->addSeparator();
+    fontMenu->addAction( kerningAction );
+    fontMenu->addAction( familyAction );
+
+    windowMenu = menuBar()->addMenu( tr("&Window"));
+    windowMenu->addAction( duplicateAction );
+    connect( windowMenu, SIGNAL( aboutToShow() ), this, SLOT( updateWindowMenu() ));
 
     menuBar()->addSeparator();
     helpMenu = menuBar()->addMenu( tr("&Help"));
@@ -493,15 +1189,34 @@ void FontEditor::createStatusBar()
     messagesLabel->setIndent( 3 );
     messagesLabel->setMinimumSize( messagesLabel->sizeHint() );
 
+    coverageLabel = new QLabel( this );
+    coverageLabel->setIndent( 3 );
+
     modifiedLabel = new QLabel(" Modified ", this );
     modifiedLabel->setAlignment( Qt::AlignHCenter );
     modifiedLabel->setMinimumSize( modifiedLabel->sizeHint() );
 
+    loadProgress = new QProgressBar( this );
+    loadProgress->setMaximumWidth( 150 );
+    loadProgress->setMaximumHeight( modifiedLabel->sizeHint().height() );
+    loadProgress->hide();
+
+    cancelLoadButton = new QToolButton( this );
+    cancelLoadButton->setText( tr("Cancel") );
+    cancelLoadButton->setToolTip( tr("Stop loading the font") );
+    cancelLoadButton->setAutoRaise( true );
+    cancelLoadButton->hide();
+    connect( cancelLoadButton, SIGNAL( clicked() ), this, SLOT( cancelLoad() ));
+
     statusBar()->addWidget( messagesLabel, 1 );
+    statusBar()->addWidget( loadProgress );
+    statusBar()->addWidget( cancelLoadButton );
+    statusBar()->addWidget( coverageLabel );
     statusBar()->addWidget( modifiedLabel );
     statusBar()->setMinimumSize( statusBar()->sizeHint() );
 
     messagesLabel->setForegroundRole( QPalette::ButtonText );
+    coverageLabel->setForegroundRole( QPalette::ButtonText );
     modifiedLabel->setForegroundRole( QPalette::ButtonText );
 
 //    updateStatusBar();
@@ -519,32 +1234,163 @@ void FontEditor::createHelp()
 
 
 
+/* Fill in the recent file entries of the File menu.  This only uses what
+ * the background checks have found so far; it never touches the disk.
+ */
 void FontEditor::updateRecentFileActions()
 {
-/*
-    QMutableStringListIterator i( recentFiles );
-    int fileCount = 0;
-    while ( i.hasNext() ) {
-        fileCount++;
-        if ( !QFile::exists( i.next() ) || ( fileCount > MaxRecentFiles )) {
-            i.remove();
-        }
-    }
+    QStringList files = recentFiles->files();
+
     for ( int j = 0; j < MaxRecentFiles; j++ ) {
-        if ( j < recentFiles.count() ) {
-            QString text = tr("&%1 %2").arg( j+1 ).arg( QFileInfo( recentFiles[j] ).fileName() );
+        if ( j < files.count() ) {
+            QString text = tr("&%1 %2").arg( j+1 ).arg( QFileInfo( files[ j ] ).fileName() );
+            bool responding = ( recentFiles->status( files[ j ] ) != RecentFiles::NotResponding );
+            if ( !responding )
+                text += tr(" (not responding)");
             recentFileActions[ j ]->setText( text );
-            recentFileActions[ j ]->setData( recentFiles[ j ] );
-            recentFileActions[ j ]->setStatusTip( QDir::toNativeSeparators( recentFiles[ j ] ));
+            recentFileActions[ j ]->setData( files[ j ] );
+            recentFileActions[ j ]->setStatusTip( recentFiles->description( files[ j ] ));
+            recentFileActions[ j ]->setEnabled( responding );
             recentFileActions[ j ]->setVisible( true );
         }
         else {
             recentFileActions[ j ]->setVisible( false );
         }
     }
-    separatorAction->setVisible( !recentFiles.isEmpty() );
-    clearRecentAction->setVisible( !recentFiles.isEmpty() );
-*/
+    separatorAction->setVisible( !files.isEmpty() );
+    clearRecentAction->setVisible( !files.isEmpty() );
+}
+
+
+void FontEditor::setDocument( FontDocument *newDocument )
+{
+    if ( document )
+        document->deleteLater();
+    document = newDocument;
+    document->setParent( this );
+    undoStack->clear();
+    iUndoIndex = 0;
+    connect( document, SIGNAL( metricsChanged() ), scheduler, SLOT( postMetrics() ));
+    connect( document, SIGNAL( glyphChanged( int )), this, SLOT( updateGlyphCoverage( int )));
+    connect( document, SIGNAL( glyphChanged( int )), this, SLOT( updateChangedGlyph( int )));
+    overview->setDocument( document );
+    finder->setDocument( document );
+    coverage.setDocument( document );
+    coverageTimer->start();
+    if ( kerningDialog )
+        kerningDialog->setDocument( document );
+    if ( familyView && familyView->isVisible() )
+        rescanFamily();
+
+    // The index belongs to the document, and is built on the first search
+    similarIndex = new GlyphSimilarityIndex( document, document );
+
+    showGlyph( 0 );
+    updateMetrics();
+}
+
+
+/* Paste the clipboard into glyphs, starting with the current one, as one
+ * undo step.  Several blocks (from Copy glyphs) go into consecutive glyphs;
+ * a single block can be pasted into as many glyphs as the user asks for.
+ * A normal paste replaces the glyphs outright, taking on the pasted widths,
+ * while a mask paste ORs the blocks into the existing glyphs.  The document's
+ * store interns the results, so glyphs copied from another open font end up
+ * sharing their storage with it.
+ */
+void FontEditor::pasteRange( bool mask )
+{
+    QList<GlyphBitmap> blocks = GlyphClipboard::bitmaps();
+    int available = document->glyphCount() - currentGlyph;
+    if ( blocks.isEmpty() || available < 1 )
+        return;
+
+    int count = qMin( blocks.size(), available );
+    if ( blocks.size() == 1 && available > 1 ) {
+        bool ok;
+        count = QInputDialog::getInt( this, tr("Paste Glyphs"),
+                                      tr("Number of glyphs to paste into, starting with the current glyph:"),
+                                      1, 1, available, 1, &ok );
+        if ( !ok )
+            return;
+    }
+
+    QVector<GlyphBitmap> targets( count );
+    for ( int i = 0; i < count; i++ )
+        targets[ i ] = mask? document->glyph( currentGlyph + i ): blocks.at( blocks.size() == 1? 0: i );
+    if ( mask )
+        GlyphClipboard::compositeRange( targets, 0, count, blocks, QPoint( 0, 0 ), GlyphClipboard::Mask );
+
+    QList< QPair<int, GlyphBitmap> > changes;
+    for ( int i = 0; i < count; i++ ) {
+        // A glyph still being loaded must not overwrite the pasted one later
+        if ( isGlyphLoading( currentGlyph + i ))
+            loadingGlyphs.clearBit( currentGlyph + i );
+        changes.append( qMakePair( currentGlyph + i, targets.at( i )));
+    }
+    overview->setLoadingGlyphs( loadingGlyphs );
+    undoStack->push( new GlyphBatchCommand( document, changes, mask? tr("Paste glyphs as mask"): tr("Paste glyphs") ));
+    showMessage( tr("%n glyph(s) pasted", "", count ));
+}
+
+
+/* Abandon any font still being loaded.  The loader thread stops at the next
+ * glyph and cleans itself up; anything it has already sent is ignored.
+ */
+void FontEditor::stopLoading()
+{
+    if ( !loader )
+        return;
+
+    disconnect( loader, 0, this, 0 );
+    loader->cancel();
+    loader->deleteLater();
+    loader = NULL;
+
+    loadingGlyphs.clear();
+    overview->setLoadingGlyphs( loadingGlyphs );
+    setLoading( false );
+}
+
+
+/* Show or hide the load progress, and disable whatever can't work on a
+ * partly loaded font.
+ */
+void FontEditor::setLoading( bool loading )
+{
+    loadProgress->setVisible( loading );
+    cancelLoadButton->setVisible( loading );
+    saveAction->setEnabled( !loading );
+    saveAsAction->setEnabled( !loading );
+    exportWindowsAction->setEnabled( !loading );
+    exportAtlasAction->setEnabled( !loading );
+    exportHeaderAction->setEnabled( !loading );
+    copyRangeAction->setEnabled( !loading );
+    scaleFontAction->setEnabled( !loading );
+    fitWidthsAction->setEnabled( !loading );
+    deriveStyleAction->setEnabled( !loading );
+    variantsAction->setEnabled( !loading );
+    duplicateAction->setEnabled( !loading );
+    if ( !loading )
+        editor->setEnabled( true );
+}
+
+
+bool FontEditor::isGlyphLoading( int index ) const
+{
+    return ( index < loadingGlyphs.size() && loadingGlyphs.testBit( index ));
+}
+
+
+/* Open a font in a new window of its own, as a new, unsaved document.
+ */
+void FontEditor::openWindow( FontDocument *newDocument )
+{
+    FontEditor *window = new FontEditor();
+    window->setAttribute( Qt::WA_DeleteOnClose );
+    window->setDocument( newDocument );
+    window->updateModified( true );
+    window->show();
 }
 
 
@@ -560,9 +1406,7 @@ void FontEditor::setCurrentFile( const QString &fileName )
         currentModifyTime = QFileInfo( fileName ).lastModified();
         currentDir = QDir::cleanPath( QFileInfo( fileName ).absolutePath() );
         shownName = QFileInfo( currentFile ).fileName();
-        recentFiles.removeAll( currentFile );
-        recentFiles.prepend( currentFile );
-        updateRecentFileActions();
+        recentFiles->add( currentFile );
     }
     setWindowTitle( tr("Font Editor - %1 [*]").arg( shownName ));
 }
@@ -574,6 +1418,207 @@ void FontEditor::updatePosition( const QPoint &newPos )
 }
 
 
+/* Show a glyph in the editor.  Glyphs which haven't been loaded yet can be
+ * selected, but not edited until they arrive; selecting one moves it (and
+ * whatever else is on screen) to the front of the loading queue.
+ */
+void FontEditor::showGlyph( int index )
+{
+    if ( index < 0 || index >= document->glyphCount() )
+        return;
+
+    currentGlyph = index;
+    editor->setBaseLine( document->baseLine() );
+    editor->setGlyphBitmap( document->glyph( index ));
+    editor->setEnabled( !isGlyphLoading( index ));
+    infoBar->setUglValue( document->firstChar() + index );
+    infoBar->setIncrement( editor->increment() );
+    overview->setCurrentGlyph( index );
+    if ( familyView && familyView->isVisible() )
+        familyView->setCharacter( document->firstChar() + index );
+
+    if ( isGlyphLoading( index ))
+        updateLoadPriority();
+}
+
+
+/* Reload the editor after an undo step, which may have changed the glyph
+ * being edited.  The step moved over is the one between the old and new
+ * stack index; if it changed nothing (its glyphs have been edited since,
+ * or the stack was cleared) the font is left as it was, and so is its
+ * modified state.
+ */
+void FontEditor::refreshGlyph( int index )
+{
+    const QUndoCommand *step = undoStack->command( qMin( index, iUndoIndex ));
+    iUndoIndex = index;
+    if ( !step || !static_cast<const GlyphBatchCommand *>( step )->applied() )
+        return;
+    if ( document->glyph( currentGlyph ) != editor->glyphBitmap() )
+        showGlyph( currentGlyph );
+    updateModified( true );
+}
+
+
+/* Keep the editor in step with changes made to the current glyph from
+ * elsewhere, such as the family view.  The editor's own changes, stored by
+ * updateGlyph(), are skipped without comparing the bitmaps.
+ */
+void FontEditor::updateChangedGlyph( int index )
+{
+    if ( bStoringGlyph )
+        return;
+    if ( index == currentGlyph && !isGlyphLoading( index ) && document->glyph( index ) != editor->glyphBitmap() )
+        editor->setGlyphBitmap( document->glyph( index ));
+}
+
+
+/* The header and glyph table have been read: show the font straight away,
+ * with every glyph blank until its bitmap arrives.
+ */
+void FontEditor::loadHeader()
+{
+    if ( !loader || sender() != loader )
+        return;
+
+    FontDocument *loaded = loader->createDocument( this );
+    loadingGlyphs = QBitArray( loaded->glyphCount(), true );
+    setDocument( loaded );
+    overview->setLoadingGlyphs( loadingGlyphs );
+    if ( loader->isImported() ) {
+        // Don't let Save write an OS/2 font over the module or foreign file
+        setCurrentFile("");
+        if ( loader->resource() >= 0 )
+            showMessage( tr("Loaded font resource %1 from %2").arg( loader->resource() + 1 ).arg( QDir::toNativeSeparators( loader->fileName() )));
+        else
+            showMessage( tr("Imported %1").arg( QDir::toNativeSeparators( loader->fileName() )));
+    }
+    else
+        setCurrentFile( loader->fileName() );
+    loadProgress->setRange( 0, loaded->glyphCount() );
+    updateLoadPriority();
+}
+
+
+void FontEditor::loadGlyphs()
+{
+    if ( !loader || sender() != loader )
+        return;
+
+    QList< QPair<int, GlyphBitmap> > batch = loader->takeGlyphs();
+    QList< QPair<int, GlyphBitmap> > arrived;
+    for ( int i = 0; i < batch.size(); i++ ) {
+        int index = batch.at( i ).first;
+        if ( !isGlyphLoading( index ))
+            continue;
+        loadingGlyphs.clearBit( index );
+        arrived << batch.at( i );
+    }
+    document->setGlyphBatch( arrived );
+    overview->setLoadingGlyphs( loadingGlyphs );
+
+    if ( !editor->isEnabled() && !isGlyphLoading( currentGlyph ))
+        showGlyph( currentGlyph );
+}
+
+
+void FontEditor::loadFinished()
+{
+    if ( !loader || sender() != loader )
+        return;
+
+    QString fileName = loader->fileName();
+    QString error = loader->errorString();
+    int count = loadingGlyphs.size();
+    stopLoading();
+
+    if ( !error.isEmpty() ) {
+        QMessageBox::critical( this, tr("Error"),
+                               tr("Unable to open %1:\n%2").arg( QDir::toNativeSeparators( fileName )).arg( error ));
+        return;
+    }
+    showMessage( tr("Loaded file: %1 (%n glyph(s))", "", count ).arg( QDir::toNativeSeparators( fileName )));
+}
+
+
+/* Give up on the font being loaded, leaving an empty document in its place.
+ */
+void FontEditor::cancelLoad()
+{
+    if ( !loader )
+        return;
+
+    stopLoading();
+    setDocument( new FontDocument( 256, 32, 32, 8, this ));
+    setCurrentFile("");
+    showMessage( tr("Loading cancelled") );
+}
+
+
+/* Ask the loader for the current glyph first, then the ones on screen.
+ */
+void FontEditor::updateLoadPriority()
+{
+    if ( !loader || loadingGlyphs.isEmpty() )
+        return;
+
+    QList<int> wanted;
+    if ( isGlyphLoading( currentGlyph ))
+        wanted << currentGlyph;
+    int last = overview->lastVisibleGlyph();
+    for ( int i = overview->firstVisibleGlyph(); i <= last; i++ ) {
+        if ( isGlyphLoading( i ))
+            wanted << i;
+    }
+    loader->prioritize( wanted );
+}
+
+
+void FontEditor::updateLoadProgress( int loaded, int total )
+{
+    if ( !loader || sender() != loader )
+        return;
+
+    loadProgress->setRange( 0, total );
+    loadProgress->setValue( loaded );
+}
+
+
+/* Store the glyph being edited back into the font.  The document updates
+ * its metrics for this one glyph, and signals if the font-wide values have
+ * changed as a result.
+ */
+void FontEditor::updateGlyph()
+{
+    bStoringGlyph = true;
+    document->setGlyph( currentGlyph, editor->glyphBitmap() );
+    bStoringGlyph = false;
+    scheduler->post( ChangeScheduler::IncrementChange | ChangeScheduler::ModifiedChange );
+}
+
+
+/* The status bar and window state are brought up to date once per frame,
+ * with the values current at that point, rather than after every pixel.
+ */
+void FontEditor::dispatchChanges( int changes )
+{
+    if ( changes & ChangeScheduler::PositionChange )
+        updatePosition( scheduler->position() );
+    if ( changes & ChangeScheduler::IncrementChange )
+        infoBar->setIncrement( editor->increment() );
+    if ( changes & ChangeScheduler::MetricsChange )
+        updateMetrics();
+    if ( changes & ChangeScheduler::ModifiedChange )
+        updateModified( true );
+}
+
+
+void FontEditor::updateMetrics()
+{
+    infoBar->setMaxExtent( document->metrics().maxBaselineExtent() );
+}
+
+
 void FontEditor::updateModified()
 {
     //updateModified( editor->document()->isModified() );
@@ -581,6 +1626,8 @@ void FontEditor::updateModified()
 }
 void FontEditor::updateModified( bool isModified )
 {
+    if ( !isModified )
+        scheduler->cancel( ChangeScheduler::ModifiedChange );
     //editor->document()->setModified( isModified );
     setWindowModified( isModified );
     modifiedLabel->setText( isModified? tr("Modified"): "");
@@ -588,6 +1635,12 @@ void FontEditor::updateModified( bool isModified )
 }
 
 
+void FontEditor::showMessage( const QString &message )
+{
+    messagesLabel->setText( message );
+}
+
+
 void FontEditor::setSelect()
 {
     editor->setSelectMode( true );
@@ -609,18 +1662,66 @@ void FontEditor::setDeselect()
 }
 
 
+/* Choosing a drawing tool leaves selection mode.
+ */
+void FontEditor::setTool()
+{
+    QAction *action = qobject_cast<QAction *>( sender() );
+    if ( !action )
+        return;
+    if ( selectAction->isChecked() )
+        setDeselect();
+    editor->setTool( (GlyphEditor::Tool) action->data().toInt() );
+}
+
+
+/* A stroke, fill or other edit of the current glyph has been finished:
+ * record it as a single undo step.  A pen stroke has already been stored
+ * in the font as it was drawn, so the editor supplies the glyph as it was
+ * before the edit.
+ */
+void FontEditor::recordEdit( const QString &description, const GlyphBitmap &before )
+{
+    undoStack->push( new GlyphBatchCommand( document, currentGlyph, before, editor->glyphBitmap(), description ));
+}
+
+
+void FontEditor::setInvertSelection()
+{
+    editor->invertSelection();
+    selectAction->setChecked( true );
+}
+
+
 void FontEditor::readSettings()
 {
+    QSettings settings( SETTINGS_VENDOR, SETTINGS_APP );
+
+    restoreGeometry( settings.value("Geometry").toByteArray() );
+    currentDir = settings.value("LastDir", currentDir ).toString();
+
+    // The files are checked in the background, so this returns immediately
+    recentFiles->setFiles( settings.value("RecentFiles").toStringList() );
+    // Memory (in KB) kept for decoded glyphs; there is no UI for this
+    GlyphStore::setCacheLimit( settings.value("GlyphCacheKB", GlyphStore::cacheLimit() ).toInt() );
 }
 
 
 void FontEditor::writeSettings()
 {
+    QSettings settings( SETTINGS_VENDOR, SETTINGS_APP );
+
+    settings.setValue("Geometry", saveGeometry() );
+    settings.setValue("LastDir", currentDir );
+    settings.setValue("RecentFiles", recentFiles->files() );
+    settings.setValue("GlyphCacheKB", GlyphStore::cacheLimit() );
 }
 
 
 bool FontEditor::okToContinue()
 {
+    // An edit made within the last frame counts too
+    scheduler->flush();
     if ( isWindowModified() ) {
         // This approach allows us to set a shortcut on the Discard button
         QMessageBox confirm( QMessageBox::Warning,
@@ -667,10 +1768,259 @@ bool FontEditor::saveAs()
 }
 
 
+/* Write a copy of the font in Windows format.  This doesn't change the
+ * current file name, since the Windows format can't hold everything that an
+ * OS/2 font can.
+ */
+bool FontEditor::exportWindowsFont()
+{
+    int count = WinFontFile::maxGlyphs( document );
+    if ( count < 1 ) {
+        QMessageBox::critical( this, tr("Error"),
+                               tr("A Windows font can only hold characters 0 to 255, "
+                                  "but this font starts at character %1.").arg( document->firstChar() ));
+        return false;
+    }
+    if ( count < document->glyphCount() ) {
+        int r = QMessageBox::warning( this, tr("Export as Windows Font"),
+                                      tr("A Windows font can only hold characters 0 to 255, so only "
+                                         "the first %1 of the %2 glyphs will be exported."
+                                         "<p>Export anyway?</p>").arg( count ).arg( document->glyphCount() ),
+                                      QMessageBox::Yes | QMessageBox::No,
+                                      QMessageBox::Yes
+                                    );
+        if ( r == QMessageBox::No )
+            return false;
+    }
+
+#ifndef __OS2__
+    QString fileName = QFileDialog::getSaveFileName( this,
+                                                     tr("Export as Windows Font"),
+                                                     currentDir,
+                                                     tr("Windows bitmap fonts (*.fnt);;All files (*)"));
+#else
+    QString fileName = OS2Native::getSaveFileName( this,
+                                                   tr("Export as Windows Font"),
+                                                   currentDir,
+                                                   tr("Windows bitmap fonts (*.fnt);;All files (*)"));
+#endif
+    if ( fileName.isEmpty() )
+        return false;
+
+    QApplication::setOverrideCursor( Qt::WaitCursor );
+    QByteArray data = WinFontFile::write( document );
+    QFile file( fileName );
+    bool ok = file.open( QIODevice::WriteOnly | QIODevice::Truncate ) &&
+              ( file.write( data ) == data.size() );
+    file.close();
+    QApplication::restoreOverrideCursor();
+
+    if ( !ok ) {
+        QMessageBox::critical( this, tr("Error"), tr("Error writing file"));
+        return false;
+    }
+    showMessage( tr("Exported file: %1 (%2 bytes written)").arg( QDir::toNativeSeparators( fileName )).arg( data.size() ));
+    return true;
+}
+
+
+/* Write the font as a glyph atlas image (PNG) plus its binary index, which
+ * goes alongside the image with the extension .idx.
+ */
+bool FontEditor::exportAtlas()
+{
+    QString error;
+    if ( !GlyphAtlas::canExport( document, &error )) {
+        QMessageBox::critical( this, tr("Error"), error );
+        return false;
+    }
+
+    AtlasDialog dialog( this );
+    if ( dialog.exec() != QDialog::Accepted )
+        return false;
+
+#ifndef __OS2__
+    QString fileName = QFileDialog::getSaveFileName( this,
+                                                     tr("Export Glyph Atlas"),
+                                                     currentDir,
+                                                     tr("PNG images (*.png);;All files (*)"));
+#else
+    QString fileName = OS2Native::getSaveFileName( this,
+                                                   tr("Export Glyph Atlas"),
+                                                   currentDir,
+                                                   tr("PNG images (*.png);;All files (*)"));
+#endif
+    if ( fileName.isEmpty() )
+        return false;
+
+    QFileInfo info( fileName );
+    QString indexName = info.path() + "/" + info.completeBaseName() + ".idx";
+
+    QApplication::setOverrideCursor( Qt::WaitCursor );
+    GlyphAtlas::Atlas atlas = GlyphAtlas::build( document, dialog.format(), dialog.padding(), &error );
+    if ( atlas.image.isNull() ) {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::critical( this, tr("Error"), error );
+        return false;
+    }
+    QByteArray index = GlyphAtlas::index( document, atlas );
+    QFile file( indexName );
+    bool ok = atlas.image.save( fileName, "PNG" ) &&
+              file.open( QIODevice::WriteOnly | QIODevice::Truncate ) &&
+              ( file.write( index ) == index.size() );
+    file.close();
+    QApplication::restoreOverrideCursor();
+
+    if ( !ok ) {
+        QMessageBox::critical( this, tr("Error"), tr("Error writing file"));
+        return false;
+    }
+    showMessage( tr("Exported atlas: %1 (%2 x %3 pixels, %4% used) and %5")
+                    .arg( QDir::toNativeSeparators( fileName ))
+                    .arg( atlas.image.width() ).arg( atlas.image.height() )
+                    .arg( 100.0 * atlas.glyphArea / ((qreal) atlas.image.width() * atlas.image.height() ), 0, 'f', 1 )
+                    .arg( QDir::toNativeSeparators( indexName )));
+    return true;
+}
+
+
+/* Write the font as tables in a C/C++ header (see fontheader.h).
+ */
+bool FontEditor::exportHeader()
+{
+    HeaderDialog dialog( FontHeader::defaultName( document ), this );
+    if ( dialog.exec() != QDialog::Accepted )
+        return false;
+    FontHeader::Options options = dialog.options();
+
+    QString suggested = QDir( currentDir ).filePath( options.name + ".h");
+#ifndef __OS2__
+    QString fileName = QFileDialog::getSaveFileName( this,
+                                                     tr("Export C Header"),
+                                                     suggested,
+                                                     tr("C/C++ headers (*.h);;All files (*)"));
+#else
+    QString fileName = OS2Native::getSaveFileName( this,
+                                                   tr("Export C Header"),
+                                                   suggested,
+                                                   tr("C/C++ headers (*.h);;All files (*)"));
+#endif
+    if ( fileName.isEmpty() )
+        return false;
+
+    QApplication::setOverrideCursor( Qt::WaitCursor );
+    QByteArray data = FontHeader::generate( document, options );
+    QFile file( fileName );
+    bool ok = file.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ) &&
+              ( file.write( data ) != -1 );
+    file.close();
+    QApplication::restoreOverrideCursor();
+
+    if ( !ok ) {
+        QMessageBox::critical( this, tr("Error"), tr("Error writing file"));
+        return false;
+    }
+    showMessage( tr("Exported file: %1").arg( QDir::toNativeSeparators( fileName )));
+    return true;
+}
+
+
+/* Start loading a font.  This returns as soon as the loader thread has been
+ * started; the font appears once its header has been read, and the glyphs
+ * fill in as they are decoded.
+ */
+bool FontEditor::loadFile( const QString &fileName, bool createIfNew )
+{
+    stopLoading();
+
+    if ( !QFile::exists( fileName )) {
+        if ( !createIfNew ) {
+            QMessageBox::critical( this, tr("Error"),
+                                   tr("Unable to open %1: the file does not exist.").arg( QDir::toNativeSeparators( fileName )));
+            return false;
+        }
+        setDocument( new FontDocument( 256, 32, 32, 8, this ));
+        setCurrentFile( fileName );
+        return true;
+    }
+
+    int resource = -1;
+    if ( !chooseFontResource( fileName, &resource ))
+        return false;
+
+    loader = new FontLoader( fileName, resource, this );
+    connect( loader, SIGNAL( headerLoaded() ), this, SLOT( loadHeader() ));
+    connect( loader, SIGNAL( glyphsLoaded() ), this, SLOT( loadGlyphs() ));
+    connect( loader, SIGNAL( progress( int, int )), this, SLOT( updateLoadProgress( int, int )));
+    connect( loader, SIGNAL( finished() ), this, SLOT( loadFinished() ));
+
+    loadProgress->setRange( 0, 0 );
+    setLoading( true );
+    showMessage( tr("Loading %1...").arg( QDir::toNativeSeparators( fileName )));
+    loader->start( QThread::LowPriority );
+    return true;
+}
+
+
+/* If the file is an OS/2 font DLL or a Windows .FON file, ask which of its
+ * fonts to open (if there is more than one) and set resource to its index;
+ * otherwise resource is left alone.  Returns false if there is nothing to
+ * open or the user cancelled.
+ */
+bool FontEditor::chooseFontResource( const QString &fileName, int *resource )
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly ))
+        return true;            // let the loader report the error
+
+    qint64       size = file.size();
+    const uchar *data = file.map( 0, size );
+    QByteArray   contents;
+    if ( !data ) {
+        contents = file.readAll();
+        data = (const uchar *) contents.constData();
+        size = contents.size();
+    }
+    if ( !FontModule::recognize( data, size ))
+        return true;
+
+    QString error;
+    QList<FontModule::Resource> fonts = FontModule::fontResources( data, size, &error );
+    if ( fonts.isEmpty() ) {
+        QMessageBox::critical( this, tr("Error"),
+                               tr("Unable to open %1: %2").arg( QDir::toNativeSeparators( fileName )).arg( error ));
+        return false;
+    }
+
+    *resource = 0;
+    if ( fonts.size() == 1 )
+        return true;
+
+    QStringList items;
+    for ( int i = 0; i < fonts.size(); i++ ) {
+        FontFileReader *reader = FontFileReader::create( data + fonts.at( i ).offset, fonts.at( i ).size );
+        if ( reader && reader->parse() )
+            items << tr("%1 %2 pt (%3)").arg( reader->info().faceName ).arg( reader->info().pointSize ).arg( fonts.at( i ).id );
+        else
+            items << tr("Font resource %1").arg( fonts.at( i ).id );
+        delete reader;
+    }
+
+    bool ok;
+    QString item = QInputDialog::getItem( this, tr("Open Font"),
+                                          tr("%1 contains more than one font.  Choose the font to open:").arg( QFileInfo( fileName ).fileName() ),
+                                          items, 0, false, &ok );
+    if ( !ok )
+        return false;
+    *resource = items.indexOf( item );
+    return true;
+}
+
+
 bool FontEditor::saveFile( const QString &fileName )
 {
-    QFile *file = new QFile( fileName );
-    bool bExists = ( file->exists() );
+    QFile file( fileName );
+    bool bExists = ( file.exists() );
 
     if ( bExists ) {
         QDateTime fileTime = QFileInfo( fileName ).lastModified();
@@ -691,24 +2041,27 @@ bool FontEditor::saveFile( const QString &fileName )
     }
 
     // Always open in read/write mode, as it seems to preserve EAs on existing files.
-    if ( !file->open( QIODevice::ReadWrite | QFile::Text )) {
+    if ( !file.open( QIODevice::ReadWrite )) {
         QMessageBox::critical( this, tr("Error"), tr("Error writing file"));
         return false;
     }
 
     QApplication::setOverrideCursor( Qt::WaitCursor );
 
-    /*
-    QDataStream out( file );
-    // Use to write data structures:
-    out.writeRawData( pchData, iBytes )
-    if ( iSize != -1 ) file->resize( iSize );
-    file->flush();
-    file->close();
+    QByteArray data = OS2FontFile::write( document );
+    qint64 iSize = file.write( data );
+    if ( iSize != -1 ) file.resize( iSize );
+    file.flush();
+    file.close();
+
+    if ( iSize != data.size() ) {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::critical( this, tr("Error"), tr("Error writing file"));
+        return false;
+    }
 
-    showMessage( tr("Saved file: %1 (%2 bytes written)").arg( QDir::toNativeSeparators( fileName )).arg( iSize ));
-    */
     setCurrentFile( fileName );
+    showMessage( tr("Saved file: %1 (%2 bytes written)").arg( QDir::toNativeSeparators( fileName )).arg( iSize ));
 
     if ( !bExists ) {
 #ifdef __OS2__
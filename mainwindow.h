@@ -22,17 +22,37 @@
 #define QBFONT_MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QBitArray>
 #include <QDateTime>
 
+#include "codepagecoverage.h"
+#include "fontdocument.h"
 #include "glypheditor.h"
 #include "glyphstatus.h"
+#include "recentfiles.h"
 #include "qbf_const.h"
 
 
 class QAction;
 class QActionGroup;
 class QLabel;
+class QProgressBar;
+class QProgressDialog;
 class QSplitter;
+class QTimer;
+class QToolButton;
+class QUndoStack;
+class ChangeScheduler;
+class CoverageDialog;
+class FamilyView;
+class KerningDialog;
+class FontLoader;
+class FontRasterizer;
+class GlyphFinder;
+class GlyphOverview;
+class GlyphSimilarityIndex;
+class SimilarGlyphsDialog;
+template <typename T> class QFutureWatcher;
 
 
 class FontEditor : public QMainWindow
@@ -53,26 +73,49 @@ protected:
 
 private slots:
     void newFile();
+    void newFromOutline();
+    void outlineRendered();
     void open();
 
     bool save();
     bool saveAs();
+    bool exportWindowsFont();
+    bool exportAtlas();
+    bool exportHeader();
 
     void about();
     void showGeneralHelp();
     void showKeysHelp();
     void openRecentFile();
     void clearRecentFiles();
+    void updateRecentFileActions();
 /*
     void updateStatusBar();
 */
     void updatePosition( const QPoint &newPos );
+    void updateGlyph();
+    void dispatchChanges( int changes );
+    void updateMetrics();
     void updateModified();
     void updateModified( bool isModified );
 
     void setSelect();
     void setSelectAll();
     void setDeselect();
+    void setInvertSelection();
+    void setTool();
+    void recordEdit( const QString &description, const GlyphBitmap &before );
+
+    void cutGlyph();
+    void copyGlyph();
+    void pasteGlyph();
+    void pasteGlyphMask();
+    void copyGlyphRange();
+    void pasteGlyphRange();
+    void pasteGlyphRangeMask();
+
+    void nextGlyph();
+    void previousGlyph();
 
     void clearGlyph();
     void flipGlyphX();
@@ -87,6 +130,39 @@ private slots:
     void widenRight();
     void widenBoth();
 
+    void goToGlyph();
+    void findSimilarGlyphs();
+    void searchSimilarGlyphs();
+
+    void scaleFont();
+    void fitWidths();
+    void deriveStyle();
+    void showCoverage();
+    void generateVariants();
+    void updateGlyphCoverage( int index );
+    void updateCoverage();
+    void showKerning();
+    void updateKerning();
+    void showFamily();
+    void rescanFamily();
+    void showCharacter( int character );
+    void updateFamilyGlyph( FontDocument *edited, int index, const GlyphBitmap &glyph );
+
+    void duplicateFont();
+    void updateWindowMenu();
+    void raiseWindow();
+
+    void showGlyph( int index );
+    void refreshGlyph( int index );
+    void updateChangedGlyph( int index );
+
+    void loadHeader();
+    void loadGlyphs();
+    void loadFinished();
+    void cancelLoad();
+    void updateLoadPriority();
+    void updateLoadProgress( int loaded, int total );
+
 private:
     // Setup methods
     void createActions();
@@ -99,30 +175,46 @@ private:
     // Action methods
     bool okToContinue();
     bool saveFile( const QString &fileName );
+    bool chooseFontResource( const QString &fileName, int *resource );
 
     // Misc methods
+    void setDocument( FontDocument *newDocument );
+    void stopLoading();
+    void setLoading( bool loading );
+    bool isGlyphLoading( int index ) const;
+    void pasteRange( bool mask );
+    void openWindow( FontDocument *newDocument );
     void setCurrentFile( const QString &fileName );
-    void updateRecentFileActions();
     void showMessage( const QString &message );
     void launchAssistant( const QString &panel );
 
     // GUI objects
     QSplitter *splitter;
+    QFrame *leftPanel;
     QFrame *rightPanel;
+    GlyphFinder *finder;
+    GlyphOverview *overview;
     GlyphStatus *infoBar;
     GlyphEditor *editor;
 
     QLabel *messagesLabel;
+    QLabel *coverageLabel;
     QLabel *modifiedLabel;
+    QProgressBar *loadProgress;
+    QToolButton *cancelLoadButton;
 
     // Menus
     enum { MaxRecentFiles = 5 };
 
     QMenu   *fileMenu;
     QAction *newAction;
+    QAction *newOutlineAction;
     QAction *openAction;
     QAction *saveAction;
     QAction *saveAsAction;
+    QAction *exportWindowsAction;
+    QAction *exportAtlasAction;
+    QAction *exportHeaderAction;
     QAction *recentFileActions[ MaxRecentFiles ];
     QAction *clearRecentAction;
     QAction *separatorAction;
@@ -135,16 +227,27 @@ private:
     QAction *selectAction;
     QAction *selectAllAction;
     QAction *deselectAction;
+    QAction *invertSelectAction;
     QAction *cutAction;
     QAction *copyAction;
     QAction *pasteAction;
     QAction *pasteMaskAction;
+    QAction *copyRangeAction;
+    QAction *pasteRangeAction;
+    QAction *pasteRangeMaskAction;
 
     QMenu   *glyphMenu;
     QAction *flipXAction;
     QAction *flipYAction;
     QAction *clearAction;
     QAction *compareAction;
+    QAction *goToGlyphAction;
+    QAction *findSimilarAction;
+    QAction *nextGlyphAction;
+    QAction *prevGlyphAction;
+
+    QMenu        *toolMenu;
+    QActionGroup *toolGroup;
 
     QMenu   *columnMenu;
     QAction *insertColumnAction;
@@ -170,13 +273,61 @@ private:
     QAction *shiftLeftAction;
     QAction *shiftRightAction;
 
+    QMenu   *fontMenu;
+    QAction *scaleFontAction;
+    QAction *fitWidthsAction;
+    QAction *deriveStyleAction;
+    QAction *coverageAction;
+    QAction *variantsAction;
+    QAction *kerningAction;
+    QAction *familyAction;
+
+    QMenu   *windowMenu;
+    QAction *duplicateAction;
+
     QMenu   *helpMenu;
     QAction *helpGeneralAction;
     QAction *helpKeysAction;
     QAction *aboutAction;
 
+    // The font being edited, and the index of the glyph in the editor
+    FontDocument *document;
+    int           currentGlyph;
+    bool          bStoringGlyph;    // the editor's glyph is being stored
+
+    // Lookup of glyphs resembling the current one (created with the document)
+    GlyphSimilarityIndex *similarIndex;
+    SimilarGlyphsDialog  *similarDialog;
+
+    // Code pages covered by the font, refreshed shortly after glyphs change
+    CodePageCoverage coverage;
+    CoverageDialog  *coverageDialog;
+    QTimer          *coverageTimer;
+
+    // Undo steps for edits and for changes to the whole font
+    QUndoStack      *undoStack;
+    int              iUndoIndex;       // stack index before the last change
+
+    // Status bar and modified-state updates, delivered once per frame
+    ChangeScheduler *scheduler;
+
+    // Kerning pairs, edited directly in the document
+    KerningDialog   *kerningDialog;
+
+    // Every size of this font's family open in a window, side by side
+    FamilyView      *familyView;
+
+    // The font being loaded, if any, and which of its glyphs haven't arrived
+    FontLoader   *loader;
+    QBitArray     loadingGlyphs;
+
+    // The font being rendered from an outline font, if any
+    FontRasterizer         *rasterizer;
+    QFutureWatcher<void>   *rasterWatcher;
+    QProgressDialog        *rasterProgress;
+
     // Other class variables
-    QStringList recentFiles;
+    RecentFiles *recentFiles;
     QString     currentFile;
     QString     currentDir;
     QDateTime   currentModifyTime;
@@ -0,0 +1,180 @@
+/******************************************************************************
+** metricsindex.cpp
+**
+** Incrementally maintained font-wide metrics.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include "metricsindex.h"
+
+// Neutral values for the min/max fields of nodes with no inked glyphs
+#define NO_BEARING      0x7FFF
+
+
+// ---------------------------------------------------------------------------
+// Measure a glyph.  The ink bounds come from GlyphBitmap::inkBounds(), which
+// finds them with leading/trailing zero counts on the OR of all rows.  The
+// baseline is given as the number of rows below it, as in GlyphEditor.
+//
+GlyphMetrics GlyphMetrics::measure( const GlyphBitmap &bitmap, int baseLine )
+{
+    GlyphMetrics metrics;
+    metrics.increment = bitmap.width();
+
+    QRect ink = bitmap.inkBounds();
+    if ( ink.isNull() )
+        return metrics;
+
+    int baseRow = bitmap.height() - baseLine;      // first row below the baseline
+    metrics.blank        = false;
+    metrics.ascent       = qMax( 0, baseRow - ink.top() );
+    metrics.descent      = qMax( 0, ink.bottom() - baseRow + 1 );
+    metrics.leftBearing  = ink.left();
+    metrics.rightBearing = bitmap.width() - 1 - ink.right();
+    return metrics;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+FontMetricsIndex::FontMetricsIndex()
+{
+    size = 0;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+/* Rebuild the whole index, e.g. when a font is loaded.  This is O(n); all
+ * later changes should go through update().
+ */
+void FontMetricsIndex::reset( const QVector<GlyphMetrics> &all )
+{
+    leaves = all;
+    size = all.size();
+    tree.resize( qMax( 2 * size, 2 ));
+
+    for ( int i = 0; i < size; i++ )
+        tree[ size + i ] = leafNode( all.at( i ));
+    for ( int i = size - 1; i >= 1; i-- )
+        tree[ i ] = mergeNodes( tree.at( 2 * i ), tree.at( 2 * i + 1 ));
+    if ( size == 0 )
+        tree[ 1 ] = leafNode( GlyphMetrics() );
+}
+
+
+/* Replace one glyph's metrics and update its ancestors in the tree.
+ */
+void FontMetricsIndex::update( int index, const GlyphMetrics &metrics )
+{
+    if ( index < 0 || index >= size )
+        return;
+
+    leaves[ index ] = metrics;
+    int i = size + index;
+    tree[ i ] = leafNode( metrics );
+    for ( i /= 2; i >= 1; i /= 2 )
+        tree[ i ] = mergeNodes( tree.at( 2 * i ), tree.at( 2 * i + 1 ));
+}
+
+
+int FontMetricsIndex::maxIncrement() const
+{
+    return size? tree.at( 1 ).maxIncrement: 0;
+}
+
+
+int FontMetricsIndex::minIncrement() const
+{
+    return size? tree.at( 1 ).minIncrement: 0;
+}
+
+
+int FontMetricsIndex::averageIncrement() const
+{
+    return size? (int)(( tree.at( 1 ).sumIncrement + size / 2 ) / size ): 0;
+}
+
+
+int FontMetricsIndex::maxAscender() const
+{
+    return size? tree.at( 1 ).maxAscent: 0;
+}
+
+
+int FontMetricsIndex::maxDescender() const
+{
+    return size? tree.at( 1 ).maxDescent: 0;
+}
+
+
+int FontMetricsIndex::minLeftBearing() const
+{
+    return inkedGlyphs()? tree.at( 1 ).minLeftBearing: 0;
+}
+
+
+int FontMetricsIndex::minRightBearing() const
+{
+    return inkedGlyphs()? tree.at( 1 ).minRightBearing: 0;
+}
+
+
+int FontMetricsIndex::inkedGlyphs() const
+{
+    return size? tree.at( 1 ).inked: 0;
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+FontMetricsIndex::Node FontMetricsIndex::leafNode( const GlyphMetrics &metrics )
+{
+    Node node;
+    node.maxIncrement    = metrics.increment;
+    node.minIncrement    = metrics.increment;
+    node.sumIncrement    = metrics.increment;
+    node.maxAscent       = metrics.ascent;
+    node.maxDescent      = metrics.descent;
+    node.minLeftBearing  = metrics.blank? NO_BEARING: metrics.leftBearing;
+    node.minRightBearing = metrics.blank? NO_BEARING: metrics.rightBearing;
+    node.inked           = metrics.blank? 0: 1;
+    return node;
+}
+
+
+FontMetricsIndex::Node FontMetricsIndex::mergeNodes( const Node &a, const Node &b )
+{
+    Node node;
+    node.maxIncrement    = qMax( a.maxIncrement, b.maxIncrement );
+    node.minIncrement    = qMin( a.minIncrement, b.minIncrement );
+    node.sumIncrement    = a.sumIncrement + b.sumIncrement;
+    node.maxAscent       = qMax( a.maxAscent, b.maxAscent );
+    node.maxDescent      = qMax( a.maxDescent, b.maxDescent );
+    node.minLeftBearing  = qMin( a.minLeftBearing, b.minLeftBearing );
+    node.minRightBearing = qMin( a.minRightBearing, b.minRightBearing );
+    node.inked           = a.inked + b.inked;
+    return node;
+}
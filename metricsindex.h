@@ -0,0 +1,98 @@
+/******************************************************************************
+** metricsindex.h
+**
+** Incrementally maintained font-wide metrics.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef METRICSINDEX_H
+#define METRICSINDEX_H
+
+#include <QVector>
+
+#include "glyphbitmap.h"
+
+
+/* Metrics of a single glyph.  Ascent and descent are the number of inked
+ * rows above and below the baseline; the bearings are the number of blank
+ * columns to the left and right of the ink.  A blank glyph has no ink, and
+ * only its increment counts towards the font metrics.
+ */
+struct GlyphMetrics
+{
+    GlyphMetrics(): increment( 0 ), ascent( 0 ), descent( 0 ),
+                    leftBearing( 0 ), rightBearing( 0 ), blank( true ) {}
+
+    static GlyphMetrics measure( const GlyphBitmap &bitmap, int baseLine );
+
+    qint16  increment;
+    qint16  ascent;
+    qint16  descent;
+    qint16  leftBearing;
+    qint16  rightBearing;
+    bool    blank;
+};
+
+
+/* Keeps the font-wide maxima, minima and sums over all glyph metrics in a
+ * segment tree, so that changing one glyph costs O(log n) and every
+ * font-wide value can be read in constant time.
+ */
+class FontMetricsIndex
+{
+public:
+    FontMetricsIndex();
+
+    void    reset( const QVector<GlyphMetrics> &all );
+    void    update( int index, const GlyphMetrics &metrics );
+
+    int     count() const { return leaves.size(); }
+    const GlyphMetrics &glyph( int index ) const { return leaves.at( index ); }
+
+    int     maxIncrement() const;
+    int     minIncrement() const;
+    int     averageIncrement() const;
+    int     maxAscender() const;
+    int     maxDescender() const;
+    int     maxBaselineExtent() const { return maxAscender() + maxDescender(); }
+    int     minLeftBearing() const;
+    int     minRightBearing() const;
+    int     inkedGlyphs() const;
+
+private:
+    struct Node {
+        qint16  maxIncrement;
+        qint16  minIncrement;
+        qint16  maxAscent;
+        qint16  maxDescent;
+        qint16  minLeftBearing;
+        qint16  minRightBearing;
+        qint32  inked;
+        qint64  sumIncrement;
+    };
+
+    static Node leafNode( const GlyphMetrics &metrics );
+    static Node mergeNodes( const Node &a, const Node &b );
+
+    QVector<GlyphMetrics> leaves;
+    QVector<Node>         tree;      // leaf i is at tree[ size + i ], root at tree[ 1 ]
+    int                   size;
+};
+
+#endif  // METRICSINDEX_H
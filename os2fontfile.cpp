@@ -0,0 +1,366 @@
+/******************************************************************************
+** os2fontfile.cpp
+**
+** Reading and writing OS/2 bitmap font files.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QHash>
+#include <QtEndian>
+
+#include "fontdocument.h"
+#include "os2fontfile.h"
+
+// Record identities
+#define FONT_SIGNATURE_ID       0xFFFFFFFE
+#define FONT_METRICS_ID         0x00000001
+#define FONT_DEFINITION_ID      0x00000002
+#define FONT_KERNPAIRS_ID       0x00000003
+#define FONT_END_ID             0xFFFFFFFF
+
+#define FONT_SIGNATURE          "OS/2 FONT"
+
+// Record sizes, as written
+#define SIGNATURE_SIZE          20
+#define METRICS_SIZE            168
+#define DEFINITION_SIZE         28
+#define END_SIZE                8
+#define KERNPAIRS_HEADER_SIZE   8
+#define KERNPAIR_SIZE           6
+
+// FONTDEFINITIONHEADER flags
+#define FONTDEF_WIDTH           0x0001      // xCellWidth applies to every character
+#define FONTDEFFONT2            0x0042
+#define FONTDEFCHAR2            0x0081
+#define FONTDEFCHAR3            0x00B8
+
+// FOCAMETRICS fsTypeFlags
+#define FM_TYPE_FIXED           0x0001
+
+// Offsets of the FOCAMETRICS fields we use
+#define FM_FAMILYNAME           8
+#define FM_FACENAME             40
+#define FM_CODEPAGE             74
+#define FM_FIRSTCHAR            114
+#define FM_LASTCHAR             116
+#define FM_NOMINALPOINTSIZE     122
+#define FM_KERNINGPAIRS         160
+
+// Offsets of the FONTDEFINITIONHEADER fields
+#define FD_FONTDEF              8
+#define FD_CHARDEF              10
+#define FD_CELLSIZE             12
+#define FD_CELLWIDTH            14
+#define FD_CELLHEIGHT           16
+#define FD_CELLBASEOFFSET       26
+
+#define NAME_LENGTH             32
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static inline quint16 readWord( const uchar *p )  { return qFromLittleEndian<quint16>( p ); }
+static inline quint32 readLong( const uchar *p )  { return qFromLittleEndian<quint32>( p ); }
+
+static QString readName( const uchar *p )
+{
+    return QString::fromLatin1( (const char *) p, qstrnlen( (const char *) p, NAME_LENGTH ));
+}
+
+/* The kerning pair table has no fixed place; it follows the glyph data,
+ * wherever that ends.  Look for its header from the end of the last glyph
+ * image, stepping over any padding, and check the size against the number
+ * of pairs expected.
+ */
+static QVector<KerningPair> readKerningPairs( const uchar *data, qint64 size, qint64 start, int count )
+{
+    QVector<KerningPair> pairs;
+    quint32 expected = KERNPAIRS_HEADER_SIZE + count * KERNPAIR_SIZE;
+    for ( qint64 p = start; p + expected <= size; p++ ) {
+        if ( readLong( data + p ) != FONT_KERNPAIRS_ID || readLong( data + p + 4 ) != expected )
+            continue;
+        const uchar *pk = data + p + KERNPAIRS_HEADER_SIZE;
+        pairs.resize( count );
+        for ( int i = 0; i < count; i++, pk += KERNPAIR_SIZE ) {
+            pairs[ i ].first  = readWord( pk );
+            pairs[ i ].second = readWord( pk + 2 );
+            pairs[ i ].amount = (qint16) readWord( pk + 4 );
+        }
+        break;
+    }
+    return pairs;
+}
+
+
+static void writeName( QDataStream &out, const QString &name, int length )
+{
+    QByteArray field = name.toLatin1().left( length - 1 );
+    field.append( QByteArray( length - field.size(), '\0' ));
+    out.writeRawData( field.constData(), length );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+OS2FontFile::OS2FontFile( const uchar *data, qint64 size ): FontFileReader( data, size )
+{
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+bool OS2FontFile::recognize( const uchar *data, qint64 size )
+{
+    return ( size >= SIGNATURE_SIZE ) &&
+           ( readLong( data ) == FONT_SIGNATURE_ID ) &&
+           ( qstrncmp( (const char *) data + 8, FONT_SIGNATURE, sizeof( FONT_SIGNATURE ) - 1 ) == 0 );
+}
+
+
+/* Read the metrics and the character definitions.  The glyph images are
+ * left alone until they are asked for.
+ */
+bool OS2FontFile::parse()
+{
+    if ( !recognize( pData, llSize )) {
+        strError = QCoreApplication::translate("OS2FontFile", "This is not an OS/2 font file.");
+        return false;
+    }
+
+    qint64 metrics = readLong( pData + 4 );
+    if (( metrics + METRICS_SIZE > llSize ) || ( readLong( pData + metrics ) != FONT_METRICS_ID )) {
+        strError = QCoreApplication::translate("OS2FontFile", "The font metrics are missing or damaged.");
+        return false;
+    }
+    const uchar *pm = pData + metrics;
+
+    qint64 definition = metrics + readLong( pm + 4 );
+    if (( definition + DEFINITION_SIZE > llSize ) || ( readLong( pData + definition ) != FONT_DEFINITION_ID )) {
+        strError = QCoreApplication::translate("OS2FontFile", "The font definition header is missing or damaged.");
+        return false;
+    }
+    const uchar *pd = pData + definition;
+
+    int     count    = readWord( pm + FM_LASTCHAR ) + 1;
+    int     cellSize = readWord( pd + FD_CELLSIZE );
+    quint16 fontDef  = readWord( pd + FD_FONTDEF );
+    bool    type3    = (( readWord( pd + FD_CHARDEF ) & FONTDEFCHAR3 ) == FONTDEFCHAR3 ) && ( cellSize >= 10 );
+    qint64  table    = definition + readLong( pd + 4 );
+
+    if (( cellSize < 6 ) || ( table + (qint64) count * cellSize > llSize )) {
+        strError = QCoreApplication::translate("OS2FontFile", "The character definitions are damaged.");
+        return false;
+    }
+
+    // The kerning pairs, if any, follow the last glyph image
+    qint64 imagesEnd = table + (qint64) count * cellSize;
+
+    chars.resize( count );
+    for ( int i = 0; i < count; i++ ) {
+        const uchar *pc = pData + table + (qint64) i * cellSize;
+        CharDef &def = chars[ i ];
+        def.offset = readLong( pc );
+        if ( type3 ) {
+            def.aSpace = (qint16) readWord( pc + 4 );
+            def.width  = readWord( pc + 6 );
+            def.cSpace = (qint16) readWord( pc + 8 );
+        }
+        else {
+            def.aSpace = 0;
+            def.width  = ( fontDef & FONTDEF_WIDTH )? readWord( pd + FD_CELLWIDTH ): readWord( pc + 4 );
+            def.cSpace = 0;
+        }
+        qint64 end = (qint64) def.offset + (qint64)(( def.width + 7 ) / 8 ) * readWord( pd + FD_CELLHEIGHT );
+        if ( def.width && end <= llSize && end > imagesEnd )
+            imagesEnd = end;
+    }
+
+    fontInfo.familyName = readName( pm + FM_FAMILYNAME );
+    fontInfo.faceName   = readName( pm + FM_FACENAME );
+    fontInfo.codePage   = readWord( pm + FM_CODEPAGE );
+    fontInfo.pointSize  = readWord( pm + FM_NOMINALPOINTSIZE ) / 10;
+    fontInfo.firstChar  = readWord( pm + FM_FIRSTCHAR );
+    fontInfo.glyphCount = count;
+    fontInfo.cellHeight = readWord( pd + FD_CELLHEIGHT );
+    fontInfo.baseLine   = qMax( 0, fontInfo.cellHeight - (int) readWord( pd + FD_CELLBASEOFFSET ));
+
+    int kerningPairs = readWord( pm + FM_KERNINGPAIRS );
+    if ( kerningPairs )
+        fontInfo.kerningPairs = readKerningPairs( pData, llSize, imagesEnd, kerningPairs );
+    return true;
+}
+
+
+/* The width of a glyph as we store it, i.e. its increment.  For a type 3
+ * font this includes any positive A and C space.
+ */
+int OS2FontFile::glyphWidth( int index ) const
+{
+    if ( index < 0 || index >= chars.size() )
+        return 0;
+    const CharDef &def = chars.at( index );
+    return qMax( 1, qMax( 0, (int) def.aSpace ) + def.width + qMax( 0, (int) def.cSpace ));
+}
+
+
+/* Decode one glyph image.  Images which fall outside the file are returned
+ * blank.  Negative A or C space cannot be represented, so overhanging ink
+ * is kept inside the cell.
+ */
+GlyphBitmap OS2FontFile::glyph( int index ) const
+{
+    if ( index < 0 || index >= chars.size() )
+        return GlyphBitmap();
+
+    const CharDef &def = chars.at( index );
+    int    height = fontInfo.cellHeight;
+    int    width  = glyphWidth( index );
+    qint64 bytes  = (qint64)(( def.width + 7 ) / 8 ) * height;
+
+    if ( !def.width || ( (qint64) def.offset + bytes > llSize ))
+        return GlyphBitmap( width, height );
+
+    GlyphBitmap image = GlyphBitmap::fromByteColumns( pData + def.offset, def.width, height );
+    if ( width == def.width )
+        return image;
+
+    GlyphBitmap cell( width, height );
+    cell.blit( QPoint( qMax( 0, (int) def.aSpace ), 0 ), image, GlyphBitmap::Copy );
+    return cell;
+}
+
+
+/* Write a font as a type 2 (proportional) OS/2 font file.  The metrics are
+ * taken from the document's metrics index; identical glyphs share a single
+ * glyph image.  Any kerning pairs follow the glyph images, sorted.
+ */
+QByteArray OS2FontFile::write( const FontDocument *document )
+{
+    const FontMetricsIndex &metrics = document->metrics();
+
+    int count    = document->glyphCount();
+    int height   = document->cellHeight();
+    int baseLine = document->baseLine();
+    int first    = document->firstChar();
+    int points   = document->pointSize() * 10;
+
+    // Lay out the glyph images after the character definitions
+    quint32 imageBase = SIGNATURE_SIZE + METRICS_SIZE + DEFINITION_SIZE + count * 6;
+    QVector<quint32> offsets( count );
+    QVector<quint16> widths( count );
+    QHash<GlyphBitmap, quint32> written;
+    QByteArray images;
+
+    for ( int i = 0; i < count; i++ ) {
+        GlyphBitmap glyph = document->decodeGlyph( i );
+        if ( glyph.height() != height )
+            glyph = glyph.copy( QRect( 0, 0, glyph.width(), height ));
+        widths[ i ] = glyph.width();
+
+        QHash<GlyphBitmap, quint32>::const_iterator found = written.constFind( glyph );
+        if ( found != written.constEnd() )
+            offsets[ i ] = found.value();
+        else {
+            offsets[ i ] = imageBase + images.size();
+            written.insert( glyph, offsets[ i ] );
+            images.append( glyph.toByteColumns() );
+        }
+    }
+
+    int xHeight    = ( 'x' >= first && 'x' - first < count )? metrics.glyph( 'x' - first ).ascent: 0;
+    int defaultChar = ( '?' >= first && '?' - first < count )? '?' - first: 0;
+    int breakChar   = ( ' ' >= first && ' ' - first < count )? ' ' - first: 0;
+
+    // The pair count is only a USHORT
+    QVector<KerningPair> kerning = document->kerning().sorted();
+    if ( kerning.size() > 0xFFFF )
+        kerning.resize( 0xFFFF );
+
+    QByteArray data;
+    QDataStream out( &data, QIODevice::WriteOnly );
+    out.setByteOrder( QDataStream::LittleEndian );
+
+    // Font signature
+    out << (quint32) FONT_SIGNATURE_ID << (quint32) SIGNATURE_SIZE;
+    writeName( out, FONT_SIGNATURE, 12 );
+
+    // FOCAMETRICS
+    out << (quint32) FONT_METRICS_ID << (quint32) METRICS_SIZE;
+    writeName( out, document->familyName(), NAME_LENGTH );
+    writeName( out, document->faceName(), NAME_LENGTH );
+    out << (qint16) 0                                   // usRegistryId
+        << (qint16) document->codePage()
+        << (qint16) height                              // yEmHeight
+        << (qint16) xHeight
+        << (qint16)( height - baseLine )                // yMaxAscender
+        << (qint16) baseLine                            // yMaxDescender
+        << (qint16) metrics.maxAscender()               // yLowerCaseAscent
+        << (qint16) metrics.maxDescender()              // yLowerCaseDescent
+        << (qint16) 0 << (qint16) 0                     // yInternalLeading, yExternalLeading
+        << (qint16) metrics.averageIncrement()          // xAveCharWidth
+        << (qint16) metrics.maxIncrement()              // xMaxCharInc
+        << (qint16) metrics.maxIncrement()              // xEmInc
+        << (qint16) height                              // yMaxBaselineExt
+        << (qint16) 0 << (qint16) 0 << (qint16) 0       // sCharSlope, sInlineDir, sCharRot
+        << (quint16) 5 << (quint16) 5                   // usWeightClass, usWidthClass (medium, normal)
+        << (qint16) 96 << (qint16) 96                   // xDeviceRes, yDeviceRes
+        << (qint16) first
+        << (qint16)( count - 1 )                        // usLastChar, as an offset from usFirstChar
+        << (qint16) defaultChar << (qint16) breakChar
+        << (qint16) points << (qint16) points << (qint16) points
+        << (qint16)(( metrics.minIncrement() == metrics.maxIncrement() )? FM_TYPE_FIXED: 0 )
+        << (qint16) 0 << (qint16) 0 << (qint16) 0;      // fsDefn, fsSelectionFlags, fsCapabilities
+    for ( int i = 0; i < 8; i++ )                       // subscript and superscript sizes and offsets
+        out << (qint16) 0;
+    out << (qint16) 1 << (qint16) 1                     // yUnderscoreSize, yUnderscorePosition
+        << (qint16) 1 << (qint16)( xHeight / 2 )        // yStrikeoutSize, yStrikeoutPosition
+        << (quint16) kerning.size()                     // usKerningPairs
+        << (qint16) 0                                   // sFamilyClass
+        << (quint32) 0;                                 // pszDeviceNameOffset
+
+    // FONTDEFINITIONHEADER and character definitions
+    out << (quint32) FONT_DEFINITION_ID << (quint32) DEFINITION_SIZE
+        << (qint16) FONTDEFFONT2 << (qint16) FONTDEFCHAR2
+        << (qint16) 6                                   // usCellSize
+        << (qint16) metrics.maxIncrement()              // xCellWidth
+        << (qint16) height                              // yCellHeight
+        << (qint16) 0 << (qint16) 0 << (qint16) 0 << (qint16) 0
+        << (qint16)( height - baseLine );               // pCellBaseOffset
+    for ( int i = 0; i < count; i++ )
+        out << offsets.at( i ) << widths.at( i );
+
+    out.writeRawData( images.constData(), images.size() );
+
+    if ( !kerning.isEmpty() ) {
+        out << (quint32) FONT_KERNPAIRS_ID << (quint32)( KERNPAIRS_HEADER_SIZE + kerning.size() * KERNPAIR_SIZE );
+        for ( int i = 0; i < kerning.size(); i++ )
+            out << kerning.at( i ).first << kerning.at( i ).second << kerning.at( i ).amount;
+    }
+
+    out << (quint32) FONT_END_ID << (quint32) END_SIZE;
+    return data;
+}
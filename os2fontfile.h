@@ -0,0 +1,64 @@
+/******************************************************************************
+** os2fontfile.h
+**
+** Reading and writing OS/2 bitmap font files.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef OS2FONTFILE_H
+#define OS2FONTFILE_H
+
+#include <QByteArray>
+#include <QVector>
+
+#include "fontfile.h"
+
+class FontDocument;
+
+
+/* An OS/2 font file (or font resource) is a sequence of records, each
+ * starting with a ULONG identity and a ULONG size: the font signature, the
+ * FOCAMETRICS, and the FONTDEFINITIONHEADER followed by the character
+ * definitions and glyph images, then optional records up to the end
+ * signature.  All values are little-endian.
+ */
+class OS2FontFile : public FontFileReader
+{
+public:
+    OS2FontFile( const uchar *data, qint64 size );
+
+    bool        parse();
+    int         glyphWidth( int index ) const;
+    GlyphBitmap glyph( int index ) const;
+
+    static bool       recognize( const uchar *data, qint64 size );
+    static QByteArray write( const FontDocument *document );
+
+private:
+    struct CharDef {
+        quint32 offset;         // of the glyph image, from the start of the font
+        qint16  aSpace;         // blank columns before the image (type 3 only)
+        quint16 width;          // width of the image
+        qint16  cSpace;         // blank columns after the image (type 3 only)
+    };
+
+    QVector<CharDef> chars;
+};
+
+#endif  // OS2FONTFILE_H
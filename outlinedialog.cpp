@@ -0,0 +1,134 @@
+/******************************************************************************
+** outlinedialog.cpp
+**
+** Dialog for creating a new bitmap font from an outline font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "outlinedialog.h"
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+OutlineFontDialog::OutlineFontDialog( const QString &directory, QWidget *parent ): QDialog( parent )
+{
+    strDirectory = directory;
+
+    fileEdit = new QLineEdit();
+    QPushButton *browseButton = new QPushButton( tr("&Browse...") );
+    connect( browseButton, SIGNAL( clicked() ), this, SLOT( browse() ));
+
+    sizeSpin = new QSpinBox();
+    sizeSpin->setRange( 4, 256 );
+    sizeSpin->setValue( 16 );
+    sizeSpin->setSuffix( tr(" pixels") );
+
+    // Code points are entered in hexadecimal, as in the Unicode charts
+    QRegExpValidator *validator = new QRegExpValidator( QRegExp("[0-9A-Fa-f]{1,6}"), this );
+    firstEdit = new QLineEdit("0020");
+    firstEdit->setValidator( validator );
+    lastEdit = new QLineEdit("00FF");
+    lastEdit->setValidator( validator );
+
+    buttons = new QDialogButtonBox( QDialogButtonBox::Ok | QDialogButtonBox::Cancel );
+    connect( buttons, SIGNAL( accepted() ), this, SLOT( accept() ));
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( reject() ));
+
+    connect( fileEdit,  SIGNAL( textChanged( const QString & )), this, SLOT( validate() ));
+    connect( firstEdit, SIGNAL( textChanged( const QString & )), this, SLOT( validate() ));
+    connect( lastEdit,  SIGNAL( textChanged( const QString & )), this, SLOT( validate() ));
+
+    QLabel *fileLabel = new QLabel( tr("&Outline font:") );
+    fileLabel->setBuddy( fileEdit );
+    QLabel *sizeLabel = new QLabel( tr("&Size:") );
+    sizeLabel->setBuddy( sizeSpin );
+    QLabel *rangeLabel = new QLabel( tr("&Characters (hex):") );
+    rangeLabel->setBuddy( firstEdit );
+
+    QGridLayout *layout = new QGridLayout();
+    layout->addWidget( fileLabel, 0, 0 );
+    layout->addWidget( fileEdit, 0, 1, 1, 2 );
+    layout->addWidget( browseButton, 0, 3 );
+    layout->addWidget( sizeLabel, 1, 0 );
+    layout->addWidget( sizeSpin, 1, 1 );
+    layout->addWidget( rangeLabel, 2, 0 );
+    layout->addWidget( firstEdit, 2, 1 );
+    layout->addWidget( new QLabel( tr("to") ), 2, 2, Qt::AlignHCenter );
+    layout->addWidget( lastEdit, 2, 3 );
+    layout->addWidget( buttons, 3, 0, 1, 4 );
+    setLayout( layout );
+
+    setWindowTitle( tr("New from Outline Font") );
+    validate();
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+QString OutlineFontDialog::fileName() const
+{
+    return fileEdit->text();
+}
+
+
+int OutlineFontDialog::pixelSize() const
+{
+    return sizeSpin->value();
+}
+
+
+uint OutlineFontDialog::firstChar() const
+{
+    return firstEdit->text().toUInt( 0, 16 );
+}
+
+
+uint OutlineFontDialog::lastChar() const
+{
+    return lastEdit->text().toUInt( 0, 16 );
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void OutlineFontDialog::browse()
+{
+    QString fileName = QFileDialog::getOpenFileName( this, tr("Select Outline Font"), strDirectory,
+                                                     tr("Outline fonts (*.ttf *.otf *.ttc *.otc *.pfb *.pfa);;"
+                                                        "All files (*)") );
+    if ( !fileName.isEmpty() )
+        fileEdit->setText( QDir::toNativeSeparators( fileName ));
+}
+
+
+void OutlineFontDialog::validate()
+{
+    bool ok = !fileEdit->text().isEmpty() &&
+              !firstEdit->text().isEmpty() && !lastEdit->text().isEmpty() &&
+              firstChar() <= lastChar() && lastChar() <= 0x10FFFF;
+    buttons->button( QDialogButtonBox::Ok )->setEnabled( ok );
+}
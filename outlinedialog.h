@@ -0,0 +1,60 @@
+/******************************************************************************
+** outlinedialog.h
+**
+** Dialog for creating a new bitmap font from an outline font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef OUTLINEDIALOG_H
+#define OUTLINEDIALOG_H
+
+#include <QDialog>
+
+class QDialogButtonBox;
+class QLineEdit;
+class QSpinBox;
+
+
+class OutlineFontDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    OutlineFontDialog( const QString &directory, QWidget *parent = 0 );
+
+    QString fileName() const;
+    int     pixelSize() const;
+    uint    firstChar() const;
+    uint    lastChar() const;
+
+private slots:
+    void browse();
+    void validate();
+
+private:
+    QLineEdit        *fileEdit;
+    QSpinBox         *sizeSpin;
+    QLineEdit        *firstEdit;
+    QLineEdit        *lastEdit;
+    QDialogButtonBox *buttons;
+
+    QString strDirectory;
+};
+
+#endif  // OUTLINEDIALOG_H
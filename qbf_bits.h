@@ -0,0 +1,142 @@
+/******************************************************************************
+** qbf_bits.h
+**
+** Small bit-manipulation helpers used by the packed glyph bitmap code.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef QBF_BITS_H
+#define QBF_BITS_H
+
+#include <QtGlobal>
+
+/* Glyph rows are packed into 32-bit words with the leftmost pixel in the
+ * most significant bit, so that a word's byte order matches the MSB-first
+ * byte layout used by the font formats.
+ */
+
+#define QBF_WORD_BITS   32
+
+inline quint32 qbfPixelBit( int x )
+{
+    return 0x80000000u >> ( x & 31 );
+}
+
+inline int qbfWordsForWidth( int width )
+{
+    return ( width + 31 ) >> 5;
+}
+
+// Number of leading (leftmost) zero bits; value must be non-zero.
+inline int qbfLeadingZeros( quint32 value )
+{
+#if defined( __GNUC__ )
+    return __builtin_clz( value );
+#else
+    int n = 0;
+    while ( !( value & 0x80000000u )) { value <<= 1; n++; }
+    return n;
+#endif
+}
+
+// Number of trailing (rightmost) zero bits; value must be non-zero.
+inline int qbfTrailingZeros( quint32 value )
+{
+#if defined( __GNUC__ )
+    return __builtin_ctz( value );
+#else
+    int n = 0;
+    while ( !( value & 1 )) { value >>= 1; n++; }
+    return n;
+#endif
+}
+
+inline int qbfPopCount( quint32 value )
+{
+#if defined( __GNUC__ )
+    return __builtin_popcount( value );
+#else
+    value = value - (( value >> 1 ) & 0x55555555u );
+    value = ( value & 0x33333333u ) + (( value >> 2 ) & 0x33333333u );
+    return ((( value + ( value >> 4 )) & 0x0F0F0F0Fu ) * 0x01010101u ) >> 24;
+#endif
+}
+
+inline quint32 qbfReverseBits( quint32 value )
+{
+    value = (( value >> 1 ) & 0x55555555u ) | (( value & 0x55555555u ) << 1 );
+    value = (( value >> 2 ) & 0x33333333u ) | (( value & 0x33333333u ) << 2 );
+    value = (( value >> 4 ) & 0x0F0F0F0Fu ) | (( value & 0x0F0F0F0Fu ) << 4 );
+    value = (( value >> 8 ) & 0x00FF00FFu ) | (( value & 0x00FF00FFu ) << 8 );
+    return ( value >> 16 ) | ( value << 16 );
+}
+
+/* Transpose the 4x4 matrix of bytes held in four words, most significant
+ * byte first: afterwards byte i of word j holds what was byte j of word i.
+ * This turns four rows of 32 pixels into four byte-wide strips of four rows
+ * each, and back again.
+ */
+inline void qbfTransposeBytes( quint32 &w0, quint32 &w1, quint32 &w2, quint32 &w3 )
+{
+    quint32 t0 = ( w0 & 0xFFFF0000u ) | ( w2 >> 16 );
+    quint32 t1 = ( w1 & 0xFFFF0000u ) | ( w3 >> 16 );
+    quint32 t2 = ( w0 << 16 ) | ( w2 & 0x0000FFFFu );
+    quint32 t3 = ( w1 << 16 ) | ( w3 & 0x0000FFFFu );
+    w0 = ( t0 & 0xFF00FF00u ) | (( t1 >> 8 ) & 0x00FF00FFu );
+    w1 = (( t0 << 8 ) & 0xFF00FF00u ) | ( t1 & 0x00FF00FFu );
+    w2 = ( t2 & 0xFF00FF00u ) | (( t3 >> 8 ) & 0x00FF00FFu );
+    w3 = (( t2 << 8 ) & 0xFF00FF00u ) | ( t3 & 0x00FF00FFu );
+}
+
+/* Mask of the pixels in [lo, hi) which fall within word number 'word' of a
+ * row.
+ */
+inline quint32 qbfSpanMask( int word, int lo, int hi )
+{
+    int a = qMax( lo - ( word << 5 ), 0 );
+    int b = qMin( hi - ( word << 5 ), 32 );
+    if ( a >= b )
+        return 0;
+    quint32 mask = 0xFFFFFFFFu >> a;
+    if ( b < 32 )
+        mask &= ~( 0xFFFFFFFFu >> b );
+    return mask;
+}
+
+/* Fetch the 32 pixels starting at pixel position 'pos' of a packed row
+ * which is 'words' words long.  Positions outside the row read as zero.
+ */
+inline quint32 qbfFetchBits( const quint32 *row, int words, int pos )
+{
+    if ( pos < 0 ) {
+        if ( pos <= -32 )
+            return 0;
+        return qbfFetchBits( row, words, 0 ) >> ( -pos );
+    }
+    int w = pos >> 5;
+    int s = pos & 31;
+    if ( w >= words )
+        return 0;
+    quint32 value = row[ w ] << s;
+    if ( s && ( w + 1 < words ))
+        value |= row[ w + 1 ] >> ( 32 - s );
+    return value;
+}
+
+#endif  // QBF_BITS_H
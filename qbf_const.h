@@ -1,15 +1,15 @@
-#ifndef QBF_CONST_H
-#define QBF_CONST_H
-
-#define PROGRAM_AUTHOR      "Alexander Taylor"
-#define PROGRAM_COPYRIGHT   "2023"
-#define PROGRAM_VERSION     "0.0.1"
-
-#define SETTINGS_VENDOR     "ATutils"
-#define SETTINGS_APP        "QBFont Editor"
-
-#define HELP_PANEL_GENERAL  1
-#define HELP_PANEL_KEYS     2
-
-#endif  // QBF_CONST_H
-
+#ifndef QBF_CONST_H
+#define QBF_CONST_H
+
+#define PROGRAM_AUTHOR      "Alexander Taylor"
+#define PROGRAM_COPYRIGHT   "2023"
+#define PROGRAM_VERSION     "0.0.1"
+
+#define SETTINGS_VENDOR     "ATutils"
+#define SETTINGS_APP        "QBFont Editor"
+
+#define HELP_PANEL_GENERAL  1
+#define HELP_PANEL_KEYS     2
+
+#endif  // QBF_CONST_H
+
@@ -1,30 +1,37 @@
-######################################################################
-# Automatically generated by qmake (2.01a) Thu Jul 20 08:15:03 2023
-######################################################################
-# CONFIG += debug console
-CONFIG += map
-
-# BLDLEVEL signature (OS/2 only)
-BL_DEPS = qbf_const.h
-os2:bldlevel.input = BL_DEPS
-os2:bldlevel.output = qbfont.def
-os2:bldlevel.commands = makebl.cmd -DQBFont -N!Alex Taylor! -V!$${LITERAL_HASH}define=PROGRAM_VERSION,qbf_const.h! qbfont.def
-os2:bldlevel.name = running makedesc ...
-os2:bldlevel.CONFIG += target_predeps
-os2:QMAKE_EXTRA_COMPILERS = bldlevel
-
-TEMPLATE = app
-TARGET =
-DEPENDPATH += .
-INCLUDEPATH += .
-os2:QMAKE_CFLAGS   = -Zomf -march=i686 -Wno-pointer-sign
-os2:QMAKE_CXXFLAGS = -Zomf -march=i686 -Wno-unused-local-typedefs -Wno-literal-suffix -D OS2EMX_PLAIN_CHAR
-
-# Input
-HEADERS += glypheditor.h glyphstatus.h mainwindow.h qbf_const.h
-SOURCES += glypheditor.cpp glyphstatus.cpp main.cpp mainwindow.cpp
-RESOURCES += qbfont.qrc
-os2:HEADERS += os2native.h
-os2:SOURCES += os2native.cpp
-# os2:RC_FILE = qbfont.rc
-# win32:RC_FILE = qbfont_win.rc
+######################################################################
+# Automatically generated by qmake (2.01a) Thu Jul 20 08:15:03 2023
+######################################################################
+# CONFIG += debug console
+CONFIG += map
+
+# BLDLEVEL signature (OS/2 only)
+BL_DEPS = qbf_const.h
+os2:bldlevel.input = BL_DEPS
+os2:bldlevel.output = qbfont.def
+os2:bldlevel.commands = makebl.cmd -DQBFont -N!Alex Taylor! -V!$${LITERAL_HASH}define=PROGRAM_VERSION,qbf_const.h! qbfont.def
+os2:bldlevel.name = running makedesc ...
+os2:bldlevel.CONFIG += target_predeps
+os2:QMAKE_EXTRA_COMPILERS = bldlevel
+
+TEMPLATE = app
+TARGET =
+DEPENDPATH += .
+INCLUDEPATH += .
+os2:QMAKE_CFLAGS   = -Zomf -march=i686 -Wno-pointer-sign
+os2:QMAKE_CXXFLAGS = -Zomf -march=i686 -Wno-unused-local-typedefs -Wno-literal-suffix -D OS2EMX_PLAIN_CHAR
+
+# Input
+HEADERS += atlasdialog.h changescheduler.h codepagecoverage.h codepageremap.h coveragedialog.h familyview.h fitdialog.h fontdocument.h fontfamily.h fontfile.h fontheader.h fontloader.h fontmodule.h fontrasterizer.h glyphatlas.h glyphbitmap.h glyphclipboard.h glyphcommand.h glypheditor.h glyphfitter.h glyphfinder.h glyphlookup.h glyphnames.h glyphoverview.h glyphpool.h glyphscaler.h glyphsimilarity.h glyphstore.h glyphstyler.h glyphstatus.h headerdialog.h kerningdialog.h kerningpreview.h kerningtable.h mainwindow.h metricsindex.h os2fontfile.h outlinedialog.h qbf_bits.h qbf_const.h recentfiles.h similardialog.h styledialog.h variantsdialog.h winfontfile.h
+SOURCES += atlasdialog.cpp changescheduler.cpp codepagecoverage.cpp codepageremap.cpp coveragedialog.cpp familyview.cpp fitdialog.cpp fontdocument.cpp fontfamily.cpp fontfile.cpp fontheader.cpp fontloader.cpp fontmodule.cpp fontrasterizer.cpp glyphatlas.cpp glyphbitmap.cpp glyphclipboard.cpp glyphcommand.cpp glypheditor.cpp glyphfitter.cpp glyphfinder.cpp glyphlookup.cpp glyphnames.cpp glyphoverview.cpp glyphpool.cpp glyphscaler.cpp glyphsimilarity.cpp glyphstore.cpp glyphstyler.cpp glyphstatus.cpp headerdialog.cpp kerningdialog.cpp kerningpreview.cpp kerningtable.cpp main.cpp mainwindow.cpp metricsindex.cpp os2fontfile.cpp outlinedialog.cpp recentfiles.cpp similardialog.cpp styledialog.cpp variantsdialog.cpp winfontfile.cpp
+RESOURCES += qbfont.qrc
+
+# FreeType is used to render outline fonts
+unix:CONFIG += link_pkgconfig
+unix:PKGCONFIG += freetype2
+os2:INCLUDEPATH += $$(FREETYPE_INCLUDE)
+os2:LIBS += -lfreetype
+win32:LIBS += -lfreetype
+os2:HEADERS += os2native.h
+os2:SOURCES += os2native.cpp
+# os2:RC_FILE = qbfont.rc
+# win32:RC_FILE = qbfont_win.rc
@@ -0,0 +1,298 @@
+/******************************************************************************
+** recentfiles.cpp
+**
+** The list of recently used files, checked in the background.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureInterface>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QTimer>
+
+#include "recentfiles.h"
+
+// How long to wait for a file check before calling the file not responding
+#define RECENT_CHECK_TIMEOUT    3000
+
+// Most file checks to run at once, for all windows together
+#define RECENT_CHECK_THREADS    2
+
+
+// ---------------------------------------------------------------------------
+// Check a file.  This runs on a worker thread, and may block for as long as
+// the file system takes to answer.
+//
+static RecentFileProbe probeFile( const QString &fileName )
+{
+    RecentFileProbe probe;
+    QFileInfo info( fileName );
+
+    probe.exists = info.exists() && info.isFile();
+    if ( probe.exists ) {
+        probe.size     = info.size();
+        probe.modified = info.lastModified();
+    }
+    return probe;
+}
+
+
+// ---------------------------------------------------------------------------
+// Runs probeFile() on the pool below, reporting through a QFuture as
+// QtConcurrent::run() would.
+//
+class ProbeTask : public QRunnable
+{
+public:
+    ProbeTask( const QString &fileName ): path( fileName ) {}
+
+    QFuture<RecentFileProbe> start( QThreadPool *pool )
+    {
+        result.setRunnable( this );
+        result.reportStarted();
+        QFuture<RecentFileProbe> future = result.future();
+        pool->start( this );
+        return future;
+    }
+
+    void run()
+    {
+        RecentFileProbe probe = probeFile( path );
+        result.reportResult( probe );
+        result.reportFinished();
+    }
+
+private:
+    QString                           path;
+    QFutureInterface<RecentFileProbe> result;
+};
+
+
+// ---------------------------------------------------------------------------
+// File checks get their own few threads, so that checks hung on a network
+// share cannot hold up work on the global pool.  The pool is never deleted,
+// as that would wait for any hung check on exit.
+//
+static QThreadPool *probePool()
+{
+    static QThreadPool *pool = 0;
+    if ( !pool ) {
+        pool = new QThreadPool();
+        pool->setMaxThreadCount( RECENT_CHECK_THREADS );
+    }
+    return pool;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+RecentFiles::RecentFiles( int maximum, QObject *parent ): QObject( parent )
+{
+    iMaximum = maximum;
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+QStringList RecentFiles::files() const
+{
+    QStringList list;
+    for ( int i = 0; i < entries.size(); i++ )
+        list << entries.at( i ).path;
+    return list;
+}
+
+
+/* Replace the list (e.g. from the saved settings) and check every file.
+ */
+void RecentFiles::setFiles( const QStringList &fileNames )
+{
+    entries.clear();
+    for ( int i = 0; i < fileNames.size() && entries.size() < iMaximum; i++ ) {
+        if ( fileNames.at( i ).isEmpty() || indexOf( fileNames.at( i )) >= 0 )
+            continue;
+        Entry entry;
+        entry.path   = fileNames.at( i );
+        entry.status = Unchecked;
+        entry.size   = 0;
+        entries.append( entry );
+    }
+    emit changed();
+    refresh();
+}
+
+
+/* Move a file to the top of the list.  The file has just been opened or
+ * saved, so it is known to be available.
+ */
+void RecentFiles::add( const QString &fileName )
+{
+    int i = indexOf( fileName );
+    Entry entry;
+    if ( i >= 0 )
+        entry = entries.takeAt( i );
+    else {
+        entry.path = fileName;
+        entry.size = 0;
+    }
+    entry.status = Available;
+    entries.prepend( entry );
+    while ( entries.size() > iMaximum )
+        entries.removeLast();
+
+    emit changed();
+    startCheck( fileName );     // to pick up the size and time
+}
+
+
+void RecentFiles::clear()
+{
+    entries.clear();
+    emit changed();
+}
+
+
+/* Check all files again, e.g. when the menu listing them is about to be
+ * shown.  Files which are still being checked are left alone.
+ */
+void RecentFiles::refresh()
+{
+    for ( int i = 0; i < entries.size(); i++ )
+        startCheck( entries.at( i ).path );
+}
+
+
+RecentFiles::Status RecentFiles::status( const QString &fileName ) const
+{
+    int i = indexOf( fileName );
+    return ( i >= 0 )? entries.at( i ).status: Unchecked;
+}
+
+
+/* A description of the file for tooltips and the status bar: its full
+ * path, with its size and time once these are known.
+ */
+QString RecentFiles::description( const QString &fileName ) const
+{
+    int i = indexOf( fileName );
+    if ( i < 0 )
+        return QString();
+
+    const Entry &entry = entries.at( i );
+    QString text = QDir::toNativeSeparators( entry.path );
+    if ( entry.modified.isValid() )
+        text += tr(" (%1 bytes, %2)").arg( entry.size )
+                                     .arg( entry.modified.toString( Qt::DefaultLocaleShortDate ));
+    return text;
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void RecentFiles::checkFinished()
+{
+    for ( int c = 0; c < checks.size(); c++ ) {
+        if ( checks.at( c ).watcher != sender() )
+            continue;
+
+        RecentFileProbe probe = checks.at( c ).watcher->result();
+        int i = indexOf( checks.at( c ).path );
+        endCheck( c );
+
+        if ( i >= 0 ) {
+            if ( probe.exists ) {
+                entries[ i ].status   = Available;
+                entries[ i ].size     = probe.size;
+                entries[ i ].modified = probe.modified;
+            }
+            else
+                entries.removeAt( i );
+            emit changed();
+        }
+        return;
+    }
+}
+
+
+/* The check is still running, so the file stays in the list, but is marked
+ * as not responding until the check finishes.
+ */
+void RecentFiles::checkTimedOut()
+{
+    for ( int c = 0; c < checks.size(); c++ ) {
+        if ( checks.at( c ).timer != sender() )
+            continue;
+
+        int i = indexOf( checks.at( c ).path );
+        if ( i >= 0 && entries.at( i ).status != NotResponding ) {
+            entries[ i ].status = NotResponding;
+            emit changed();
+        }
+        return;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// PRIVATE METHODS
+//
+
+int RecentFiles::indexOf( const QString &fileName ) const
+{
+    for ( int i = 0; i < entries.size(); i++ )
+        if ( entries.at( i ).path == fileName )
+            return i;
+    return -1;
+}
+
+
+void RecentFiles::startCheck( const QString &fileName )
+{
+    for ( int c = 0; c < checks.size(); c++ )
+        if ( checks.at( c ).path == fileName )
+            return;
+
+    Check check;
+    check.path    = fileName;
+    check.watcher = new QFutureWatcher<RecentFileProbe>( this );
+    check.timer   = new QTimer( this );
+    check.timer->setSingleShot( true );
+    connect( check.watcher, SIGNAL( finished() ), this, SLOT( checkFinished() ));
+    connect( check.timer, SIGNAL( timeout() ), this, SLOT( checkTimedOut() ));
+    checks.append( check );
+
+    check.watcher->setFuture(( new ProbeTask( fileName ))->start( probePool() ));
+    check.timer->start( RECENT_CHECK_TIMEOUT );
+}
+
+
+void RecentFiles::endCheck( int check )
+{
+    checks.at( check ).timer->deleteLater();
+    checks.at( check ).watcher->deleteLater();
+    checks.removeAt( check );
+}
@@ -0,0 +1,109 @@
+/******************************************************************************
+** recentfiles.h
+**
+** The list of recently used files, checked in the background.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef RECENTFILES_H
+#define RECENTFILES_H
+
+#include <QDateTime>
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include <QStringList>
+
+class QTimer;
+
+
+/* Result of checking one file on a worker thread.
+ */
+struct RecentFileProbe
+{
+    RecentFileProbe(): exists( false ), size( 0 ) {}
+
+    bool      exists;
+    qint64    size;
+    QDateTime modified;
+};
+
+
+/* Keeps the most recently used files, most recent first.  Whether each file
+ * still exists is checked on a worker thread, so that files on slow network
+ * shares or missing drives never block the caller; a check which takes too
+ * long marks the file as not responding until it does finish.  Files found
+ * to be missing are dropped from the list.  changed() is emitted whenever
+ * the list or the status of any file changes.
+ */
+class RecentFiles : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Status {
+        Unchecked,
+        Available,
+        NotResponding
+    };
+
+    RecentFiles( int maximum, QObject *parent = 0 );
+
+    QStringList files() const;
+    void        setFiles( const QStringList &fileNames );
+    void        add( const QString &fileName );
+    void        clear();
+
+    Status      status( const QString &fileName ) const;
+    QString     description( const QString &fileName ) const;
+
+public slots:
+    void        refresh();
+
+signals:
+    void changed();
+
+private slots:
+    void checkFinished();
+    void checkTimedOut();
+
+private:
+    struct Entry {
+        QString   path;
+        Status    status;
+        qint64    size;
+        QDateTime modified;
+    };
+
+    struct Check {
+        QString                          path;
+        QFutureWatcher<RecentFileProbe> *watcher;
+        QTimer                          *timer;
+    };
+
+    int  indexOf( const QString &fileName ) const;
+    void startCheck( const QString &fileName );
+    void endCheck( int check );
+
+    QList<Entry> entries;
+    QList<Check> checks;
+    int          iMaximum;
+};
+
+#endif  // RECENTFILES_H
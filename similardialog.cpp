@@ -0,0 +1,123 @@
+/******************************************************************************
+** similardialog.cpp
+**
+** Dialog listing the glyphs which look like the current glyph.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "similardialog.h"
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+SimilarGlyphsDialog::SimilarGlyphsDialog( QWidget *parent ): QDialog( parent )
+{
+    queryLabel = new QLabel();
+
+    distanceSpin = new QSpinBox();
+    distanceSpin->setRange( 0, FINGERPRINT_SIZE * FINGERPRINT_SIZE );
+    distanceSpin->setValue( 32 );
+    distanceSpin->setSuffix( tr(" pixels") );
+
+    countSpin = new QSpinBox();
+    countSpin->setRange( 1, 1000 );
+    countSpin->setValue( 50 );
+
+    QPushButton *searchButton = new QPushButton( tr("&Search") );
+    searchButton->setDefault( true );
+    connect( searchButton, SIGNAL( clicked() ), this, SIGNAL( searchRequested() ));
+
+    resultList = new QListWidget();
+    resultList->setIconSize( QSize( 32, 32 ));
+    connect( resultList, SIGNAL( itemActivated( QListWidgetItem * )),
+             this, SLOT( activateItem( QListWidgetItem * )));
+
+    QDialogButtonBox *buttons = new QDialogButtonBox( QDialogButtonBox::Close );
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( close() ));
+
+    QLabel *distanceLabel = new QLabel( tr("&Differing by at most:") );
+    distanceLabel->setBuddy( distanceSpin );
+    QLabel *countLabel = new QLabel( tr("&Number of glyphs:") );
+    countLabel->setBuddy( countSpin );
+
+    QGridLayout *layout = new QGridLayout();
+    layout->addWidget( queryLabel, 0, 0, 1, 3 );
+    layout->addWidget( distanceLabel, 1, 0 );
+    layout->addWidget( distanceSpin, 1, 1 );
+    layout->addWidget( countLabel, 2, 0 );
+    layout->addWidget( countSpin, 2, 1 );
+    layout->addWidget( searchButton, 2, 2 );
+    layout->addWidget( resultList, 3, 0, 1, 3 );
+    layout->addWidget( buttons, 4, 0, 1, 3 );
+    setLayout( layout );
+
+    setWindowTitle( tr("Find Similar Glyphs") );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+int SimilarGlyphsDialog::maxDistance() const
+{
+    return distanceSpin->value();
+}
+
+
+int SimilarGlyphsDialog::maxResults() const
+{
+    return countSpin->value();
+}
+
+
+void SimilarGlyphsDialog::setResults( const FontDocument *document, int query,
+                                      const QList<GlyphSimilarityIndex::Match> &matches )
+{
+    queryLabel->setText( tr("Glyphs similar to UGL value %1:").arg( document->firstChar() + query ));
+
+    resultList->clear();
+    for ( int i = 0; i < matches.size(); i++ ) {
+        int index = matches.at( i ).index;
+        QImage image = document->glyph( index ).toImage();
+        QListWidgetItem *item = new QListWidgetItem( QIcon( QPixmap::fromImage( image )),
+                                                     tr("UGL value %1 (%n pixel(s) different)", "", matches.at( i ).distance )
+                                                        .arg( document->firstChar() + index ));
+        item->setData( Qt::UserRole, index );
+        resultList->addItem( item );
+    }
+    if ( matches.isEmpty() )
+        resultList->addItem( tr("No similar glyphs found.") );
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void SimilarGlyphsDialog::activateItem( QListWidgetItem *item )
+{
+    QVariant index = item->data( Qt::UserRole );
+    if ( index.isValid() )
+        emit glyphActivated( index.toInt() );
+}
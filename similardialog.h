@@ -0,0 +1,68 @@
+/******************************************************************************
+** similardialog.h
+**
+** Dialog listing the glyphs which look like the current glyph.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef SIMILARDIALOG_H
+#define SIMILARDIALOG_H
+
+#include <QDialog>
+
+#include "glyphsimilarity.h"
+
+class QLabel;
+class QListWidget;
+class QListWidgetItem;
+class QSpinBox;
+
+
+/* A non-modal dialog: the search is run by the main window whenever
+ * searchRequested() is emitted, and the results are shown with
+ * setResults().  Activating a result emits glyphActivated().
+ */
+class SimilarGlyphsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    SimilarGlyphsDialog( QWidget *parent = 0 );
+
+    int     maxDistance() const;
+    int     maxResults() const;
+
+    void    setResults( const FontDocument *document, int query,
+                        const QList<GlyphSimilarityIndex::Match> &matches );
+
+signals:
+    void searchRequested();
+    void glyphActivated( int index );
+
+private slots:
+    void activateItem( QListWidgetItem *item );
+
+private:
+    QLabel      *queryLabel;
+    QSpinBox    *distanceSpin;
+    QSpinBox    *countSpin;
+    QListWidget *resultList;
+};
+
+#endif  // SIMILARDIALOG_H
@@ -0,0 +1,101 @@
+/******************************************************************************
+** styledialog.cpp
+**
+** Options for deriving a bold or italic font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtGui>
+
+#include "styledialog.h"
+
+// Heaviest emboldening offered, in pixels
+#define MAX_STYLE_WEIGHT    4
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+StyleDialog::StyleDialog( QWidget *parent ): QDialog( parent )
+{
+    weightSpin = new QSpinBox();
+    weightSpin->setRange( 0, MAX_STYLE_WEIGHT );
+    weightSpin->setSpecialValueText( tr("None") );
+    weightSpin->setSuffix( tr(" pixel(s)") );
+    weightSpin->setValue( 1 );
+
+    widenCheck = new QCheckBox( tr("&Widen glyphs to fit") );
+    widenCheck->setChecked( true );
+
+    // The slope, as rows per pixel of slant
+    slantCombo = new QComboBox();
+    slantCombo->addItem( tr("None"), 0 );
+    for ( int rows = 2; rows <= 6; rows++ )
+        slantCombo->addItem( tr("1 pixel in %1 rows").arg( rows ), rows );
+
+    QLabel *weightLabel = new QLabel( tr("&Bold weight:") );
+    weightLabel->setBuddy( weightSpin );
+    QLabel *slantLabel = new QLabel( tr("&Italic slant:") );
+    slantLabel->setBuddy( slantCombo );
+
+    QDialogButtonBox *buttons = new QDialogButtonBox( QDialogButtonBox::Ok | QDialogButtonBox::Cancel );
+    connect( buttons, SIGNAL( accepted() ), this, SLOT( accept() ));
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( reject() ));
+    connect( weightSpin, SIGNAL( valueChanged( int )), this, SLOT( updateButtons() ));
+    connect( slantCombo, SIGNAL( currentIndexChanged( int )), this, SLOT( updateButtons() ));
+    okButton = buttons->button( QDialogButtonBox::Ok );
+
+    QGridLayout *layout = new QGridLayout();
+    layout->addWidget( weightLabel, 0, 0 );
+    layout->addWidget( weightSpin, 0, 1 );
+    layout->addWidget( widenCheck, 1, 1 );
+    layout->addWidget( slantLabel, 2, 0 );
+    layout->addWidget( slantCombo, 2, 1 );
+    layout->addWidget( buttons, 3, 0, 1, 2 );
+    setLayout( layout );
+
+    setWindowTitle( tr("Derive Bold/Italic Font") );
+    updateButtons();
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+GlyphStyler::Options StyleDialog::options() const
+{
+    GlyphStyler::Options options;
+    options.weight    = weightSpin->value();
+    options.widen     = widenCheck->isChecked();
+    options.slantRows = slantCombo->itemData( slantCombo->currentIndex() ).toInt();
+    return options;
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void StyleDialog::updateButtons()
+{
+    widenCheck->setEnabled( weightSpin->value() > 0 );
+    okButton->setEnabled( weightSpin->value() > 0 || slantCombo->currentIndex() > 0 );
+}
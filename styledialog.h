@@ -0,0 +1,56 @@
+/******************************************************************************
+** styledialog.h
+**
+** Options for deriving a bold or italic font.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef STYLEDIALOG_H
+#define STYLEDIALOG_H
+
+#include <QDialog>
+
+#include "glyphstyler.h"
+
+class QCheckBox;
+class QComboBox;
+class QPushButton;
+class QSpinBox;
+
+
+class StyleDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    StyleDialog( QWidget *parent = 0 );
+
+    GlyphStyler::Options options() const;
+
+private slots:
+    void updateButtons();
+
+private:
+    QSpinBox    *weightSpin;
+    QCheckBox   *widenCheck;
+    QComboBox   *slantCombo;
+    QPushButton *okButton;
+};
+
+#endif  // STYLEDIALOG_H
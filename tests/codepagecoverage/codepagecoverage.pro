@@ -0,0 +1,9 @@
+include( ../tests.pri )
+
+TARGET = tst_codepagecoverage
+HEADERS += $$QBF_SRC/glyphbitmap.h $$QBF_SRC/glyphpool.h $$QBF_SRC/glyphstore.h \
+           $$QBF_SRC/metricsindex.h $$QBF_SRC/kerningtable.h $$QBF_SRC/fontdocument.h \
+           $$QBF_SRC/glyphnames.h $$QBF_SRC/codepagecoverage.h
+SOURCES += tst_codepagecoverage.cpp $$QBF_SRC/glyphbitmap.cpp $$QBF_SRC/glyphpool.cpp \
+           $$QBF_SRC/glyphstore.cpp $$QBF_SRC/metricsindex.cpp $$QBF_SRC/kerningtable.cpp \
+           $$QBF_SRC/fontdocument.cpp $$QBF_SRC/glyphnames.cpp $$QBF_SRC/codepagecoverage.cpp
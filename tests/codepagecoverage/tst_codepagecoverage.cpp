@@ -0,0 +1,196 @@
+/******************************************************************************
+** tst_codepagecoverage.cpp
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtTest>
+#include <QTextCodec>
+
+#include "codepagecoverage.h"
+#include "fontdocument.h"
+#include "glyphnames.h"
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* Whether Qt has a codec for the code page, looked up as in
+ * GlyphNames::codePoint().
+ */
+static bool hasCodec( quint16 codePage )
+{
+    return QTextCodec::codecForName( QString("IBM %1").arg( codePage ).toLatin1() ) ||
+           QTextCodec::codecForName( QString("CP%1").arg( codePage ).toLatin1() ) ||
+           QTextCodec::codecForName( QString("windows-%1").arg( codePage ).toLatin1() );
+}
+
+
+/* A font with ink in every glyph from 'first' to 'last' and blanks in the
+ * rest.
+ */
+static FontDocument *inkedFont( quint16 codePage, int count, int first, int last )
+{
+    FontDocument *doc = new FontDocument( count, 8, 12, 3 );
+    doc->setCodePage( codePage );
+    GlyphBitmap ink( 8, 12 );
+    ink.fillRect( QRect( 1, 1, 6, 9 ), true );
+    for ( int i = first; i <= last && i < count; i++ )
+        doc->setGlyph( i, ink );
+    return doc;
+}
+
+
+static CodePageCoverage::Result resultFor( const CodePageCoverage &coverage, quint16 codePage )
+{
+    QList<CodePageCoverage::Result> all = coverage.results();
+    for ( int i = 0; i < all.size(); i++ )
+        if ( all.at( i ).codePage == codePage )
+            return all.at( i );
+    CodePageCoverage::Result none = { 0, 0, 0 };
+    return none;
+}
+
+
+// ---------------------------------------------------------------------------
+// TESTS
+//
+
+class TestCodePageCoverage : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tablesMatchCodecs();
+    void asciiOnly();
+    void completeCodePage();
+    void followsEdits();
+    void glyphForCodePoint();
+    void unmappedGlyphs();
+};
+
+
+/* The embedded tables should agree with Qt's own codecs wherever Qt has
+ * one for the code page.
+ */
+void TestCodePageCoverage::tablesMatchCodecs()
+{
+    QList<quint16> pages = CodePageCoverage::codePages();
+    for ( int i = 0; i < pages.size(); i++ ) {
+        QVector<uint> table = CodePageCoverage::byteTable( pages.at( i ));
+        if ( table.isEmpty() || !hasCodec( pages.at( i )))
+            continue;
+        for ( uint b = 0x80; b < 0x100; b++ )
+            QCOMPARE( table.at( b ), GlyphNames::codePoint( pages.at( i ), b ));
+    }
+}
+
+
+/* Only the ASCII characters are shared by every single-byte code page, and
+ * a blank space still counts.
+ */
+void TestCodePageCoverage::asciiOnly()
+{
+    FontDocument *doc = inkedFont( 1252, 128, 0x21, 0x7E );
+    CodePageCoverage coverage;
+    coverage.setDocument( doc );
+
+    CodePageCoverage::Result result = resultFor( coverage, 1252 );
+    QCOMPARE( (int) result.codePage, 1252 );
+    QCOMPARE( result.covered, 95 );
+    QCOMPARE( result.total, 95 + 123 );
+    QVERIFY( coverage.fullyCovered().isEmpty() );
+
+    QList<uint> missing = coverage.missing( 1252 );
+    QCOMPARE( missing.size(), 123 );
+    QCOMPARE( missing.first(), (uint) 0xA0 );
+    QCOMPARE( missing.last(), (uint) 0x2122 );
+    delete doc;
+}
+
+
+void TestCodePageCoverage::completeCodePage()
+{
+    FontDocument *doc = inkedFont( 1252, 256, 0x21, 0xFF );
+    CodePageCoverage coverage;
+    coverage.setDocument( doc );
+
+    QVERIFY( coverage.fullyCovered().contains( 1252 ));
+    QVERIFY( coverage.fullyCovered().contains( 1004 ));
+    QVERIFY( !coverage.fullyCovered().contains( 1250 ));
+    QVERIFY( coverage.missing( 1252 ).isEmpty() );
+    QVERIFY( coverage.report( true ).contains( "1252" ));
+    delete doc;
+}
+
+
+void TestCodePageCoverage::followsEdits()
+{
+    FontDocument *doc = inkedFont( 1252, 256, 0x21, 0xFF );
+    CodePageCoverage coverage;
+    coverage.setDocument( doc );
+    int total = resultFor( coverage, 1252 ).total;
+
+    doc->setGlyph( 'A', GlyphBitmap( 8, 12 ));
+    coverage.updateGlyph( doc, 'A' );
+    QCOMPARE( resultFor( coverage, 1252 ).covered, total - 1 );
+    QCOMPARE( coverage.missing( 1252 ), QList<uint>() << 'A' );
+    QVERIFY( coverage.missing( 850 ).contains( 'A' ));
+
+    doc->setGlyph( 'A', doc->glyph( 'B' ));
+    coverage.updateGlyph( doc, 'A' );
+    QCOMPARE( resultFor( coverage, 1252 ).covered, total );
+    delete doc;
+}
+
+
+void TestCodePageCoverage::glyphForCodePoint()
+{
+    FontDocument *doc = inkedFont( 1252, 256, 0x21, 0x7E );
+    CodePageCoverage coverage;
+    coverage.setDocument( doc );
+
+    QCOMPARE( coverage.glyphForCodePoint( 'A' ), (int) 'A' );
+    QCOMPARE( coverage.glyphForCodePoint( 0x20AC ), 0x80 );
+    QCOMPARE( coverage.glyphForCodePoint( 0x00E9 ), 0xE9 );
+    QCOMPARE( coverage.glyphForCodePoint( 0x0410 ), -1 );
+    delete doc;
+}
+
+
+/* Glyphs past 255 in a font which isn't in UCS-2 have no Unicode value.
+ */
+void TestCodePageCoverage::unmappedGlyphs()
+{
+    FontDocument *doc = inkedFont( 850, 300, 0x21, 0xFF );
+    CodePageCoverage coverage;
+    coverage.setDocument( doc );
+    QCOMPARE( coverage.unmappedGlyphs(), 300 - 256 );
+    delete doc;
+
+    doc = inkedFont( UCS2_CODEPAGE, 300, 0x21, 0x12B );
+    coverage.setDocument( doc );
+    QCOMPARE( coverage.unmappedGlyphs(), 0 );
+    QCOMPARE( coverage.glyphForCodePoint( 0x0100 ), 0x0100 );
+    delete doc;
+}
+
+
+QTEST_APPLESS_MAIN( TestCodePageCoverage )
+#include "tst_codepagecoverage.moc"
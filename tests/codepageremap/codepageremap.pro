@@ -0,0 +1,11 @@
+include( ../tests.pri )
+
+TARGET = tst_codepageremap
+HEADERS += $$QBF_SRC/glyphbitmap.h $$QBF_SRC/glyphpool.h $$QBF_SRC/glyphstore.h \
+           $$QBF_SRC/metricsindex.h $$QBF_SRC/kerningtable.h $$QBF_SRC/fontdocument.h \
+           $$QBF_SRC/glyphnames.h $$QBF_SRC/codepagecoverage.h $$QBF_SRC/fontfile.h \
+           $$QBF_SRC/os2fontfile.h $$QBF_SRC/codepageremap.h
+SOURCES += tst_codepageremap.cpp $$QBF_SRC/glyphbitmap.cpp $$QBF_SRC/glyphpool.cpp \
+           $$QBF_SRC/glyphstore.cpp $$QBF_SRC/metricsindex.cpp $$QBF_SRC/kerningtable.cpp \
+           $$QBF_SRC/fontdocument.cpp $$QBF_SRC/glyphnames.cpp $$QBF_SRC/codepagecoverage.cpp \
+           $$QBF_SRC/os2fontfile.cpp $$QBF_SRC/codepageremap.cpp
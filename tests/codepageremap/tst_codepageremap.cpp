@@ -0,0 +1,189 @@
+/******************************************************************************
+** tst_codepageremap.cpp
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtTest>
+
+#include "codepagecoverage.h"
+#include "codepageremap.h"
+#include "fontdocument.h"
+#include "glyphnames.h"
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* A Unicode master font in which each glyph is different: a bar as long
+ * as the low bits of its code point, on a row given by the next ones.
+ */
+static FontDocument *masterFont( int count )
+{
+    FontDocument *doc = new FontDocument( count, 8, 16, 4 );
+    doc->setCodePage( UCS2_CODEPAGE );
+    for ( int i = 1; i < count; i++ ) {
+        GlyphBitmap glyph( 8, 16 );
+        glyph.fillRect( QRect( 0, ( i >> 3 ) & 15, 1 + ( i & 7 ), 1 ), true );
+        glyph.setPixel( 7, ( i >> 7 ) & 15, true );
+        doc->setGlyph( i, glyph );
+    }
+    return doc;
+}
+
+
+// ---------------------------------------------------------------------------
+// TESTS
+//
+
+class TestCodePageRemap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void pcGraphicsBytes();
+    void otherControlBytes();
+    void noByteTable();
+    void pcGraphicsCovered();
+    void permutation();
+    void permutationMissing();
+    void remapSharesGlyphs();
+};
+
+
+/* The PC code pages show graphics characters for the control codes.
+ */
+void TestCodePageRemap::pcGraphicsBytes()
+{
+    QVector<uint> table = CodePageCoverage::byteTable( 437 );
+    QCOMPARE( table.size(), 256 );
+    QCOMPARE( table.at( 0x00 ), (uint) 0x0000 );
+    QCOMPARE( table.at( 0x01 ), (uint) 0x263A );
+    QCOMPARE( table.at( 0x14 ), (uint) 0x00B6 );
+    QCOMPARE( table.at( 0x1F ), (uint) 0x25BC );
+    QCOMPARE( table.at( 0x41 ), (uint) 'A' );
+    QCOMPARE( table.at( 0x7F ), (uint) 0x2302 );
+    QCOMPARE( table.at( 0x80 ), (uint) 0x00C7 );
+
+    for ( uint b = 0; b < 0x100; b++ )
+        QCOMPARE( CodePageCoverage::byteTable( 850 ).at( b ), GlyphNames::codePoint( 850, b ));
+}
+
+
+/* ...but the Windows code pages and Thai leave them as they are, and bytes
+ * with no character have no code point.
+ */
+void TestCodePageRemap::otherControlBytes()
+{
+    QVector<uint> table = CodePageCoverage::byteTable( 1252 );
+    QCOMPARE( table.at( 0x01 ), (uint) 0x01 );
+    QCOMPARE( table.at( 0x7F ), (uint) 0x7F );
+    QCOMPARE( table.at( 0x80 ), (uint) 0x20AC );
+    QCOMPARE( table.at( 0x81 ), NO_CODE_POINT );
+
+    QCOMPARE( CodePageCoverage::byteTable( 874 ).at( 0x01 ), (uint) 0x01 );
+    QCOMPARE( GlyphNames::codePoint( 874, 0x01 ), (uint) 0x01 );
+}
+
+
+void TestCodePageRemap::noByteTable()
+{
+    QVERIFY( CodePageCoverage::byteTable( 932 ).isEmpty() );
+    QVERIFY( CodePageCoverage::byteTable( UCS2_CODEPAGE ).isEmpty() );
+
+    FontDocument *master = masterFont( 0x100 );
+    QVERIFY( CodePageRemap::permutation( master, 932 ).isEmpty() );
+    QVERIFY( CodePageRemap::remap( master, 932 ) == 0 );
+    delete master;
+}
+
+
+/* A font in a PC code page needs the graphics characters as well to cover
+ * it fully.
+ */
+void TestCodePageRemap::pcGraphicsCovered()
+{
+    FontDocument *doc = masterFont( 0x100 );
+    doc->setCodePage( 437 );
+    CodePageCoverage coverage;
+    coverage.setDocument( doc );
+
+    QList<CodePageCoverage::Result> all = coverage.results();
+    for ( int i = 0; i < all.size(); i++ ) {
+        if ( all.at( i ).codePage != 437 )
+            continue;
+        QCOMPARE( all.at( i ).total, 95 + 32 + 128 );
+        QCOMPARE( all.at( i ).covered, all.at( i ).total );
+    }
+    QCOMPARE( coverage.glyphForCodePoint( 0x263A ), 0x01 );
+    delete doc;
+}
+
+
+void TestCodePageRemap::permutation()
+{
+    FontDocument *master = masterFont( 0x2700 );
+    QList<quint16> pages = CodePageCoverage::codePages();
+    for ( int i = 0; i < pages.size(); i++ ) {
+        QVector<uint> bytes = CodePageCoverage::byteTable( pages.at( i ));
+        if ( bytes.isEmpty() )
+            continue;
+        QVector<int> table = CodePageRemap::permutation( master, pages.at( i ));
+        QCOMPARE( table.size(), 256 );
+        for ( int b = 0; b < 256; b++ )
+            QCOMPARE( table.at( b ), ( bytes.at( b ) < 0x2700 )? (int) bytes.at( b ): -1 );
+    }
+    delete master;
+}
+
+
+/* A master with only Latin-1 lacks the PC graphics and box drawing.
+ */
+void TestCodePageRemap::permutationMissing()
+{
+    FontDocument *master = masterFont( 0x100 );
+    QVector<int> table = CodePageRemap::permutation( master, 437 );
+    QCOMPARE( table.at( 0x01 ), -1 );
+    QCOMPARE( table.at( 0x41 ), 0x41 );
+    QCOMPARE( table.at( 0x81 ), 0xFC );
+    QCOMPARE( table.at( 0xB0 ), -1 );
+    QCOMPARE( table.at( 0xFF ), 0xA0 );
+    delete master;
+}
+
+
+void TestCodePageRemap::remapSharesGlyphs()
+{
+    FontDocument *master = masterFont( 0x2700 );
+    FontDocument *variant = CodePageRemap::remap( master, 437 );
+    QVERIFY( variant != 0 );
+    QCOMPARE( (int) variant->codePage(), 437 );
+    QCOMPARE( variant->glyphCount(), 256 );
+    QCOMPARE( variant->firstChar(), 0 );
+
+    QVector<uint> bytes = CodePageCoverage::byteTable( 437 );
+    for ( int b = 0; b < 256; b++ )
+        QVERIFY( variant->glyph( b ) == master->glyph( bytes.at( b )));
+    delete variant;
+    delete master;
+}
+
+
+QTEST_APPLESS_MAIN( TestCodePageRemap )
+#include "tst_codepageremap.moc"
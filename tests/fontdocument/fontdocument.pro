@@ -0,0 +1,8 @@
+include( ../tests.pri )
+
+TARGET = tst_fontdocument
+HEADERS += $$QBF_SRC/glyphbitmap.h $$QBF_SRC/glyphpool.h $$QBF_SRC/glyphstore.h \
+           $$QBF_SRC/metricsindex.h $$QBF_SRC/kerningtable.h $$QBF_SRC/fontdocument.h
+SOURCES += tst_fontdocument.cpp $$QBF_SRC/glyphbitmap.cpp $$QBF_SRC/glyphpool.cpp \
+           $$QBF_SRC/glyphstore.cpp $$QBF_SRC/metricsindex.cpp $$QBF_SRC/kerningtable.cpp \
+           $$QBF_SRC/fontdocument.cpp
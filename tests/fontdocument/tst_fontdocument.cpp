@@ -0,0 +1,114 @@
+/******************************************************************************
+** tst_fontdocument.cpp
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtTest>
+
+#include "fontdocument.h"
+#include "glyphpool.h"
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* Glyphs which differ for every index, and from those made with any other
+ * seed.
+ */
+static GlyphBitmap distinctGlyph( int index, int seed )
+{
+    GlyphBitmap glyph( 12, 16 );
+    glyph.fillRect( QRect( 0, 0, 1 + index % 12, 1 + ( index / 12 ) % 16 ), true );
+    glyph.setPixel( 11, seed % 16, true );
+    glyph.setPixel( seed / 16 % 12, 15, true );
+    return glyph;
+}
+
+
+static FontDocument *distinctFont( int count, int seed )
+{
+    FontDocument *doc = new FontDocument( count, 12, 16, 4 );
+    for ( int i = 0; i < count; i++ )
+        doc->setGlyph( i, distinctGlyph( i, seed ));
+    return doc;
+}
+
+
+// ---------------------------------------------------------------------------
+// TESTS
+//
+
+class TestFontDocument : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void closingReleasesGlyphs();
+    void duplicateSharesGlyphs();
+};
+
+
+/* Deleting a document drops its glyphs from the pool straight away, but
+ * not those still used by another open document.
+ */
+void TestFontDocument::closingReleasesGlyphs()
+{
+    GlyphPool::purge();
+    int before = GlyphPool::count();
+
+    FontDocument *first  = distinctFont( 150, 1 );
+    FontDocument *second = distinctFont( 150, 40 );
+    GlyphPool::purge();
+    int open = GlyphPool::count();
+    QVERIFY( open > before );
+
+    delete second;
+    QVERIFY( GlyphPool::count() < open );
+    QVERIFY( GlyphPool::count() > before );
+    for ( int i = 0; i < first->glyphCount(); i++ )
+        QVERIFY( first->decodeGlyph( i ) == distinctGlyph( i, 1 ));
+
+    delete first;
+    QCOMPARE( GlyphPool::count(), before );
+}
+
+
+void TestFontDocument::duplicateSharesGlyphs()
+{
+    GlyphPool::purge();
+    int before = GlyphPool::count();
+
+    FontDocument *doc  = distinctFont( 100, 3 );
+    GlyphPool::purge();
+    int open = GlyphPool::count();
+    FontDocument *copy = doc->duplicate();
+    QCOMPARE( GlyphPool::count(), open );
+
+    delete doc;
+    QCOMPARE( GlyphPool::count(), open );
+    QCOMPARE( copy->glyphCount(), 100 );
+
+    delete copy;
+    QCOMPARE( GlyphPool::count(), before );
+}
+
+
+QTEST_APPLESS_MAIN( TestFontDocument )
+#include "tst_fontdocument.moc"
@@ -0,0 +1,215 @@
+/******************************************************************************
+** tst_glyphatlas.cpp
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtTest>
+
+#include "fontdocument.h"
+#include "glyphatlas.h"
+#include "glyphnames.h"
+
+Q_DECLARE_METATYPE( GlyphAtlas::Format )
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* A font of the given code page whose glyphs are blocks of random size in
+ * random places, with some blanks and a few repeats among them.
+ */
+static FontDocument *randomFont( quint16 codePage, int count, int width, int height )
+{
+    FontDocument *doc = new FontDocument( count, width, height, height / 4 );
+    doc->setCodePage( codePage );
+    for ( int i = 0; i < count; i++ ) {
+        int kind = qrand() % 10;
+        if ( kind == 0 )
+            continue;
+        if ( kind == 1 && i > 0 ) {
+            doc->setGlyph( i, doc->glyph( qrand() % i ));
+            continue;
+        }
+        GlyphBitmap glyph( width, height );
+        int x = qrand() % width;
+        int y = qrand() % height;
+        glyph.fillRect( QRect( x, y, 1 + qrand() % ( width - x ), 1 + qrand() % ( height - y )), true );
+        glyph.setPixel( qrand() % width, qrand() % height, true );
+        doc->setGlyph( i, glyph );
+    }
+    return doc;
+}
+
+
+static bool atlasPixel( const QImage &image, int x, int y )
+{
+    return qGray( image.pixel( x, y )) > 127;
+}
+
+
+// ---------------------------------------------------------------------------
+// TESTS
+//
+
+class TestGlyphAtlas : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void packing_data();
+    void packing();
+    void entriesSorted();
+    void identicalGlyphsShared();
+    void tooLargeForAtlas();
+};
+
+
+void TestGlyphAtlas::packing_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("padding");
+    QTest::addColumn<GlyphAtlas::Format>("format");
+
+    QTest::newRow("one glyph")     << 1 << 8 << 0 << GlyphAtlas::Mono;
+    QTest::newRow("small")         << 40 << 8 << 0 << GlyphAtlas::Mono;
+    QTest::newRow("padded")        << 256 << 16 << 1 << GlyphAtlas::Mono;
+    QTest::newRow("wide padding")  << 256 << 20 << 3 << GlyphAtlas::Gray;
+    QTest::newRow("large glyphs")  << 100 << 60 << 2 << GlyphAtlas::Gray;
+}
+
+
+/* Every glyph image lies within the atlas, no two overlap (padding
+ * included), and each shows the ink of its glyph where the index says.
+ */
+void TestGlyphAtlas::packing()
+{
+    QFETCH( int, count );
+    QFETCH( int, size );
+    QFETCH( int, padding );
+    QFETCH( GlyphAtlas::Format, format );
+
+    qsrand( count * size + padding );
+    FontDocument *doc = randomFont( UCS2_CODEPAGE, count, size, size );
+    QString error;
+    GlyphAtlas::Atlas atlas = GlyphAtlas::build( doc, format, padding, &error );
+    QVERIFY( !atlas.image.isNull() );
+    QVERIFY( error.isEmpty() );
+    QCOMPARE( atlas.entries.size(), count );
+
+    QList<QRect> placed;
+    for ( int i = 0; i < atlas.entries.size(); i++ ) {
+        const GlyphAtlas::Entry &entry = atlas.entries.at( i );
+        GlyphBitmap glyph = doc->glyph( entry.glyph );
+        if ( entry.width == 0 ) {
+            QVERIFY( glyph.isBlank() );
+            continue;
+        }
+
+        QRect area( entry.x, entry.y, entry.width, entry.height );
+        QVERIFY( area.right() < atlas.image.width() );
+        QVERIFY( area.bottom() < atlas.image.height() );
+        for ( int y = 0; y < entry.height; y++ )
+            for ( int x = 0; x < entry.width; x++ )
+                QCOMPARE( atlasPixel( atlas.image, entry.x + x, entry.y + y ),
+                          glyph.pixel( entry.left + x, entry.top + y ));
+
+        QRect padded( entry.x, entry.y, entry.width + padding, entry.height + padding );
+        if ( placed.contains( padded ))
+            continue;
+        for ( int j = 0; j < placed.size(); j++ )
+            QVERIFY( ( placed.at( j ) & padded ).isEmpty() );
+        placed << padded;
+    }
+    delete doc;
+}
+
+
+/* In code page 850 the glyph order is not the code point order.  Two
+ * characters (the pilcrow and section signs) appear twice in it, once
+ * among the PC graphics, so code points may repeat.
+ */
+void TestGlyphAtlas::entriesSorted()
+{
+    qsrand( 850 );
+    FontDocument *doc = randomFont( 850, 256, 12, 16 );
+    GlyphAtlas::Atlas atlas = GlyphAtlas::build( doc, GlyphAtlas::Mono, 1 );
+    QCOMPARE( atlas.entries.size(), 256 );
+
+    for ( int i = 0; i < atlas.entries.size(); i++ ) {
+        const GlyphAtlas::Entry &entry = atlas.entries.at( i );
+        QCOMPARE( entry.codePoint, GlyphNames::codePoint( 850, entry.glyph ));
+        if ( i > 0 )
+            QVERIFY( atlas.entries.at( i - 1 ).codePoint <= entry.codePoint );
+    }
+    delete doc;
+}
+
+
+void TestGlyphAtlas::identicalGlyphsShared()
+{
+    FontDocument doc( 3, 10, 10, 2 );
+    doc.setCodePage( UCS2_CODEPAGE );
+    GlyphBitmap glyph( 10, 10 );
+    glyph.fillRect( QRect( 2, 3, 4, 5 ), true );
+    GlyphBitmap moved( 10, 10 );
+    moved.fillRect( QRect( 5, 1, 4, 5 ), true );
+    doc.setGlyph( 0, glyph );
+    doc.setGlyph( 2, moved );
+
+    GlyphAtlas::Atlas atlas = GlyphAtlas::build( &doc, GlyphAtlas::Mono, 0 );
+    QCOMPARE( atlas.entries.size(), 3 );
+    QCOMPARE( atlas.entries.at( 0 ).x, atlas.entries.at( 2 ).x );
+    QCOMPARE( atlas.entries.at( 0 ).y, atlas.entries.at( 2 ).y );
+    QCOMPARE( (int) atlas.entries.at( 2 ).left, 5 );
+    QCOMPARE( (int) atlas.entries.at( 2 ).top, 1 );
+    QCOMPARE( atlas.glyphArea, (qint64) 20 );
+    QCOMPARE( atlas.image.size(), QSize( 4, 5 ));
+}
+
+
+/* Padding so wide that only a few glyphs fit on each row, even in the
+ * widest atlas, pushes the packing past the 16-bit limit on positions.
+ */
+void TestGlyphAtlas::tooLargeForAtlas()
+{
+    qsrand( 1 );
+    FontDocument doc( 40, 16, 16, 4 );
+    doc.setCodePage( UCS2_CODEPAGE );
+    for ( int i = 0; i < doc.glyphCount(); i++ ) {
+        GlyphBitmap glyph( 16, 16 );
+        glyph.fillRect( QRect( 0, 0, 1 + i % 16, 1 + i / 16 ), true );
+        doc.setGlyph( i, glyph );
+    }
+
+    QString error;
+    GlyphAtlas::Atlas atlas = GlyphAtlas::build( &doc, GlyphAtlas::Mono, 20000, &error );
+    QVERIFY( atlas.image.isNull() );
+    QVERIFY( atlas.entries.isEmpty() );
+    QVERIFY( !error.isEmpty() );
+
+    atlas = GlyphAtlas::build( &doc, GlyphAtlas::Mono, 1000, &error );
+    QVERIFY( !atlas.image.isNull() );
+    QVERIFY( atlas.image.width() <= 0xFFFF && atlas.image.height() <= 0xFFFF );
+}
+
+
+QTEST_APPLESS_MAIN( TestGlyphAtlas )
+#include "tst_glyphatlas.moc"
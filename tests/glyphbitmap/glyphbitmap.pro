@@ -0,0 +1,5 @@
+include( ../tests.pri )
+
+TARGET = tst_glyphbitmap
+HEADERS += $$QBF_SRC/glyphbitmap.h
+SOURCES += tst_glyphbitmap.cpp $$QBF_SRC/glyphbitmap.cpp
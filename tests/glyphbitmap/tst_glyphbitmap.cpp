@@ -0,0 +1,163 @@
+/******************************************************************************
+** tst_glyphbitmap.cpp
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtTest>
+
+#include "glyphbitmap.h"
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* A bitmap with roughly the given percentage of pixels set.
+ */
+static GlyphBitmap scattered( int width, int height, int percent )
+{
+    GlyphBitmap bitmap( width, height );
+    for ( int y = 0; y < height; y++ )
+        for ( int x = 0; x < width; x++ )
+            bitmap.setPixel( x, y, qrand() % 100 < percent );
+    return bitmap;
+}
+
+
+/* The flood fill done the simple way, a pixel at a time, to check against.
+ */
+static QRect referenceFill( GlyphBitmap &bitmap, const QPoint &seed, bool on )
+{
+    if ( !bitmap.rect().contains( seed ) || bitmap.pixel( seed.x(), seed.y() ) == on )
+        return QRect();
+
+    QRect changed;
+    QList<QPoint> pending;
+    pending << seed;
+    bitmap.setPixel( seed.x(), seed.y(), on );
+    while ( !pending.isEmpty() ) {
+        QPoint p = pending.takeLast();
+        changed |= QRect( p, p );
+        QPoint next[ 4 ] = { QPoint( p.x() - 1, p.y() ), QPoint( p.x() + 1, p.y() ),
+                             QPoint( p.x(), p.y() - 1 ), QPoint( p.x(), p.y() + 1 ) };
+        for ( int i = 0; i < 4; i++ ) {
+            if ( bitmap.rect().contains( next[ i ] ) && bitmap.pixel( next[ i ].x(), next[ i ].y() ) != on ) {
+                bitmap.setPixel( next[ i ].x(), next[ i ].y(), on );
+                pending << next[ i ];
+            }
+        }
+    }
+    return changed;
+}
+
+
+// ---------------------------------------------------------------------------
+// TESTS
+//
+
+class TestGlyphBitmap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fillInsideOutline();
+    void fillOnSameValue();
+    void fillStopsAtDiagonals();
+    void fillMatchesReference_data();
+    void fillMatchesReference();
+};
+
+
+void TestGlyphBitmap::fillInsideOutline()
+{
+    GlyphBitmap bitmap( 40, 20 );
+    bitmap.drawRect( QRect( 5, 3, 30, 12 ), true );
+
+    GlyphBitmap expected = bitmap;
+    expected.fillRect( QRect( 6, 4, 28, 10 ), true );
+
+    QCOMPARE( bitmap.floodFill( QPoint( 20, 8 ), true ), QRect( 6, 4, 28, 10 ));
+    QVERIFY( bitmap == expected );
+}
+
+
+void TestGlyphBitmap::fillOnSameValue()
+{
+    GlyphBitmap bitmap( 10, 10 );
+    bitmap.setPixel( 4, 4, true );
+    GlyphBitmap before = bitmap;
+
+    QVERIFY( bitmap.floodFill( QPoint( 4, 4 ), true ).isNull() );
+    QVERIFY( bitmap.floodFill( QPoint( 10, 4 ), true ).isNull() );
+    QVERIFY( bitmap == before );
+}
+
+
+/* Fills are 4-connected, so a diagonal line of ink is a wall.
+ */
+void TestGlyphBitmap::fillStopsAtDiagonals()
+{
+    GlyphBitmap bitmap( 16, 16 );
+    bitmap.drawLine( QPoint( 0, 0 ), QPoint( 15, 15 ), true );
+    bitmap.floodFill( QPoint( 15, 0 ), true );
+
+    for ( int y = 0; y < 16; y++ )
+        for ( int x = 0; x < 16; x++ )
+            QCOMPARE( bitmap.pixel( x, y ), x >= y );
+}
+
+
+void TestGlyphBitmap::fillMatchesReference_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<bool>("on");
+
+    QTest::newRow("narrow")       << 1 << 30 << true;
+    QTest::newRow("under a word") << 31 << 24 << true;
+    QTest::newRow("one word")     << 32 << 24 << false;
+    QTest::newRow("over a word")  << 33 << 24 << true;
+    QTest::newRow("wide")         << 100 << 40 << false;
+}
+
+
+/* Random bitmaps, sparse enough for the fills to wander across word
+ * boundaries, filled from several seeds.
+ */
+void TestGlyphBitmap::fillMatchesReference()
+{
+    QFETCH( int, width );
+    QFETCH( int, height );
+    QFETCH( bool, on );
+
+    qsrand( width * height );
+    for ( int n = 0; n < 20; n++ ) {
+        GlyphBitmap bitmap = scattered( width, height, on? 35: 65 );
+        GlyphBitmap expected = bitmap;
+        QPoint seed( qrand() % width, qrand() % height );
+
+        QRect expectedRect = referenceFill( expected, seed, on );
+        QCOMPARE( bitmap.floodFill( seed, on ), expectedRect );
+        QVERIFY( bitmap == expected );
+    }
+}
+
+
+QTEST_APPLESS_MAIN( TestGlyphBitmap )
+#include "tst_glyphbitmap.moc"
@@ -0,0 +1,204 @@
+/******************************************************************************
+** tst_glyphsimilarity.cpp
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtTest>
+
+#include "glyphsimilarity.h"
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* A glyph made of a few random rectangles, so that the font has clusters of
+ * near neighbours as well as outliers.
+ */
+static GlyphBitmap randomGlyph( int width, int height )
+{
+    GlyphBitmap bitmap( width, height );
+    int boxes = 1 + qrand() % 3;
+    for ( int i = 0; i < boxes; i++ ) {
+        int x = qrand() % width;
+        int y = qrand() % height;
+        bitmap.fillRect( QRect( x, y, 1 + qrand() % ( width - x ), 1 + qrand() % ( height - y )), true );
+    }
+    return bitmap;
+}
+
+
+/* The distances to every glyph in the document, nearest first, found by
+ * comparing against each one in turn.
+ */
+static QList<int> bruteForce( const FontDocument &doc, const GlyphBitmap &query,
+                              int count, int maxDistance, int exclude )
+{
+    GlyphFingerprint print = GlyphFingerprint::fromGlyph( query );
+    QList<int> distances;
+    for ( int i = 0; i < doc.glyphCount(); i++ ) {
+        if ( i == exclude )
+            continue;
+        int d = print.distance( GlyphFingerprint::fromGlyph( doc.glyph( i )));
+        if ( d <= maxDistance )
+            distances << d;
+    }
+    qSort( distances.begin(), distances.end() );
+    return distances.mid( 0, count );
+}
+
+
+/* Only the distances are compared, since glyphs at the same distance may
+ * come back in any order.
+ */
+static QList<int> distancesOf( const QList<GlyphSimilarityIndex::Match> &matches )
+{
+    QList<int> distances;
+    for ( int i = 0; i < matches.size(); i++ )
+        distances << matches.at( i ).distance;
+    return distances;
+}
+
+
+// ---------------------------------------------------------------------------
+// TESTS
+//
+
+class TestGlyphSimilarity : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fingerprintDistance();
+    void fingerprintDownsampled();
+    void nearestMatchesBruteForce_data();
+    void nearestMatchesBruteForce();
+    void nearestExcludesQuery();
+    void nearestFollowsEdits();
+};
+
+
+void TestGlyphSimilarity::fingerprintDistance()
+{
+    GlyphBitmap a( 16, 16 );
+    GlyphBitmap b( 16, 16 );
+    a.fillRect( QRect( 2, 2, 4, 4 ), true );
+    b.fillRect( QRect( 4, 2, 4, 4 ), true );
+
+    GlyphFingerprint pa = GlyphFingerprint::fromGlyph( a );
+    GlyphFingerprint pb = GlyphFingerprint::fromGlyph( b );
+    QCOMPARE( pa.distance( pa ), 0 );
+    QCOMPARE( pa.distance( pb ), 16 );
+    QCOMPARE( pb.distance( pa ), 16 );
+    QCOMPARE( pa.distance( GlyphFingerprint::fromGlyph( GlyphBitmap() )), 16 );
+}
+
+
+/* A 64x64 glyph is sampled down by two, a single pixel marking its whole
+ * block.
+ */
+void TestGlyphSimilarity::fingerprintDownsampled()
+{
+    GlyphBitmap large( 64, 64 );
+    large.setPixel( 63, 63, true );
+    large.setPixel( 10, 21, true );
+
+    GlyphBitmap small( 32, 32 );
+    small.setPixel( 31, 31, true );
+    small.setPixel( 5, 10, true );
+
+    QCOMPARE( GlyphFingerprint::fromGlyph( large ).distance( GlyphFingerprint::fromGlyph( small )), 0 );
+}
+
+
+void TestGlyphSimilarity::nearestMatchesBruteForce_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("maxDistance");
+
+    QTest::newRow("closest")     << 1 << 1024;
+    QTest::newRow("few")         << 8 << 1024;
+    QTest::newRow("near only")   << 50 << 40;
+    QTest::newRow("everything")  << 400 << 1024;
+}
+
+
+void TestGlyphSimilarity::nearestMatchesBruteForce()
+{
+    QFETCH( int, count );
+    QFETCH( int, maxDistance );
+
+    qsrand( count * 1000 + maxDistance );
+    FontDocument doc( 300, 20, 24, 4 );
+    for ( int i = 0; i < doc.glyphCount(); i++ )
+        doc.setGlyph( i, randomGlyph( 20, 24 ));
+
+    GlyphSimilarityIndex index( &doc );
+    for ( int n = 0; n < 30; n++ ) {
+        GlyphBitmap query = randomGlyph( 20, 24 );
+        QCOMPARE( distancesOf( index.nearest( query, count, maxDistance )),
+                  bruteForce( doc, query, count, maxDistance, -1 ));
+    }
+}
+
+
+void TestGlyphSimilarity::nearestExcludesQuery()
+{
+    qsrand( 7 );
+    FontDocument doc( 100, 16, 16, 3 );
+    for ( int i = 0; i < doc.glyphCount(); i++ )
+        doc.setGlyph( i, randomGlyph( 16, 16 ));
+
+    GlyphSimilarityIndex index( &doc );
+    for ( int i = 0; i < doc.glyphCount(); i += 9 ) {
+        QList<GlyphSimilarityIndex::Match> matches = index.nearest( doc.glyph( i ), 5, 1024, i );
+        QCOMPARE( distancesOf( matches ), bruteForce( doc, doc.glyph( i ), 5, 1024, i ));
+        for ( int j = 0; j < matches.size(); j++ )
+            QVERIFY( matches.at( j ).index != i );
+    }
+}
+
+
+/* Edits after the first search reach the tree through glyphChanged(), and
+ * enough of them force a rebuild; the results must be right either way.
+ */
+void TestGlyphSimilarity::nearestFollowsEdits()
+{
+    qsrand( 11 );
+    FontDocument doc( 200, 16, 16, 3 );
+    for ( int i = 0; i < doc.glyphCount(); i++ )
+        doc.setGlyph( i, randomGlyph( 16, 16 ));
+
+    GlyphSimilarityIndex index( &doc );
+    index.nearest( GlyphBitmap( 16, 16 ), 1, 1024 );
+
+    for ( int round = 0; round < 6; round++ ) {
+        for ( int n = 0; n < 60; n++ )
+            doc.setGlyph( qrand() % doc.glyphCount(), randomGlyph( 16, 16 ));
+
+        for ( int i = 0; i < doc.glyphCount(); i += 13 ) {
+            QCOMPARE( distancesOf( index.nearest( doc.glyph( i ), 6, 1024, i )),
+                      bruteForce( doc, doc.glyph( i ), 6, 1024, i ));
+        }
+    }
+}
+
+
+QTEST_APPLESS_MAIN( TestGlyphSimilarity )
+#include "tst_glyphsimilarity.moc"
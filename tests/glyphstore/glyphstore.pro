@@ -0,0 +1,5 @@
+include( ../tests.pri )
+
+TARGET = tst_glyphstore
+HEADERS += $$QBF_SRC/glyphbitmap.h $$QBF_SRC/glyphpool.h $$QBF_SRC/glyphstore.h
+SOURCES += tst_glyphstore.cpp $$QBF_SRC/glyphbitmap.cpp $$QBF_SRC/glyphpool.cpp $$QBF_SRC/glyphstore.cpp
@@ -0,0 +1,201 @@
+/******************************************************************************
+** tst_glyphstore.cpp
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtTest>
+
+#include "glyphbitmap.h"
+#include "glyphpool.h"
+#include "glyphstore.h"
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+/* A bitmap with a pattern which depends on the seed, so that different
+ * seeds give different glyphs.
+ */
+static GlyphBitmap patterned( int width, int height, int seed )
+{
+    GlyphBitmap bitmap( width, height );
+    for ( int y = 0; y < height; y++ )
+        for ( int x = 0; x < width; x++ )
+            bitmap.setPixel( x, y, (( x * 7 + y * 13 + seed * 5 ) % ( seed % 5 + 2 )) == 0 );
+    return bitmap;
+}
+
+
+// ---------------------------------------------------------------------------
+// TESTS
+//
+
+class TestGlyphStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void runsRoundTrip_data();
+    void runsRoundTrip();
+    void setAndRead();
+    void copiesAreIndependent();
+    void identicalGlyphsShared();
+    void purgeDropsUnusedGlyphs();
+    void cacheFollowsEdits();
+};
+
+
+void TestGlyphStore::runsRoundTrip_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("seed");
+
+    QTest::newRow("single pixel") << 1 << 1 << 0;
+    QTest::newRow("one word")     << 32 << 12 << 1;
+    QTest::newRow("word and bit") << 33 << 12 << 2;
+    QTest::newRow("odd width")    << 31 << 20 << 3;
+    QTest::newRow("wide")         << 70 << 40 << 4;
+}
+
+
+void TestGlyphStore::runsRoundTrip()
+{
+    QFETCH( int, width );
+    QFETCH( int, height );
+    QFETCH( int, seed );
+
+    QList<GlyphBitmap> bitmaps;
+    bitmaps << GlyphBitmap( width, height ) << patterned( width, height, seed );
+    GlyphBitmap full( width, height );
+    full.fill( true );
+    bitmaps << full;
+
+    for ( int i = 0; i < bitmaps.size(); i++ ) {
+        QByteArray runs = bitmaps.at( i ).toRuns();
+        GlyphBitmap decoded = GlyphBitmap::fromRuns( (const uchar *) runs.constData(), runs.size() );
+        QCOMPARE( decoded.size(), bitmaps.at( i ).size() );
+        QVERIFY( decoded == bitmaps.at( i ));
+    }
+}
+
+
+void TestGlyphStore::setAndRead()
+{
+    GlyphStore store;
+    store.fill( GlyphBitmap( 8, 10 ), 4 );
+    QCOMPARE( store.size(), 4 );
+
+    GlyphBitmap glyph = patterned( 8, 10, 3 );
+    store.set( 2, glyph );
+    QVERIFY( store.at( 2 ) == glyph );
+    QVERIFY( store.decode( 2 ) == glyph );
+    QVERIFY( store.at( 1 ) == GlyphBitmap( 8, 10 ));
+
+    // Out of range indices are ignored, and read as null
+    store.set( 4, glyph );
+    QCOMPARE( store.size(), 4 );
+    QVERIFY( store.at( -1 ).isNull() );
+    QVERIFY( store.decode( 4 ).isNull() );
+}
+
+
+void TestGlyphStore::copiesAreIndependent()
+{
+    QVector<GlyphBitmap> bitmaps;
+    for ( int i = 0; i < 5; i++ )
+        bitmaps << patterned( 9, 11, i );
+
+    GlyphStore store;
+    store.assign( bitmaps );
+    GlyphStore copy = store;
+    store.set( 1, GlyphBitmap( 9, 11 ));
+
+    QVERIFY( store.at( 1 ) == GlyphBitmap( 9, 11 ));
+    QVERIFY( copy.at( 1 ) == bitmaps.at( 1 ));
+    for ( int i = 0; i < bitmaps.size(); i++ )
+        QVERIFY( copy.decode( i ) == bitmaps.at( i ));
+}
+
+
+void TestGlyphStore::identicalGlyphsShared()
+{
+    GlyphPool::purge();
+    int before = GlyphPool::count();
+
+    GlyphBitmap glyph = patterned( 12, 16, 7 );
+    GlyphStore first, second;
+    first.fill( glyph, 10 );
+    QVector<GlyphBitmap> bitmaps( 3, patterned( 12, 16, 7 ));
+    second.assign( bitmaps );
+    second.set( 1, patterned( 12, 16, 7 ));
+
+    // However it was stored, the glyph is held by the pool once
+    QCOMPARE( GlyphPool::count(), before + 1 );
+}
+
+
+void TestGlyphStore::purgeDropsUnusedGlyphs()
+{
+    GlyphPool::purge();
+    int before = GlyphPool::count();
+    {
+        GlyphStore store;
+        QVector<GlyphBitmap> bitmaps;
+        for ( int i = 0; i < 20; i++ )
+            bitmaps << patterned( 10, 10, 100 + i );
+        store.assign( bitmaps );
+        QVERIFY( GlyphPool::count() > before );
+    }
+    GlyphPool::purge();
+    QCOMPARE( GlyphPool::count(), before );
+}
+
+
+/* Many edits of a few glyphs, checked against a plain list of bitmaps.  The
+ * cache is keyed on the address of each glyph's runs, so this would catch a
+ * cached bitmap outliving its runs and being returned for another glyph.
+ */
+void TestGlyphStore::cacheFollowsEdits()
+{
+    GlyphStore::setCacheLimit( 64 );
+    QVector<GlyphBitmap> expected( 16, GlyphBitmap( 10, 12 ));
+    GlyphStore store;
+    store.assign( expected );
+
+    qsrand( 1 );
+    for ( int n = 0; n < 2000; n++ ) {
+        int index = qrand() % expected.size();
+        expected[ index ] = patterned( 10, 12, qrand() % 40 );
+        store.set( index, expected.at( index ));
+        if ( n % 50 == 0 )
+            GlyphPool::purge();
+
+        int check = qrand() % expected.size();
+        QVERIFY( store.at( check ) == expected.at( check ));
+    }
+    for ( int i = 0; i < expected.size(); i++ )
+        QVERIFY( store.at( i ) == expected.at( i ));
+    GlyphStore::setCacheLimit( 8192 );
+}
+
+
+QTEST_APPLESS_MAIN( TestGlyphStore )
+#include "tst_glyphstore.moc"
@@ -0,0 +1,5 @@
+include( ../tests.pri )
+
+TARGET = tst_kerningtable
+HEADERS += $$QBF_SRC/kerningtable.h
+SOURCES += tst_kerningtable.cpp $$QBF_SRC/kerningtable.cpp
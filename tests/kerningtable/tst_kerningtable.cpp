@@ -0,0 +1,184 @@
+/******************************************************************************
+** tst_kerningtable.cpp
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QtTest>
+
+#include "kerningtable.h"
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static quint32 key( quint16 first, quint16 second )
+{
+    return ((quint32) first << 16 ) | second;
+}
+
+
+/* Check the table against the pairs it should hold, both by looking each
+ * one up and by listing them all.
+ */
+static bool matches( const KerningTable &table, const QMap<quint32, int> &expected )
+{
+    if ( table.count() != expected.size() )
+        return false;
+
+    QVector<KerningPair> pairs = table.sorted();
+    QMap<quint32, int>::const_iterator it = expected.constBegin();
+    for ( int i = 0; i < pairs.size(); i++, ++it ) {
+        if ( key( pairs.at( i ).first, pairs.at( i ).second ) != it.key() || pairs.at( i ).amount != it.value() )
+            return false;
+        if ( table.amount( pairs.at( i ).first, pairs.at( i ).second ) != it.value() )
+            return false;
+    }
+    return true;
+}
+
+
+// ---------------------------------------------------------------------------
+// TESTS
+//
+
+class TestKerningTable : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void setAndLookUp();
+    void amountsLimited();
+    void sortedAndAssign();
+    void removeKeepsOtherPairs();
+    void repeatedEditsKeepCount();
+};
+
+
+void TestKerningTable::setAndLookUp()
+{
+    KerningTable table;
+    QVERIFY( table.isEmpty() );
+    QCOMPARE( table.amount( 'A', 'V' ), 0 );
+
+    table.setAmount( 'A', 'V', -2 );
+    table.setAmount( 'V', 'A', -1 );
+    table.setAmount( 'A', 'V', -3 );
+    QCOMPARE( table.count(), 2 );
+    QCOMPARE( table.amount( 'A', 'V' ), -3 );
+    QCOMPARE( table.amount( 'V', 'A' ), -1 );
+    QCOMPARE( table.amount( 'A', 'W' ), 0 );
+
+    // An amount of 0 removes the pair; removing a missing pair does nothing
+    table.setAmount( 'A', 'V', 0 );
+    table.setAmount( 'T', 'o', 0 );
+    QCOMPARE( table.count(), 1 );
+    QCOMPARE( table.amount( 'A', 'V' ), 0 );
+
+    table.clear();
+    QVERIFY( table.isEmpty() );
+    QCOMPARE( table.amount( 'V', 'A' ), 0 );
+}
+
+
+void TestKerningTable::amountsLimited()
+{
+    KerningTable table;
+    table.setAmount( 1, 2, 40000 );
+    table.setAmount( 2, 1, -40000 );
+    QCOMPARE( table.amount( 1, 2 ), 32767 );
+    QCOMPARE( table.amount( 2, 1 ), -32768 );
+
+    // This pair would look like an empty slot, so can't be stored
+    table.setAmount( 0xFFFF, 0xFFFF, 5 );
+    QCOMPARE( table.count(), 2 );
+}
+
+
+void TestKerningTable::sortedAndAssign()
+{
+    KerningTable table;
+    table.setAmount( 'b', 'a', 3 );
+    table.setAmount( 'a', 'z', 1 );
+    table.setAmount( 'a', 'b', 2 );
+
+    QVector<KerningPair> pairs = table.sorted();
+    QCOMPARE( pairs.size(), 3 );
+    QCOMPARE( key( pairs.at( 0 ).first, pairs.at( 0 ).second ), key( 'a', 'b' ));
+    QCOMPARE( key( pairs.at( 1 ).first, pairs.at( 1 ).second ), key( 'a', 'z' ));
+    QCOMPARE( key( pairs.at( 2 ).first, pairs.at( 2 ).second ), key( 'b', 'a' ));
+
+    KerningTable copy;
+    copy.setAmount( 'x', 'y', 9 );
+    copy.assign( pairs );
+    QCOMPARE( copy.count(), 3 );
+    QCOMPARE( copy.amount( 'x', 'y' ), 0 );
+    QCOMPARE( copy.amount( 'b', 'a' ), 3 );
+}
+
+
+/* Removal shifts later entries of a probe run back into the hole.  Pairs
+ * drawn from a few characters give long runs of neighbouring keys, and
+ * the table is checked in full after every change.
+ */
+void TestKerningTable::removeKeepsOtherPairs()
+{
+    KerningTable       table;
+    QMap<quint32, int> expected;
+
+    qsrand( 42 );
+    for ( int n = 0; n < 3000; n++ ) {
+        quint16 first  = 'A' + qrand() % 12;
+        quint16 second = 'a' + qrand() % 12;
+        int     amount = ( qrand() % 3 )? qrand() % 9 - 4: 0;
+
+        table.setAmount( first, second, amount );
+        if ( amount )
+            expected.insert( key( first, second ), amount );
+        else
+            expected.remove( key( first, second ));
+        QVERIFY( matches( table, expected ));
+    }
+}
+
+
+/* Adding and removing pairs many times over leaves only the pairs still
+ * set; no deleted entries are left behind to be found.
+ */
+void TestKerningTable::repeatedEditsKeepCount()
+{
+    KerningTable table;
+    for ( int i = 0; i < 40; i++ )
+        table.setAmount( 'A', 'a' + i, -1 );
+
+    for ( int round = 0; round < 500; round++ ) {
+        for ( int i = 0; i < 40; i += 2 )
+            table.setAmount( 'A', 'a' + i, 0 );
+        QCOMPARE( table.count(), 20 );
+        for ( int i = 0; i < 40; i += 2 )
+            table.setAmount( 'A', 'a' + i, -2 );
+        QCOMPARE( table.count(), 40 );
+    }
+    for ( int i = 0; i < 40; i++ )
+        QCOMPARE( table.amount( 'A', 'a' + i ), ( i % 2 )? -1: -2 );
+}
+
+
+QTEST_APPLESS_MAIN( TestKerningTable )
+#include "tst_kerningtable.moc"
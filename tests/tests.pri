@@ -0,0 +1,9 @@
+# Common settings for the unit tests.  The sources under test are built
+# straight from the main directory, as $$QBF_SRC/file.cpp.
+QBF_SRC = $$PWD/..
+
+TEMPLATE = app
+CONFIG += qtestlib console
+CONFIG -= app_bundle
+DEPENDPATH += . $$QBF_SRC
+INCLUDEPATH += . $$QBF_SRC
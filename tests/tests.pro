@@ -0,0 +1,7 @@
+######################################################################
+# Unit tests for the parts of QBFont which need no windows.  Build with
+#   qmake tests.pro && make
+# then run each tst_* program; each exits non-zero if any test fails.
+######################################################################
+TEMPLATE = subdirs
+SUBDIRS = glyphstore glyphbitmap kerningtable glyphsimilarity glyphatlas codepagecoverage codepageremap fontdocument
@@ -0,0 +1,135 @@
+/******************************************************************************
+** variantsdialog.cpp
+**
+** Choice of code pages and output location for code page variants.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#include <QtGui>
+
+#include "codepagecoverage.h"
+#include "variantsdialog.h"
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+VariantsDialog::VariantsDialog( const CodePageCoverage *coverage, const QString &directory,
+                                const QString &baseName, QWidget *parent ): QDialog( parent )
+{
+    pageList = new QListWidget();
+    QList<CodePageCoverage::Result> results = coverage->results();
+    for ( int i = 0; i < results.size(); i++ ) {
+        const CodePageCoverage::Result &result = results.at( i );
+        if ( CodePageCoverage::byteTable( result.codePage ).isEmpty() )
+            continue;
+
+        int missing = result.total - result.covered;
+        QString text = tr("%1 - %2").arg( result.codePage ).arg( CodePageCoverage::description( result.codePage ));
+        if ( missing )
+            text += tr(" (%n character(s) missing)", "", missing );
+        QListWidgetItem *item = new QListWidgetItem( text, pageList );
+        item->setData( Qt::UserRole, result.codePage );
+        item->setCheckState( missing? Qt::Unchecked: Qt::Checked );
+    }
+    connect( pageList, SIGNAL( itemChanged( QListWidgetItem * )), this, SLOT( updateButtons() ));
+
+    directoryEdit = new QLineEdit( QDir::toNativeSeparators( directory ));
+    connect( directoryEdit, SIGNAL( textChanged( const QString & )), this, SLOT( updateButtons() ));
+    QPushButton *browseButton = new QPushButton( tr("&Browse...") );
+    connect( browseButton, SIGNAL( clicked() ), this, SLOT( browse() ));
+
+    nameEdit = new QLineEdit( baseName );
+    nameEdit->setValidator( new QRegExpValidator( QRegExp("[^\\\\/:*?\"<>|]*"), this ));
+    connect( nameEdit, SIGNAL( textChanged( const QString & )), this, SLOT( updateButtons() ));
+
+    QLabel *pageLabel = new QLabel( tr("&Code pages:") );
+    pageLabel->setBuddy( pageList );
+    QLabel *directoryLabel = new QLabel( tr("&Folder:") );
+    directoryLabel->setBuddy( directoryEdit );
+    QLabel *nameLabel = new QLabel( tr("File &names:") );
+    nameLabel->setBuddy( nameEdit );
+    QLabel *nameHint = new QLabel( tr("followed by the code page number, e.g. %1850.fnt").arg( baseName ));
+
+    QDialogButtonBox *buttons = new QDialogButtonBox( QDialogButtonBox::Ok | QDialogButtonBox::Cancel );
+    connect( buttons, SIGNAL( accepted() ), this, SLOT( accept() ));
+    connect( buttons, SIGNAL( rejected() ), this, SLOT( reject() ));
+    okButton = buttons->button( QDialogButtonBox::Ok );
+
+    QGridLayout *layout = new QGridLayout();
+    layout->addWidget( pageLabel, 0, 0, 1, 3 );
+    layout->addWidget( pageList, 1, 0, 1, 3 );
+    layout->addWidget( directoryLabel, 2, 0 );
+    layout->addWidget( directoryEdit, 2, 1 );
+    layout->addWidget( browseButton, 2, 2 );
+    layout->addWidget( nameLabel, 3, 0 );
+    layout->addWidget( nameEdit, 3, 1, 1, 2 );
+    layout->addWidget( nameHint, 4, 1, 1, 2 );
+    layout->addWidget( buttons, 5, 0, 1, 3 );
+    setLayout( layout );
+
+    setWindowTitle( tr("Generate Code Page Variants") );
+    updateButtons();
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+QList<quint16> VariantsDialog::codePages() const
+{
+    QList<quint16> pages;
+    for ( int i = 0; i < pageList->count(); i++ )
+        if ( pageList->item( i )->checkState() == Qt::Checked )
+            pages.append( pageList->item( i )->data( Qt::UserRole ).toInt() );
+    return pages;
+}
+
+
+QString VariantsDialog::directory() const
+{
+    return QDir::fromNativeSeparators( directoryEdit->text() );
+}
+
+
+QString VariantsDialog::baseName() const
+{
+    return nameEdit->text();
+}
+
+
+// ---------------------------------------------------------------------------
+// SLOTS
+//
+
+void VariantsDialog::browse()
+{
+    QString chosen = QFileDialog::getExistingDirectory( this, tr("Folder for Code Page Variants"), directory() );
+    if ( !chosen.isEmpty() )
+        directoryEdit->setText( QDir::toNativeSeparators( chosen ));
+}
+
+
+void VariantsDialog::updateButtons()
+{
+    okButton->setEnabled( !codePages().isEmpty() && QDir( directory() ).exists() );
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+** variantsdialog.h
+**
+** Choice of code pages and output location for code page variants.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+
+#ifndef VARIANTSDIALOG_H
+#define VARIANTSDIALOG_H
+
+#include <QDialog>
+#include <QList>
+
+class QLineEdit;
+class QListWidget;
+class QPushButton;
+class CodePageCoverage;
+
+
+/* Lists the single-byte code pages with the number of characters the font
+ * lacks for each; those it covers completely start out checked.
+ */
+class VariantsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    VariantsDialog( const CodePageCoverage *coverage, const QString &directory,
+                    const QString &baseName, QWidget *parent = 0 );
+
+    QList<quint16> codePages() const;
+    QString        directory() const;
+    QString        baseName() const;
+
+private slots:
+    void browse();
+    void updateButtons();
+
+private:
+    QListWidget *pageList;
+    QLineEdit   *directoryEdit;
+    QLineEdit   *nameEdit;
+    QPushButton *okButton;
+};
+
+#endif  // VARIANTSDIALOG_H
@@ -0,0 +1,349 @@
+/******************************************************************************
+** winfontfile.cpp
+**
+** Reading and writing Windows 2.x/3.x bitmap font (.FNT) files.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QHash>
+#include <QList>
+#include <QtEndian>
+
+#include "fontdocument.h"
+#include "winfontfile.h"
+
+// Format versions
+#define FNT_VERSION_2           0x0200
+#define FNT_VERSION_3           0x0300
+
+// Header and character table entry sizes
+#define FNT_HEADER_2            118
+#define FNT_HEADER_3            148
+#define FNT_ENTRY_2             4
+#define FNT_ENTRY_3             6
+#define FNT_COPYRIGHT_LENGTH    60
+
+// Offsets of the FONTINFO fields we read
+#define FI_TYPE                 66
+#define FI_POINTS               68
+#define FI_ASCENT               74
+#define FI_ITALIC               80
+#define FI_WEIGHT               83
+#define FI_CHARSET              85
+#define FI_PIXHEIGHT            88
+#define FI_FIRSTCHAR            95
+#define FI_LASTCHAR             96
+#define FI_FACE                 105
+
+// dfType, dfPitchAndFamily and dfFlags values
+#define FNT_TYPE_VECTOR         0x0001
+#define FNT_VARIABLE_PITCH      0x01
+#define DFF_FIXED               0x0001
+#define DFF_PROPORTIONAL        0x0002
+#define DFF_1COLOR              0x0010
+
+#define FW_NORMAL               400
+#define FW_BOLD                 700
+
+#define OEM_CHARSET             255
+#define FACE_LENGTH             256
+
+
+// ---------------------------------------------------------------------------
+// LOCAL HELPERS
+//
+
+static inline quint16 readWord( const uchar *p )  { return qFromLittleEndian<quint16>( p ); }
+static inline quint32 readLong( const uchar *p )  { return qFromLittleEndian<quint32>( p ); }
+
+// Windows character sets and the code pages they correspond to
+static const struct {
+    quint8  charSet;
+    quint16 codePage;
+} charSets[] = {
+    {   0, 1252 },      // ANSI
+    { 128,  932 },      // Shift-JIS
+    { 129,  949 },      // Hangul
+    { 134,  936 },      // GB2312
+    { 136,  950 },      // Big5
+    { 161, 1253 },      // Greek
+    { 162, 1254 },      // Turkish
+    { 177, 1255 },      // Hebrew
+    { 178, 1256 },      // Arabic
+    { 186, 1257 },      // Baltic
+    { 204, 1251 },      // Cyrillic
+    { 222,  874 },      // Thai
+    { 238, 1250 },      // Central European
+    { 255,  437 }       // OEM
+};
+
+static quint16 codePageForCharSet( quint8 charSet )
+{
+    for ( uint i = 0; i < sizeof( charSets ) / sizeof( charSets[ 0 ] ); i++ )
+        if ( charSets[ i ].charSet == charSet )
+            return charSets[ i ].codePage;
+    return 1252;
+}
+
+// Code pages without a Windows character set are taken to be OEM (PC) ones
+static quint8 charSetForCodePage( quint16 codePage )
+{
+    for ( uint i = 0; i < sizeof( charSets ) / sizeof( charSets[ 0 ] ); i++ )
+        if ( charSets[ i ].codePage == codePage )
+            return charSets[ i ].charSet;
+    return OEM_CHARSET;
+}
+
+static void writeString( QDataStream &out, const QByteArray &text, int length )
+{
+    QByteArray field = text.left( length );
+    field.append( QByteArray( length - field.size(), '\0' ));
+    out.writeRawData( field.constData(), length );
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC CONSTRUCTOR
+//
+
+WinFontFile::WinFontFile( const uchar *data, qint64 size ): FontFileReader( data, size )
+{
+}
+
+
+// ---------------------------------------------------------------------------
+// PUBLIC METHODS
+//
+
+bool WinFontFile::recognize( const uchar *data, qint64 size )
+{
+    if ( size < FNT_HEADER_2 )
+        return false;
+    quint16 version = readWord( data );
+    return (( version == FNT_VERSION_2 ) || ( version == FNT_VERSION_3 )) &&
+           ( data[ FI_FIRSTCHAR ] <= data[ FI_LASTCHAR ] ) &&
+           ( readWord( data + FI_PIXHEIGHT ) > 0 );
+}
+
+
+/* Read the header and the character table.  The glyph images are left
+ * alone until they are asked for.
+ */
+bool WinFontFile::parse()
+{
+    if ( !recognize( pData, llSize )) {
+        strError = QCoreApplication::translate("WinFontFile", "This is not a Windows font file.");
+        return false;
+    }
+    if ( readWord( pData + FI_TYPE ) & FNT_TYPE_VECTOR ) {
+        strError = QCoreApplication::translate("WinFontFile", "This is a vector font, which is not supported.");
+        return false;
+    }
+
+    bool   v3        = ( readWord( pData ) == FNT_VERSION_3 );
+    int    entrySize = v3? FNT_ENTRY_3: FNT_ENTRY_2;
+    qint64 table     = v3? FNT_HEADER_3: FNT_HEADER_2;
+    int    first     = pData[ FI_FIRSTCHAR ];
+    int    count     = pData[ FI_LASTCHAR ] - first + 1;
+
+    if ( table + (qint64) count * entrySize > llSize ) {
+        strError = QCoreApplication::translate("WinFontFile", "The character table is damaged.");
+        return false;
+    }
+
+    chars.resize( count );
+    for ( int i = 0; i < count; i++ ) {
+        const uchar *pc = pData + table + (qint64) i * entrySize;
+        chars[ i ].width  = readWord( pc );
+        chars[ i ].offset = v3? readLong( pc + 2 ): readWord( pc + 2 );
+    }
+
+    QString face;
+    qint64  faceOffset = readLong( pData + FI_FACE );
+    if ( faceOffset > 0 && faceOffset < llSize ) {
+        const char *p = (const char *) pData + faceOffset;
+        face = QString::fromLatin1( p, qstrnlen( p, qMin( llSize - faceOffset, (qint64) FACE_LENGTH )));
+    }
+
+    // Windows fonts only have the one name; the style is given separately
+    fontInfo.familyName = face;
+    fontInfo.faceName   = face;
+    if ( readWord( pData + FI_WEIGHT ) >= FW_BOLD )
+        fontInfo.faceName += " Bold";
+    if ( pData[ FI_ITALIC ] )
+        fontInfo.faceName += " Italic";
+
+    fontInfo.codePage   = codePageForCharSet( pData[ FI_CHARSET ] );
+    fontInfo.pointSize  = readWord( pData + FI_POINTS );
+    fontInfo.firstChar  = first;
+    fontInfo.glyphCount = count;
+    fontInfo.cellHeight = readWord( pData + FI_PIXHEIGHT );
+    fontInfo.baseLine   = qMax( 0, fontInfo.cellHeight - (int) readWord( pData + FI_ASCENT ));
+    fontInfo.imported   = true;
+    return true;
+}
+
+
+int WinFontFile::glyphWidth( int index ) const
+{
+    if ( index < 0 || index >= chars.size() )
+        return 0;
+    return qMax( 1, (int) chars.at( index ).width );
+}
+
+
+/* Decode one glyph image, which is stored in the same byte strips as in an
+ * OS/2 font.  Images which fall outside the file are returned blank.
+ */
+GlyphBitmap WinFontFile::glyph( int index ) const
+{
+    if ( index < 0 || index >= chars.size() )
+        return GlyphBitmap();
+
+    const CharDef &def = chars.at( index );
+    int    height = fontInfo.cellHeight;
+    qint64 bytes  = (qint64)(( def.width + 7 ) / 8 ) * height;
+
+    if ( !def.width || ( (qint64) def.offset + bytes > llSize ))
+        return GlyphBitmap( glyphWidth( index ), height );
+    return GlyphBitmap::fromByteColumns( pData + def.offset, def.width, height );
+}
+
+
+/* The number of the document's glyphs which fit into a Windows font, whose
+ * characters are numbered from 0 to 255.
+ */
+int WinFontFile::maxGlyphs( const FontDocument *document )
+{
+    return qBound( 0, 256 - document->firstChar(), document->glyphCount() );
+}
+
+
+/* Write a font as a Windows raster font, version 2 if it fits in 64K and
+ * version 3 otherwise.  Glyphs beyond character 255 are left out (see
+ * maxGlyphs()); identical glyphs share a single glyph image.
+ */
+QByteArray WinFontFile::write( const FontDocument *document )
+{
+    const FontMetricsIndex &metrics = document->metrics();
+
+    int count    = maxGlyphs( document );
+    int height   = document->cellHeight();
+    int baseLine = document->baseLine();
+    int first    = document->firstChar();
+    if ( count < 1 )
+        return QByteArray();
+
+    QVector<GlyphBitmap> glyphs( count );
+    QList<GlyphBitmap>   images;
+    QVector<quint32>     imageOffsets( count );
+    QHash<GlyphBitmap, quint32> written;
+    quint32 imageBytes = 0;
+    int     widthBytes = 0;
+    bool    fixed      = true;
+
+    for ( int i = 0; i < count; i++ ) {
+        GlyphBitmap glyph = document->decodeGlyph( i );
+        if ( glyph.height() != height )
+            glyph = glyph.copy( QRect( 0, 0, glyph.width(), height ));
+        glyphs[ i ] = glyph;
+        widthBytes += ( glyph.width() + 7 ) / 8;
+        fixed = fixed && ( glyph.width() == glyphs.at( 0 ).width() );
+
+        QHash<GlyphBitmap, quint32>::const_iterator found = written.constFind( glyph );
+        if ( found != written.constEnd() )
+            imageOffsets[ i ] = found.value();
+        else {
+            imageOffsets[ i ] = imageBytes;
+            written.insert( glyph, imageBytes );
+            images.append( glyph );
+            imageBytes += (( glyph.width() + 7 ) / 8 ) * height;
+        }
+    }
+
+    // The table has an extra entry after the last character, for a space
+    QByteArray face = document->familyName().toLatin1();
+    bool    v3        = ( FNT_HEADER_2 + ( count + 1 ) * FNT_ENTRY_2 + imageBytes > 0xFFFF );
+    quint32 imageBase = v3? FNT_HEADER_3 + ( count + 1 ) * FNT_ENTRY_3:
+                            FNT_HEADER_2 + ( count + 1 ) * FNT_ENTRY_2;
+    quint32 faceBase  = imageBase + imageBytes;
+    quint32 total     = faceBase + face.size() + 1;
+
+    int defaultChar = ( '?' >= first && '?' - first < count )? '?' - first: 0;
+    int breakChar   = ( ' ' >= first && ' ' - first < count )? ' ' - first: 0;
+    bool bold       = document->faceName().contains("Bold", Qt::CaseInsensitive );
+    bool italic     = document->faceName().contains("Italic", Qt::CaseInsensitive ) ||
+                      document->faceName().contains("Oblique", Qt::CaseInsensitive );
+
+    QByteArray data;
+    QDataStream out( &data, QIODevice::WriteOnly );
+    out.setByteOrder( QDataStream::LittleEndian );
+
+    // FONTINFO
+    out << (quint16)( v3? FNT_VERSION_3: FNT_VERSION_2 )
+        << (quint32) total;                             // dfSize
+    writeString( out, QByteArray(), FNT_COPYRIGHT_LENGTH );
+    out << (quint16) 0                                  // dfType (raster)
+        << (quint16) document->pointSize()
+        << (quint16) 96 << (quint16) 96                 // dfVertRes, dfHorizRes
+        << (quint16)( height - baseLine )               // dfAscent
+        << (quint16) 0 << (quint16) 0                   // dfInternalLeading, dfExternalLeading
+        << (quint8) italic << (quint8) 0 << (quint8) 0  // dfItalic, dfUnderline, dfStrikeOut
+        << (quint16)( bold? FW_BOLD: FW_NORMAL )
+        << (quint8) charSetForCodePage( document->codePage() )
+        << (quint16)( fixed? glyphs.at( 0 ).width(): 0 )    // dfPixWidth
+        << (quint16) height                             // dfPixHeight
+        << (quint8)( fixed? 0: FNT_VARIABLE_PITCH )     // dfPitchAndFamily
+        << (quint16) metrics.averageIncrement()         // dfAvgWidth
+        << (quint16) metrics.maxIncrement()             // dfMaxWidth
+        << (quint8) first
+        << (quint8)( first + count - 1 )                // dfLastChar
+        << (quint8) defaultChar << (quint8) breakChar
+        << (quint16)(( widthBytes + 1 ) & ~1 )          // dfWidthBytes
+        << (quint32) 0                                  // dfDevice
+        << (quint32) faceBase                           // dfFace
+        << (quint32) 0                                  // dfBitsPointer
+        << (quint32) imageBase                          // dfBitsOffset
+        << (quint8) 0;                                  // dfReserved
+    if ( v3 ) {
+        out << (quint32)(( fixed? DFF_FIXED: DFF_PROPORTIONAL ) | DFF_1COLOR )
+            << (quint16) 0 << (quint16) 0 << (quint16) 0    // dfAspace, dfBspace, dfCspace
+            << (quint32) 0;                                 // dfColorPointer
+        writeString( out, QByteArray(), 16 );               // dfReserved1
+    }
+
+    // Character table
+    for ( int i = 0; i <= count; i++ ) {
+        int c = ( i < count )? i: breakChar;
+        out << (quint16) glyphs.at( c ).width();
+        if ( v3 )
+            out << (quint32)( imageBase + imageOffsets.at( c ));
+        else
+            out << (quint16)( imageBase + imageOffsets.at( c ));
+    }
+
+    foreach ( const GlyphBitmap &image, images ) {
+        QByteArray strips = image.toByteColumns();
+        out.writeRawData( strips.constData(), strips.size() );
+    }
+    writeString( out, face, face.size() + 1 );
+    return data;
+}
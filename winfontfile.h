@@ -0,0 +1,63 @@
+/******************************************************************************
+** winfontfile.h
+**
+** Reading and writing Windows 2.x/3.x bitmap font (.FNT) files.
+**
+**  Copyright (C) 2023 Alexander Taylor
+**
+**  This program is free software; you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published by
+**  the Free Software Foundation; either version 2.1 of the License, or (at
+**  your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful, but
+**  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+**  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this library; if not, write to the Free Software Foundation,
+**  Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+******************************************************************************/
+
+#ifndef WINFONTFILE_H
+#define WINFONTFILE_H
+
+#include <QByteArray>
+#include <QVector>
+
+#include "fontfile.h"
+
+class FontDocument;
+
+
+/* A Windows font file (or FONT resource) is a FONTINFO header followed by
+ * a character table of widths and offsets, then the glyph images and the
+ * face name.  Version 2 files use 16-bit glyph offsets and so are limited
+ * to 64K; version 3 files use 32-bit offsets.  Only raster fonts are
+ * supported, and at most 256 glyphs can be stored.
+ */
+class WinFontFile : public FontFileReader
+{
+public:
+    WinFontFile( const uchar *data, qint64 size );
+
+    bool        parse();
+    int         glyphWidth( int index ) const;
+    GlyphBitmap glyph( int index ) const;
+
+    static bool       recognize( const uchar *data, qint64 size );
+    static int        maxGlyphs( const FontDocument *document );
+    static QByteArray write( const FontDocument *document );
+
+private:
+    struct CharDef {
+        quint32 offset;         // of the glyph image, from the start of the font
+        quint16 width;
+    };
+
+    QVector<CharDef> chars;
+};
+
+#endif  // WINFONTFILE_H